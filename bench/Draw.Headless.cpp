@@ -0,0 +1,7 @@
+module Game.Graphic.Draw.Universal;
+
+//the headless targets link the world without any renderer, entities are simply not drawn
+
+void Game::Graphic::Draw::hitbox(const Hitbox& hitbox, const float z){}
+
+void Game::Graphic::Draw::realEntity(const RealEntity& entity, const float interpolation){}
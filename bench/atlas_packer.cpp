@@ -0,0 +1,14 @@
+import std;
+
+import Bench.AtlasPacker;
+
+/**
+ * @brief fill rate and churn cost of the page packers on glyph sized regions
+ *
+ * atlas_packer_bench
+ */
+int main(){
+	Bench::runAtlasPackerBenchmark();
+
+	return 0;
+}
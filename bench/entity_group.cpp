@@ -0,0 +1,14 @@
+import std;
+
+import Bench.EntityGroup;
+
+/**
+ * @brief pend cost from 1 up to every hardware thread, and the dump that merges the pendings afterwards
+ *
+ * entity_group_bench
+ */
+int main(){
+	Bench::runEntitySpawnBenchmark();
+
+	return 0;
+}
@@ -0,0 +1,14 @@
+import std;
+
+import Bench.Pixmap;
+
+/**
+ * @brief throughput of the pixmap kernels per instruction set
+ *
+ * pixmap_bench
+ */
+int main(){
+	Bench::runPixmapBenchmark();
+
+	return 0;
+}
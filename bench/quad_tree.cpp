@@ -0,0 +1,14 @@
+import std;
+
+import Bench.QuadTree;
+
+/**
+ * @brief per tick update cost of the pointer quad tree against the flat one, rebuilt and synchronized
+ *
+ * quad_tree_bench
+ */
+int main(){
+	Bench::runQuadTreeBenchmark();
+
+	return 0;
+}
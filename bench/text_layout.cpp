@@ -0,0 +1,37 @@
+#include <vulkan/vulkan.h>
+
+import std;
+
+import Core.InitAndTerminate;
+import Core.Global;
+import Core.Vulkan.Manager;
+import Assets.Graphic;
+import MainTest;
+import Bench.TextLayout;
+
+/**
+ * @brief full against incremental layout of an edited text, the fonts are loaded the same way the game does
+ *
+ * text_layout_bench
+ */
+int main(){
+	using namespace Core;
+
+	Global::init_context();
+
+	Test::compileAllShaders();
+
+	Assets::load(Global::vulkanManager->context);
+
+	Global::init_assetsAndRenderers();
+
+	Bench::runTextLayoutBenchmark();
+
+	vkDeviceWaitIdle(Global::vulkanManager->context.device);
+
+	Assets::dispose();
+
+	Global::terminate();
+
+	return 0;
+}
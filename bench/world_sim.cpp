@@ -0,0 +1,107 @@
+import std;
+
+import Core.Global;
+import Core.JobSystem;
+import Game.World.Simulation;
+import Bench.WorldSim;
+
+/**
+ * @brief headless world simulation benchmark, prints per stage percentiles as JSON
+ *
+ * world_sim_bench [--scenario uniform|clustered|projectiles] [--count N] [--ticks N] [--warmup N] [--seed N]
+ *                 [--threads N] [--broad-phase quad_tree|sweep_and_prune] [--serial-manifold] [--out file]
+ */
+int main(const int argc, char* argv[]){
+	std::vector<Bench::WorldSimScenario> scenarios{std::from_range, Bench::AllWorldSimScenarios};
+	Bench::WorldSimBenchConfig config{};
+	std::optional<unsigned> threads{};
+	std::string_view out{};
+
+	const std::span args{argv + 1, argv + argc};
+
+	for(auto arg = args.begin(); arg != args.end(); ++arg){
+		const std::string_view name = *arg;
+
+		const auto value = [&]() -> std::string_view{
+			if(std::next(arg) == args.end()){
+				std::println(std::cerr, "missing value of {}", name);
+				std::exit(2);
+			}
+
+			return *++arg;
+		};
+
+		const auto number = [&]<typename T>(T& dst){
+			const std::string_view str = value();
+			if(const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), dst); ec != std::errc{}){
+				std::println(std::cerr, "invalid value of {}: {}", name, str);
+				std::exit(2);
+			}
+		};
+
+		if(name == "--scenario"){
+			const std::string_view str = value();
+			if(const auto scenario = Bench::scenarioOf(str)){
+				scenarios = {*scenario};
+			}else{
+				std::println(std::cerr, "unknown scenario: {}", str);
+				return 2;
+			}
+		}else if(name == "--count"){
+			number(config.count);
+		}else if(name == "--ticks"){
+			number(config.ticks);
+		}else if(name == "--warmup"){
+			number(config.warmupTicks);
+		}else if(name == "--seed"){
+			number(config.seed);
+		}else if(name == "--threads"){
+			number(threads.emplace());
+		}else if(name == "--broad-phase"){
+			const std::string_view str = value();
+			if(str == "quad_tree"){
+				config.broadPhase = Game::BroadPhase::quadTree;
+			}else if(str == "sweep_and_prune"){
+				config.broadPhase = Game::BroadPhase::sweepAndPrune;
+			}else{
+				std::println(std::cerr, "unknown broad phase: {}", str);
+				return 2;
+			}
+		}else if(name == "--serial-manifold"){
+			config.parallelManifold = false;
+		}else if(name == "--out"){
+			out = value();
+		}else{
+			std::println(std::cerr, "unknown argument: {}", name);
+			return 2;
+		}
+	}
+
+	//the calling thread takes part in every fork/join
+	Core::JobSystem jobSystem{threads ? std::max(*threads, 1u) - 1 : std::max(std::thread::hardware_concurrency(), 2u) - 1};
+	Core::Global::jobSystem = &jobSystem;
+
+	std::vector<Bench::WorldSimBenchResult> results{};
+	for(const Bench::WorldSimScenario scenario : scenarios){
+		config.scenario = scenario;
+		results.push_back(Bench::benchmarkWorldSim(config));
+	}
+
+	Core::Global::jobSystem = nullptr;
+
+	const std::string json = Bench::toJson(results);
+
+	if(out.empty()){
+		std::print("{}", json);
+	}else{
+		std::ofstream file{std::filesystem::path{out}};
+		file << json;
+
+		if(!file){
+			std::println(std::cerr, "failed to write {}", out);
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -1,5 +1,6 @@
  #include <GLFW/glfw3.h>
 #include <vulkan/vulkan.h>
+#include "src/arc/core/profiler.hpp"
 
 // #include "src/application_head.h"
 
@@ -26,6 +27,7 @@ import Geom.Matrix4D;
 import Geom.GridGenerator;
 import Geom.Rect_Orthogonal;
 import Geom.quad_tree;
+import Geom.quad_tree.flat;
 import Geom;
 
 import Core.Vulkan.Shader.Compile;
@@ -73,6 +75,9 @@ import Font.TypeSettings.Renderer;
 import Math.Rand;
 
 import Core.Global;
+import Core.Global.Assets;
+import Core.JobSystem;
+import Core.Profiler;
 
 import Game.Entity.HitBox;
 
@@ -114,6 +119,10 @@ int main_(){
 int main(){
 	using namespace Core;
 
+#if PROFILER_ENABLED
+	Profiler::setThreadName("main");
+#endif
+
 	Global::init_context();
 
 	Test::compileAllShaders();
@@ -182,28 +191,48 @@ int main(){
 
 	timer.resetTime();
 
-	std::future<void> upt{};
-
 	while(!window->shouldClose()){
+		PROFILE_ZONE("frame");
 		// std::this_thread::sleep_for(std::chrono::milliseconds(30));
-		timer.fetchTime();
-		window->pollEvents();
-		input->update(timer.globalDeltaTick());
-		mainCamera->update(timer.globalDeltaTick());
+		{
+			PROFILE_ZONE("input");
+			timer.fetchTime();
+			window->pollEvents();
+			input->update(timer.globalDeltaTick());
+			mainCamera->update(timer.globalDeltaTick());
+		}
+
 		Global::mainEffectManager.dumpBuffer_unchecked();
-		Global::mainEffectManager.update(timer.updateDeltaTick());
+
+		//effects only read their own state, new ones go to the locked buffer until the next dump
+		const Core::JobHandle effectUpdate = jobSystem->submit([]{
+			Global::mainEffectManager.update(timer.updateDeltaTick());
+		});
 
 		Test::update(timer.updateDeltaTick());
 
 		if(true){
-			if(upt.valid())upt.get();
+			PROFILE_ZONE("world.frameUpdate");
 			Test::GamePart::update(timer.updateDeltaTick());
 		}
 
+		{
+			PROFILE_ZONE("effects.wait");
+			jobSystem->wait(effectUpdate);
+		}
+
+		{
+			PROFILE_ZONE("ui");
+			Global::UI::root->layout();
+			Global::UI::root->update(timer.globalDeltaTick());
+			Global::UI::renderer->resetScissors();
+		}
 
-		Global::UI::root->layout();
-		Global::UI::root->update(timer.globalDeltaTick());
-		Global::UI::renderer->resetScissors();
+		{
+			PROFILE_ZONE("atlas.upload");
+			Font::GlobalFontManager->flushUploads();
+			Asset::atlas->flushUploads();
+		}
 
 		if(mainCamera->checkChanged()){
 			rendererWorld->updateProjection(Vulkan::UniformProjectionBlock{mainCamera->getWorldToScreen(), 0.f});
@@ -237,7 +266,7 @@ int main(){
 		// }
 
 		// Font::TypeSettings::globalInstantParser.requestParseInstantly(fps, std::format("#<font|tele>{:5}|", quad_tree.size()));
-		Font::TypeSettings::globalInstantParser.requestParseInstantly(count, std::format("#<font|tele>{}", Test::GamePart::world.realEntities.entities.size()));
+		Font::TypeSettings::globalInstantParser.requestParseInstantly(count, std::format("#<font|tele>{}", Test::GamePart::world.realEntities.size()));
 
 		sec += timer.getGlobalDelta();
 		if(sec > 1.f){
@@ -250,12 +279,17 @@ int main(){
 		// Font::TypeSettings::draw(UI::renderer->batch, fps, {300, 300});
 
 		if constexpr(true){
+			PROFILE_ZONE("world.draw");
 			Global::mainEffectManager.render(mainCamera->getViewport());
 
 			Test::GamePart::draw();
 
 			using Drawer = Graphic::Draw::Drawer<Graphic::Vertex_World>;
+			using InstanceDrawer = Graphic::Draw::Drawer<Graphic::Instance_World>;
 			Graphic::InstantBatchAutoParam<Graphic::Vertex_World, Graphic::Draw::DepthModifier> autoParam{rendererWorld->batch};
+			Graphic::InstantBatchAutoParam<Graphic::Instance_World, Graphic::Draw::DepthModifier> instanceParam{
+				rendererWorld->instanceBatch, Graphic::Draw::WhiteRegion
+			};
 
 			Geom::Vec2 size{800, 800};
 
@@ -310,12 +344,12 @@ int main(){
 			// Drawer::Line::line(++autoParam, 3.f, p2, p2 + normal, lightColor, lightColor);
 			// Drawer::Line::line(++autoParam, 2.f, p1, p1 + Geom::Vec::normalTo(p1 - p2, normal), lightColor, lightColor);
 
-			Test::GamePart::world.quadTree.each([&](const Geom::quad_tree<Game::RealEntity>& node){
+			Test::GamePart::world.quadTree.each([&](const Geom::quad_tree_flat<Game::RealEntity>::node_view node){
 				if(mainCamera->getViewport().overlap_Exclusive(node.get_boundary())){
 					auto color = Graphic::Colors::ROYAL;
 
-					autoParam.modifier.depth = 0.35f;
-					Drawer::Line::rectOrtho(autoParam, 4.f, node.get_boundary().shrink(8), color);
+					instanceParam.modifier.depth = 0.35f;
+					InstanceDrawer::Line::rectOrtho(instanceParam, 4.f, node.get_boundary().shrink(8), color);
 				}
 
 				for(Game::RealEntity* item : node.get_items()){
@@ -342,11 +376,9 @@ int main(){
 			});
 		}
 
-		upt = std::async([]{
-			Test::GamePart::postUpdate(timer.updateDeltaTick());
-		});
+		Test::GamePart::launchPostUpdate();
 
-		Global::rendererWorld->batch.consumeAll();
+		Global::rendererWorld->consumeAll();
 		Global::rendererWorld->doPostProcess();
 
 		// Global::UI::root->draw();
@@ -391,9 +423,13 @@ int main(){
 		vulkanManager->mergePresent();
 		Global::UI::renderer->clearMerged();
 
-		vulkanManager->blitToScreen();
+		{
+			PROFILE_ZONE("present");
+			vulkanManager->blitToScreen();
+		}
 	}
 
+	Test::GamePart::waitPostUpdate();
 	Test::GamePart::printTestPerformance();
 
 	vkDeviceWaitIdle(vulkanManager->context.device);
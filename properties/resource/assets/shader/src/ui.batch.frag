@@ -2,6 +2,13 @@
 #pragma shader_stage(fragment)
 #extension GL_ARB_separate_shader_objects : enable
 
+#ifdef BindlessTextures
+#extension GL_EXT_nonuniform_qualifier : require
+#define TextureSlot(index) nonuniformEXT(index)
+#else
+#define TextureSlot(index) (index)
+#endif
+
 #include "lib/rect"
 
 #ifndef MaximumAllowedSamplersSize
@@ -11,7 +18,7 @@
 
 layout(location = 0) in vec2 fragTexCoord;
 
-//[ID, Layer, reserved, reserved]
+//[ID, Layer, Mode, reserved]
 layout(location = 1) flat in uvec4 textureID;
 
 layout(location = 2) in vec4 baseColor;
@@ -27,6 +34,8 @@ layout(location = 0) out vec4 outBase;
 layout(location = 1) out vec4 outColor;
 layout(location = 2) out vec4 outLight;
 
+const uint DistanceFieldMode = 1;
+
 
 layout(set = 1, binding = 0) uniform Scissor{
 //    layout(offset = 64)
@@ -38,7 +47,13 @@ void main() {
         discard;
     }
 
-    vec4 texColor = texture(texSampler1[textureID[0]], vec3(fragTexCoord.xy, textureID[1]));
+    vec4 texColor = texture(texSampler1[TextureSlot(textureID[0])], vec3(fragTexCoord.xy, textureID[1]));
+
+    if(textureID[2] == DistanceFieldMode){
+        //the outline lies at 0.5, keep the edge about one screen pixel wide at any scale
+        float edge = max(fwidth(texColor.a) * 0.5f, 1e-4f);
+        texColor.a = smoothstep(0.5f - edge, 0.5f + edge, texColor.a);
+    }
 
     outBase = texColor * baseColor;
     outColor = vec4(1.f);
@@ -2,6 +2,13 @@
 #pragma shader_stage(fragment)
 #extension GL_ARB_separate_shader_objects : enable
 
+#ifdef BindlessTextures
+#extension GL_EXT_nonuniform_qualifier : require
+#define TextureSlot(index) nonuniformEXT(index)
+#else
+#define TextureSlot(index) (index)
+#endif
+
 #ifndef MaximumAllowedSamplersSize
 #define MaximumAllowedSamplersSize 1
 #endif
@@ -27,7 +34,7 @@ layout (depth_unchanged) out float gl_FragDepth;
 const float Threshold = 0.875f;
 
 void main() {
-    vec4 texColor = texture(texSampler[textureID[0]], vec3(fragTexCoord.xy, textureID[1]));
+    vec4 texColor = texture(texSampler[TextureSlot(textureID[0])], vec3(fragTexCoord.xy, textureID[1]));
 
     if(texColor.a * baseColor.a > Threshold || texColor.a * lightColor.a > Threshold){
         gl_FragDepth = gl_FragCoord.z;
@@ -0,0 +1,60 @@
+#version 450
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+
+//per instance, the quad corner comes from the index buffer
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inSize;
+layout(location = 2) in vec2 inAxis;
+layout(location = 3) in uvec4 inTextureID;
+
+//[u00, v00, u11, v11]
+layout(location = 4) in vec4 inTexRect;
+
+//low byte base channel, high byte light channel
+layout(location = 5) in uvec4 inColor;
+layout(location = 6) in float inDepth;
+
+layout(location = 0) out vec2 fragTexCoord;
+layout(location = 1) flat out uvec4 textureID;
+
+layout(location = 2) out vec4 baseColor;
+layout(location = 3) out vec4 mixColor;
+layout(location = 4) out vec4 lightColor;
+
+const float zScale = 512.f;
+
+//the same corner order as the quad indices
+const vec2 Corners[4] = vec2[](
+    vec2(0.f, 0.f),
+    vec2(1.f, 0.f),
+    vec2(1.f, 1.f),
+    vec2(0.f, 1.f)
+);
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+layout(set = 0, binding = 0) uniform UBO {
+    mat3 view;
+    float v;
+} ubo;
+
+void main() {
+    vec2 corner = Corners[gl_VertexIndex & 3];
+    vec2 local = (corner - .5f) * inSize;
+    vec2 position = inPosition + vec2(
+        inAxis.x * local.x - inAxis.y * local.y,
+        inAxis.y * local.x + inAxis.x * local.y
+    );
+
+    gl_Position = vec4((ubo.view * vec3(position, 1.0)).xy, inDepth / zScale, 1.0);
+    baseColor = vec4(inColor & 0xffu) / 255.f;
+    lightColor = vec4(inColor >> 8u) / 255.f;
+
+    //the vertex path maps the corners to the v01, v11, v10, v00 uv
+    fragTexCoord = mix(inTexRect.xy, inTexRect.zw, vec2(corner.x, 1.f - corner.y));
+
+    textureID = inTextureID;
+}
@@ -2,11 +2,21 @@
 #pragma shader_stage(vertex)
 #extension GL_ARB_separate_shader_objects : enable
 
+#ifdef CompactVertices
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in uvec4 inTextureID;
+layout(location = 2) in vec2 inTexCoord;
+
+//low byte base channel, high byte light channel
+layout(location = 3) in uvec4 inColor;
+layout(location = 4) in float inDepth;
+#else
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in uvec4 inTextureID;
 layout(location = 2) in vec2 inTexCoord;
 
 layout(location = 3) in vec4 inColor;
+#endif
 
 //layout(location = 3) in int textureID;
 
@@ -31,9 +41,15 @@ layout(set = 0, binding = 0) uniform UBO {
 } ubo;
 
 void main() {
+#ifdef CompactVertices
+    gl_Position = vec4((ubo.view * vec3(inPosition.xy, 1.0)).xy, inDepth / zScale, 1.0);
+    baseColor = vec4(inColor & 0xffu) / 255.f;
+    lightColor = vec4(inColor >> 8u) / 255.f;
+#else
     gl_Position = vec4((ubo.view * vec3(inPosition.xy, 1.0)).xy, inPosition.z / zScale, 1.0);
     baseColor = mod(inColor, 10.f);
     lightColor = inColor / LightColorRange;
+#endif
 
     fragTexCoord = inTexCoord;
 
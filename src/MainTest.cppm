@@ -1,3 +1,7 @@
+module;
+
+#include "../src/arc/core/profiler.hpp"
+
 export module MainTest;
 
 import Core.Vulkan.Shader.Compile;
@@ -6,6 +10,7 @@ import Core.File;
 import Assets.Directories;
 
 import Graphic.Batch.MultiThread;
+import Graphic.Vertex;
 
 import ext.meta_programming;
 
@@ -52,11 +57,12 @@ import Core.Vulkan.Texture;
 import Game.Delay;
 
 export import Assets.Fx;
-export import Game.World.State;
-export import Game.World.RealEntity;
+export import Game.World.Simulation;
 
 import ext.timer;
-import ext.shared_stack;
+import Core.JobSystem;
+import Core.ApplicationTimer;
+import Core.Profiler;
 
 export namespace Test{
 	static_assert(Core::UI::ElemInitFunc<decltype([](int, Core::UI::BedFace&){})>);
@@ -249,7 +255,13 @@ export namespace Test{
 	void compileAllShaders(){
 		Core::Vulkan::ShaderRuntimeCompiler compiler{};
 		compiler.addMarco("MaximumAllowedSamplersSize",
-		                  std::format("{}", Graphic::Batch_MultiThread::MaximumAllowedSamplersSize));
+		                  std::format("{}", Graphic::Batch_MultiThread::TextureSlotCount));
+		if constexpr (Graphic::BindlessTextures){
+			compiler.addMarco("BindlessTextures", "1");
+		}
+		if constexpr (Graphic::CompactVertices){
+			compiler.addMarco("CompactVertices", "1");
+		}
 		const Core::Vulkan::ShaderCompilerWriter adaptor{compiler, Assets::Dir::shader_spv};
 
 		Core::File{Assets::Dir::shader_src}.forSubs([&](Core::File&& file){
@@ -260,10 +272,29 @@ export namespace Test{
 }
 
 export namespace Test::GamePart{
-	Game::WorldState world{};
+	using Game::BroadPhase;
+
+	Game::WorldSimulation simulation{};
+	Game::WorldState& world = simulation.world;
+
+	/** @brief applied in @link update @endlink, postUpdate may still be running when input arrives */
+	BroadPhase requestedBroadPhase{BroadPhase::quadTree};
+	bool requestedParallelManifold{true};
+
+	/**
+	 * @brief simulate in fixed 60Hz steps and interpolate the rendered transforms,
+	 * otherwise one step of the frame delta is simulated per frame
+	 */
+	bool fixedTimestep{true};
+	bool requestedFixedTimestep{true};
+	Core::FixedTimestep<float> stepper{};
+	/** @brief delta of the step whose collisions are resolved by the pending post update */
+	float lastStepDelta{};
+	float interpolation{1.f};
+
+	Core::JobHandle pendingPostUpdate{};
+
 	ext::timer<> timer{};
-	ext::shared_stack<Game::RealEntity*> pre_collide_passed{};
-	ext::shared_stack<Game::RealEntity*> post_collide_passed{};
 
 	std::size_t testCount{};
 	std::chrono::microseconds quadTreeTestTime{};
@@ -271,11 +302,10 @@ export namespace Test::GamePart{
 
 	void init(){
 		constexpr float size = 400000.f;
-		world.quadTree = Geom::quad_tree<Game::RealEntity>{{
+		world.quadTree = Geom::quad_tree_flat<Game::RealEntity>{{
 			{-size, -size}, {size, size}
 		}};
-		world.all.dumpAll();
-		world.realEntities.dumpAll();
+		world.dumpAll();
 		world.updateQuadTree();
 
 		Core::Global::input->binds.registerBind(Core::Ctrl::InputBind{
@@ -287,7 +317,7 @@ export namespace Test::GamePart{
 						const auto ang = dst.angle();
 
 						for(int i = 0; i <= 0; ++i){
-							auto& ent = world.add([&](Game::RealEntity& entity){
+							world.add([&](Game::RealEntity& entity){
 								entity.rigidProp.inertialMass /= 5.f;
 								entity.motion.trans = {cameraPos + dst.copy().rotateRT().normalize() * i * 100, ang};
 								entity.motion.vel = {Geom::dirNor(ang) * 500};
@@ -310,102 +340,124 @@ export namespace Test::GamePart{
 				}
 			});
 
-	}
+		Core::Global::input->binds.registerBind(Core::Ctrl::InputBind{
+				Core::Ctrl::Key::B, Core::Ctrl::Act::Press, []{
+					requestedBroadPhase = requestedBroadPhase == BroadPhase::quadTree ? BroadPhase::sweepAndPrune : BroadPhase::quadTree;
+				}
+			});
 
-	void postUpdate(float delta){
-		std::atomic_size_t potentialCount{};
+		Core::Global::input->binds.registerBind(Core::Ctrl::InputBind{
+				Core::Ctrl::Key::M, Core::Ctrl::Act::Press, []{
+					requestedParallelManifold = !requestedParallelManifold;
+				}
+			});
 
-		auto cur0 = std::chrono::system_clock::now();
+		Core::Global::input->binds.registerBind(Core::Ctrl::InputBind{
+				Core::Ctrl::Key::T, Core::Ctrl::Act::Press, []{
+					requestedFixedTimestep = !requestedFixedTimestep;
+				}
+			});
 
-		world.realEntities.each_par([&potentialCount](Game::RealEntity& entity){
-			world.quadTree.intersect_test_all(
-				entity,
-				[&potentialCount](Game::RealEntity& sbj, const Game::RealEntity& obj){
-					if(sbj.testIntersectionWith(obj)){
-						potentialCount.fetch_add(1, std::memory_order::relaxed);
+#if PROFILER_ENABLED
+		//the last few seconds of every thread, load it in chrome://tracing or Perfetto
+		Core::Global::input->binds.registerBind(Core::Ctrl::InputBind{
+				Core::Ctrl::Key::F9, Core::Ctrl::Act::Press, []{
+					if(Core::Profiler::exportChromeTrace("frame_trace.json")){
+						std::println("frame trace exported");
+					}else{
+						std::println(std::cerr, "failed to export the frame trace");
 					}
-				},
-
-				[](const Game::RealEntity& sbj, const Game::RealEntity& obj){
-					if(&sbj == &obj) return false;
-					if(!sbj.getBound().overlap_Exclusive(obj.getBound())) return false;
-
-					return sbj.roughIntersectWith(obj);
-				});
-		});
-
-		auto cur1 = std::chrono::system_clock::now();
-
-		post_collide_passed.clear_and_reserve(potentialCount.load() + 8);
-		// post_collide_passed.clear_and_reserve(world.realEntities.size() + 8);
-
-		world.realEntities.each([](Game::RealEntity& e){
-			if(e.postProcessCollisions_0()){
-					post_collide_passed.push(&e);
-				}else{
-					e.manifold.clear();
 				}
-		});
+			});
+#endif
+	}
 
-		for (Game::RealEntity* e : post_collide_passed){
-			e->postProcessCollisions_1();
-			e->postProcessCollisions_2();
-		}
+	void postUpdate(const float delta){
+		simulation.resolveCollisions(delta);
 
-		for (Game::RealEntity* e : post_collide_passed){
-			e->postProcessCollisions_3(delta);
-		}
-
-		// if(post_collide_passed.size() > 500){
-		// 	std::for_each(std::execution::par, post_collide_passed.begin(), post_collide_passed.end(), [](Game::RealEntity* e){
-		// 		e->postProcessCollisions_1();
-		// 		e->postProcessCollisions_2();
-		// 	});
-		//
-		// 	std::for_each(std::execution::par, post_collide_passed.begin(), post_collide_passed.end(), [delta](Game::RealEntity* e){
-		// 		e->postProcessCollisions_3(delta);
-		// 	});
-		// }else{
-		//
-		// }
-
-		auto cur2 = std::chrono::system_clock::now();
+		const Game::SimulationStageTimes& times = simulation.getLastStageTimes();
 
 		testCount++;
-		quadTreeTestTime += std::chrono::duration_cast<std::chrono::microseconds>(cur1 - cur0);
-		manifoldProcessTime += std::chrono::duration_cast<std::chrono::microseconds>(cur2 - cur1);
-
-		// world.realEntities.each_par ([](Game::RealEntity& e){
-		// 	e.postProcessCollisions_0();
-		// 	e.postProcessCollisions_1();
-		// 	e.postProcessCollisions_2();
-		// });
-		//
-		// world.realEntities.each_par ([delta](Game::RealEntity& e){
-		// 	e.postProcessCollisions_3(delta);
-		// });
+		quadTreeTestTime += std::chrono::duration_cast<std::chrono::microseconds>(times.broadPhase);
+		manifoldProcessTime += std::chrono::duration_cast<std::chrono::microseconds>(times.manifold());
 	}
 
 	void printTestPerformance(){
 		std::println("entities: {}", world.realEntities.size());
 		std::println("tested frames: {}", testCount);
+		std::println("broad phase: {}", simulation.getBroadPhase() == BroadPhase::quadTree ? "quad tree" : "sweep and prune");
+		std::println("manifold resolve: {}", simulation.parallelManifold ? "parallel islands" : "serial");
+		std::println("timestep: {}, dropped steps: {}", fixedTimestep ? "fixed" : "variable", stepper.getDroppedSteps());
 		std::println("avg quadtree time: {}", std::chrono::duration_cast<std::chrono::microseconds>(quadTreeTestTime / testCount));
 		std::println("avg manifold time: {}", std::chrono::duration_cast<std::chrono::microseconds>(manifoldProcessTime / testCount));
 		std::println("avg total test time: {}", std::chrono::duration_cast<std::chrono::microseconds>((quadTreeTestTime + manifoldProcessTime) / testCount));
 	}
 
+	void waitPostUpdate(){
+		Core::Global::jobSystem->wait(pendingPostUpdate);
+		pendingPostUpdate = {};
+	}
+
+	/**
+	 * @brief resolve the collisions of the last step of this frame concurrently with rendering, a no-op if no step was simulated
+	 */
+	void launchPostUpdate(){
+		if(lastStepDelta == .0f) return;
+
+		pendingPostUpdate = Core::Global::jobSystem->submit([]{
+			postUpdate(lastStepDelta);
+		});
+	}
+
+	/**
+	 * @param delta frame delta in ticks
+	 */
 	void update(const float delta){
-		world.all.dumpAll();
-		world.realEntities.dumpAll();
+		waitPostUpdate();
 
-		if(delta == .0f)return;
+		if(simulation.getBroadPhase() != requestedBroadPhase){
+			simulation.setBroadPhase(requestedBroadPhase);
+			testCount = 0;
+			quadTreeTestTime = manifoldProcessTime = {};
+		}
 
-		world.all.update_par(delta);
+		if(simulation.parallelManifold != requestedParallelManifold){
+			simulation.parallelManifold = requestedParallelManifold;
+			testCount = 0;
+			quadTreeTestTime = manifoldProcessTime = {};
+		}
 
-		world.updateQuadTree();
+		if(fixedTimestep != requestedFixedTimestep){
+			fixedTimestep = requestedFixedTimestep;
+			stepper.reset();
+		}
+
+		unsigned steps;
+		float stepDelta;
+
+		if(fixedTimestep){
+			steps = stepper.advance(delta);
+			stepDelta = stepper.getStep();
+			interpolation = stepper.getInterpolation();
+		}else{
+			steps = delta != .0f;
+			stepDelta = delta;
+			interpolation = 1.f;
+		}
+
+		lastStepDelta = steps ? stepDelta : .0f;
+
+		for(unsigned i = 0; i < steps; ++i){
+			//catch-up steps resolve their collisions right away, the last one overlaps with rendering
+			if(i != 0){
+				postUpdate(stepDelta);
+			}
+
+			simulation.step(stepDelta);
+		}
 	}
 
 	void draw(){
-		world.draw(Core::Global::mainCamera->getViewport());
+		world.draw(Core::Global::mainCamera->getViewport(), interpolation);
 	}
 }
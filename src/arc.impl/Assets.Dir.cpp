@@ -20,6 +20,9 @@ void Assets::loadDir(){
     texture = assets.subFile("texture");
     patch(texture);
 
+    atlas = assets.subFile("atlas");
+    patch(atlas);
+
     font = assets.subFile("fonts");
     patch(font);
 
@@ -39,6 +42,9 @@ void Assets::loadDir(){
     texCache = cache.subFile("tex");
     patch(texCache);
 
+    fontCache = cache.subFile("font");
+    patch(fontCache);
+
     game = assets.subFile("game");
     patch(game);
 
@@ -38,6 +38,10 @@ void Assets::Shader::load(const VkDevice device){
         device, dir / R"(world.vert.spv)"
     };
 
+    Vert::worldInstance = Core::Vulkan::ShaderModule{
+        device, dir / R"(world.instance.vert.spv)"
+    };
+
     Frag::worldBatch = Core::Vulkan::ShaderModule{
         device, dir / R"(world.frag.spv)"
     };
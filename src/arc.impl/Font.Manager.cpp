@@ -1,36 +1,171 @@
 module Font.Manager;
 
 import Graphic.ImageAtlas;
+import Graphic.BlockCompression;
+import Graphic.Pixmap;
+import Font.GlyphCache;
+
+namespace Font{
+	[[nodiscard]] constexpr float spreadOf(const GlyphRenderMode mode) noexcept{
+		return mode == GlyphRenderMode::distanceField ? static_cast<float>(DistanceFieldSpread) : 0.f;
+	}
+}
+
+Font::Glyph* Font::IndexedFontFace::findGlyph(const GlyphKey key){
+	std::shared_lock lk{glyphMutex};
+	if(const auto itr = validGlyphs.find(atlasKeyOf(key)); itr != validGlyphs.end()){
+		return &itr->second;
+	}
+
+	return nullptr;
+}
 
 Font::Glyph& Font::IndexedFontFace::
-obtainGlyph(const GlyphKey key, const Graphic::ImageAtlas* atlas, Graphic::ImagePage* page){
-	if(const auto itr = validGlyphs.find(key); itr != validGlyphs.end()){
-		return itr->second;
+obtainGlyph(GlyphKey key, Graphic::ImageAtlas* atlas, Graphic::ImagePage* page){
+	key = atlasKeyOf(key);
+
+	if(const auto glyph = findGlyph(key)){
+		return *glyph;
 	}
 
 	if(!atlas || !page){
 		throw std::invalid_argument("Atlas or page is null");
 	}
 
-	const auto generated = tryLoad(key.code, key.size);
+	const auto& generated = tryLoad(key.code, key.size);
+
+	std::unique_lock lk{glyphMutex};
 
-	Graphic::ImageViewRegion view{};
+	//another thread may have got it first
+	const auto [itr, inserted] = validGlyphs.try_emplace(key, Graphic::ImageViewRegion{}, generated.metrics, spreadOf(renderMode));
+	if(!inserted) return itr->second;
+
+	//nodes are stable, the allocation may compact the page which refreshes the glyphs of this face
+	Glyph& glyph = itr->second;
+	lk.unlock();
 
 	if(generated.bitmap.valid()){
 		auto allocated = atlas->allocate(*page, generated.bitmap);
-		view = allocated.asView();
+		static_cast<Graphic::ImageViewRegion&>(glyph) = allocated.asView();
 		page->registerNamedRegion(toString_short(key.code, key.size), std::move(allocated));
 	}
 
-	auto& rst = validGlyphs.insert_or_assign(key, Glyph{view, generated.metrics}).first->second;
+	return glyph;
+}
+
+Font::Glyph& Font::IndexedFontFace::requestGlyph(GlyphKey key, FontManager& manager){
+	key = atlasKeyOf(key);
+
+	if(const auto glyph = findGlyph(key)){
+		return *glyph;
+	}
+
+	//the outline load is cheap compared with the rendering, the layout needs the exact metrics anyway
+	const auto metrics = loadMetrics(key.code, key.size);
+
+	std::unique_lock lk{glyphMutex};
+
+	const auto [itr, inserted] = validGlyphs.try_emplace(key, Graphic::ImageViewRegion{}, metrics, spreadOf(renderMode));
+	if(inserted && !emptyFontGlyphGenerators.contains(key.code)){
+		manager.queueRasterization(*this, key, itr->second);
+	}
 
-	return rst;
+	return itr->second;
 }
 
+std::pair<Font::Glyph*, const Font::BitmapGlyph*> Font::IndexedFontFace::restoreGlyph(const GlyphKey key, BitmapGlyph&& bitmap){
+	const BitmapGlyph& stored = store(key.size, std::move(bitmap));
 
-Font::FontManager::FontManager(Graphic::ImageAtlas& atlas, const std::string_view fontPageName):
+	std::unique_lock lk{glyphMutex};
+
+	const auto [itr, inserted] = validGlyphs.try_emplace(key, Graphic::ImageViewRegion{}, stored.metrics, spreadOf(renderMode));
+	return {inserted ? &itr->second : nullptr, &stored};
+}
+
+
+void Font::IndexedFontFace::refreshGlyphViews(Graphic::ImagePage& page){
+	std::unique_lock lk{glyphMutex};
+
+	for(auto& [key, glyph] : validGlyphs){
+		if(const auto region = page.find(toString_short(key.code, key.size))){
+			static_cast<Graphic::ImageViewRegion&>(glyph) = region->asView();
+		}
+	}
+}
+
+Font::FontManager::FontManager(Graphic::ImageAtlas& atlas, const std::string_view fontPageName, Core::JobSystem* jobSystem):
 	atlas{&atlas},
-	fontPage{&atlas.registerPage(fontPageName)}, fontPageName{fontPageName}{}
+	fontPage{&atlas.registerPage(fontPageName, Graphic::DefTexturePageSize, Graphic::PagePacker::shelf, Graphic::BlockFormat::bc4)}, fontPageName{fontPageName}, jobSystem{jobSystem}{
+
+	//glyphs hold copies of their views, a compaction of the page moves them
+	fontPage->relocateCallback = [this](const Graphic::SubpageData&, std::span<const Graphic::SubpageData::Relocation>){
+		for(IndexedFontFace* face : fontFaces_fastAccess){
+			if(face) face->refreshGlyphViews(*fontPage);
+		}
+	};
+}
+
+Font::FontManager::~FontManager(){
+	if(fontPage) fontPage->relocateCallback = nullptr;
+
+	std::vector<Core::JobHandle> inFlight{};
+
+	{
+		std::scoped_lock lk{pendingMutex};
+		inFlight.swap(rasterizations);
+	}
+
+	for(const auto& handle : inFlight){
+		jobSystem->wait(handle);
+	}
+}
+
+void Font::FontManager::queueRasterization(IndexedFontFace& face, const GlyphKey key, Glyph& glyph){
+	auto rasterize = [this, &face, key, &glyph]{
+		try{
+			const BitmapGlyph& bitmap = face.rasterize(key);
+			if(!bitmap.bitmap.valid()) return;
+
+			std::scoped_lock lk{pendingMutex};
+			pendingUploads.push_back(PendingGlyph{&face, key, &glyph, &bitmap});
+		}catch(const std::exception& e){
+			std::println(std::cerr, "[Font] Failed To Rasterize Glyph {}: {}", face.toString_short(key.code, key.size), e.what());
+		}
+	};
+
+	if(!jobSystem){
+		rasterize();
+		return;
+	}
+
+	auto handle = jobSystem->submit(std::move(rasterize));
+
+	std::scoped_lock lk{pendingMutex};
+	std::erase_if(rasterizations, std::mem_fn(&Core::JobHandle::done));
+	rasterizations.push_back(std::move(handle));
+}
+
+std::size_t Font::FontManager::flushUploads(){
+	std::vector<PendingGlyph> uploads{};
+
+	{
+		std::scoped_lock lk{pendingMutex};
+		uploads.swap(pendingUploads);
+	}
+
+	if(uploads.empty()) return 0;
+
+	auto allocated = atlas->allocate(*fontPage, uploads | std::views::transform([](const PendingGlyph& pending){
+		return &pending.bitmap->bitmap;
+	}) | std::ranges::to<std::vector<const Graphic::Pixmap*>>());
+
+	for(auto&& [pending, region] : std::views::zip(uploads, allocated)){
+		static_cast<Graphic::ImageViewRegion&>(*pending.glyph) = region.asView();
+		fontPage->registerNamedRegion(pending.face->toString_short(pending.key.code, pending.key.size), std::move(region));
+	}
+
+	return uploads.size();
+}
 
 Font::IndexedFontFace* Font::FontManager::getFontFace(const FontFaceID id) const{
 	if(id < fontFaces_fastAccess.size()){
@@ -58,9 +193,9 @@ Font::Glyph& Font::FontManager::getGlyph(const std::string_view fontName, const
 	throw std::invalid_argument("Failed To Find Face with given id.");
 }
 
-Font::FontFaceID Font::FontManager::registerFace(const std::string_view keyName, const std::string_view fontName){
+Font::FontFaceID Font::FontManager::registerFace(const std::string_view keyName, const std::string_view fontName, const GlyphRenderMode mode){
 	const auto index = fontFaces.size();
-	auto [itr, suc] = fontFaces.try_emplace(std::string(keyName), fontName, index);
+	auto [itr, suc] = fontFaces.try_emplace(std::string(keyName), fontName, index, mode);
 
 	if(suc){
 		fontFaces_fastAccess.resize(index + 1);
@@ -68,4 +203,54 @@ Font::FontFaceID Font::FontManager::registerFace(const std::string_view keyName,
 	}
 
 	return itr->second.getIndex();
-}
\ No newline at end of file
+}
+std::size_t Font::FontManager::loadCache(const Core::File& directory){
+	std::vector<PendingGlyph> restored{};
+
+	for(auto& [name, face] : fontFaces){
+		const auto fontHash = GlyphCache::hashFile(Core::File{face.getSourcePath()});
+
+		if(auto entries = GlyphCache::read(directory.subFile(name + std::string{GlyphCache::Extension}), fontHash, face.getFileFaceIndex(), face.getRenderMode())){
+			for(auto& [key, metrics, bitmap] : *entries){
+				BitmapGlyph cached{};
+				cached.code = key.code;
+				cached.metrics = metrics;
+				cached.bitmap = std::move(bitmap);
+
+				if(const auto [glyph, stored] = face.restoreGlyph(key, std::move(cached)); glyph && stored->bitmap.valid()){
+					restored.push_back(PendingGlyph{&face, key, glyph, stored});
+				}
+			}
+		}
+
+		cacheStates.insert_or_assign(name, CacheState{fontHash, face.glyphCount()});
+	}
+
+	{
+		std::scoped_lock lk{pendingMutex};
+		pendingUploads.append_range(restored);
+	}
+
+	return flushUploads();
+}
+
+void Font::FontManager::saveCache(const Core::File& directory){
+	for(auto& [name, face] : fontFaces){
+		auto& state = cacheStates[name];
+		if(state.glyphCount == face.glyphCount()) continue;
+
+		if(!state.fontHash){
+			state.fontHash = GlyphCache::hashFile(Core::File{face.getSourcePath()});
+		}
+
+		std::vector<std::pair<GlyphKey, const BitmapGlyph*>> glyphs{};
+		face.visitGlyphs([&glyphs](const GlyphSizeType size, const BitmapGlyph& glyph){
+			glyphs.emplace_back(GlyphKey{glyph.code, size}, &glyph);
+		});
+
+		Core::File file = directory.subFile(name + std::string{GlyphCache::Extension});
+		GlyphCache::write(file, state.fontHash, face.getFileFaceIndex(), face.getRenderMode(), glyphs);
+
+		state.glyphCount = glyphs.size();
+	}
+}
@@ -1,6 +1,7 @@
 module Core.Global.Assets;
 
 import Core.Vulkan.Manager;
+import Core.Global;
 import Font.Manager;
 import Font.TypeSettings;
 
@@ -11,6 +12,8 @@ import Core.File;
 import Assets.Directories;
 import Graphic.Draw.Func;
 import Graphic.ImageAtlas;
+import Graphic.BlockCompression;
+import Graphic.AtlasBundle;
 
 import std;
 
@@ -23,11 +26,16 @@ void Core::Global::Asset::init(const Vulkan::VulkanManager& manager){
 		auto& mainPage = imageAtlas.registerPage(AtlasPages::Main);
 		auto& uiPage = imageAtlas.registerPage(AtlasPages::UI);
 		auto& tempPage = imageAtlas.registerPage(AtlasPages::Temp);
-		auto& fontPage = imageAtlas.registerPage(AtlasPages::Font);
+		//glyph coverage is a single channel, a BC4 page takes an eighth of the memory of an RGBA8 one
+		auto& fontPage = imageAtlas.registerPage(AtlasPages::Font, Graphic::DefTexturePageSize, Graphic::PagePacker::shelf, Graphic::BlockFormat::bc4);
 
 		auto& page = fontPage.createPage(imageAtlas.context);
 
-		page.texture.cmdClearColor(imageAtlas.obtainTransientCommand(), {1., 1., 1., 0.});
+		//block formats cannot be cleared, every allocation of them is written whole and nothing else is sampled
+		if(!page.texture.isCompressed()){
+			page.texture.cmdClearColor(imageAtlas.obtainTransientCommand(), {1., 1., 1., 0.});
+			imageAtlas.uploadQueue.markReadable(page.texture.getImage().get());
+		}
 
 		auto pixmap = Graphic::Pixmap{::Assets::Dir::texture.find("white.png")};
 		auto region = imageAtlas.allocate(mainPage, pixmap);
@@ -37,23 +45,38 @@ void Core::Global::Asset::init(const Vulkan::VulkanManager& manager){
 		imageAtlas.registerNamedImageViewRegionGuaranteed("ui.base", Graphic::Pixmap{::Assets::Dir::texture.find("ui/elem-s1-back.png")});
 		imageAtlas.registerNamedImageViewRegionGuaranteed("ui.edge", Graphic::Pixmap{::Assets::Dir::texture.find("ui/elem-s1-edge.png")});
 		imageAtlas.registerNamedImageViewRegionGuaranteed("ui.cent", Graphic::Pixmap{::Assets::Dir::texture.find("test-1.png")});
+
+		//baked by the atlas_baker target, one upload per page whatever the sprite count
+		for(const auto& file : ::Assets::Dir::atlas.subs()){
+			if(file.extension() != Graphic::AtlasBundle::Extension) continue;
+
+			if(!imageAtlas.loadBundle(file)){
+				std::println(std::cerr, "Unusable Atlas Bundle, outdated or malformed: {}", file);
+			}
+		}
 	}
 
-	fonts = new Font::FontManager{*atlas, AtlasPages::Font};
+	fonts = new Font::FontManager{*atlas, AtlasPages::Font, jobSystem};
 
 	{
 		Font::GlobalFontManager = fonts;
 
-		for (const auto & [name, abbr] : DefFonts){
+		for (const auto & [name, abbr, distanceField] : DefFonts){
 			Font::FontFaceStorage fontStorage{Assets::Dir::font.subFile(name).absolutePath().string().c_str()};
 
-			auto id = fonts->registerFace(abbr, Assets::Dir::font.subFile(name).absolutePath().string());
+			auto id = fonts->registerFace(abbr, Assets::Dir::font.subFile(name).absolutePath().string(),
+				distanceField ? Font::GlyphRenderMode::distanceField : Font::GlyphRenderMode::bitmap);
 			Font::namedFonts.insert_or_assign(abbr, id);
 		}
+
+		fonts->loadCache(Assets::Dir::fontCache);
 	}
+
+	atlas->flushUploads();
 }
 
 void Core::Global::Asset::terminate(){
+	fonts->saveCache(Assets::Dir::fontCache);
 	delete fonts;
 	delete atlas;
 }
@@ -25,6 +25,7 @@ import Core.Vulkan.EXT;
 
 
 import Core.Global;
+import Core.JobSystem;
 import Core.Global.Graphic;
 import Core.Global.UI;
 import Core.Global.Assets;
@@ -66,6 +67,8 @@ void Core::Global::loadEXT(){
 }
 
 void Core::Global::init_context(){
+    jobSystem = new JobSystem;
+
     GLFW::init();
 
     initFileSystem();
@@ -134,4 +137,6 @@ void Core::Global::terminate(){
     delete window;
 
     GLFW::terminate();
+
+    delete jobSystem;
 }
@@ -111,8 +111,25 @@ bool Core::UI::Element::containsPos_parent(const Geom::Vec2 cursorPos) const{
 	return (!parent || parent->containsPos_parent(cursorPos));
 }
 
+std::size_t Core::UI::Element::getDepth() const noexcept{
+	std::size_t depth{};
+	for(const Element* current = parent; current; current = current->getParent()){
+		++depth;
+	}
+	return depth;
+}
+
+void Core::UI::Element::setScene(Scene* s){
+	this->scene = s;
+
+	//changed before it was attached, nothing could register it yet
+	if(scene && layoutState.isChanged())scene->registerLayoutDirty(this);
+}
+
 void Core::UI::Element::notifyLayoutChanged(const SpreadDirection toDirection){
-	if(toDirection & SpreadDirection::local)layoutState.setSelfChanged();
+	if(toDirection & SpreadDirection::local && layoutState.setSelfChanged() && scene){
+		scene->registerLayoutDirty(this);
+	}
 
 	if(parent){
 		if(toDirection & SpreadDirection::super || toDirection & SpreadDirection::child_item){
@@ -44,13 +44,17 @@ void Core::UI::Scene::registerAsyncTaskElement(Element* element){
 	asyncTaskOwners.insert(element);
 }
 
-void Core::UI::Scene::registerIndependentLayout(Element* element){
-	// if constexpr (DEBUG_CHECK){
-	// 	if(std::ranges::contains(independentLayout, element)){
-	// 		throw std::invalid_argument("duplicated async task owner");
-	// 	}
-	// }
-	independentLayout.insert(element);
+void Core::UI::Scene::registerLayoutDirty(Element* element){
+	if(layoutDepth){
+		//a deeper element cannot dirty the current one back in this layout, so it always ends
+		if(const auto depth = element->getDepth(); depth > *layoutDepth){
+			layoutQueue.push_back({depth, element});
+			std::ranges::push_heap(layoutQueue, std::greater{}, &LayoutEntry::depth);
+			return;
+		}
+	}
+
+	dirtyLayouts.insert(element);
 }
 
 void Core::UI::Scene::dropAllFocus(const Element* target){
@@ -58,7 +62,10 @@ void Core::UI::Scene::dropAllFocus(const Element* target){
 	if(currentScrollFocus == target) currentScrollFocus = nullptr;
 	std::erase(lastInbounds, target);
 	asyncTaskOwners.erase(const_cast<Element*>(target));
-	independentLayout.erase(const_cast<Element*>(target));
+	dirtyLayouts.erase(const_cast<Element*>(target));
+	if(std::erase_if(layoutQueue, [target](const LayoutEntry& entry){ return entry.element == target; })){
+		std::ranges::make_heap(layoutQueue, std::greater{}, &LayoutEntry::depth);
+	}
 	tooltipManager.requestDrop(*target);
 }
 
@@ -171,12 +178,26 @@ void Core::UI::Scene::update(const float delta_in_ticks){
 }
 
 void Core::UI::Scene::layout(){
-	root->tryLayout();
+	if(dirtyLayouts.empty()) return;
+
+	for(Element* element : dirtyLayouts){
+		layoutQueue.push_back({element->getDepth(), element});
+	}
+	dirtyLayouts.clear();
 
-	for(const auto layout : independentLayout){
-		layout->tryLayout();
+	std::ranges::make_heap(layoutQueue, std::greater{}, &LayoutEntry::depth);
+
+	//a parent may lay out or resize its children, they come after it and skip the work if it is done
+	while(!layoutQueue.empty()){
+		std::ranges::pop_heap(layoutQueue, std::greater{}, &LayoutEntry::depth);
+		const auto [depth, element] = layoutQueue.back();
+		layoutQueue.pop_back();
+
+		layoutDepth = depth;
+		element->tryLayout();
 	}
-	independentLayout.clear();
+
+	layoutDepth.reset();
 }
 
 void Core::UI::Scene::draw() const{
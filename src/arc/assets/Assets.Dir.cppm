@@ -17,6 +17,7 @@ namespace Assets{
 	        inline Core::File shader_src;
 
 	        inline Core::File texture;
+	        inline Core::File atlas;
 	        inline Core::File font;
 	        inline Core::File svg;
 	        inline Core::File bundle;
@@ -29,6 +30,7 @@ namespace Assets{
 
 	        inline Core::File cache;
 	        inline Core::File texCache;
+	        inline Core::File fontCache;
 	    }
 
 		void patch(const Core::File& file){
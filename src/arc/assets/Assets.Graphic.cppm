@@ -23,6 +23,7 @@ export namespace Assets{
 		    Core::Vulkan::ShaderModule uiBatch{};
 
 		    Core::Vulkan::ShaderModule worldBatch{};
+		    Core::Vulkan::ShaderModule worldInstance{};
 		}
 
 		namespace Frag{
@@ -54,6 +55,7 @@ export namespace Assets{
 			Frag::uiBatch = {};
 
 			Vert::worldBatch = {};
+			Vert::worldInstance = {};
 			Frag::worldBatch = {};
 
 			Comp::worldMerge = {};
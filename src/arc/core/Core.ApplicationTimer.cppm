@@ -89,7 +89,64 @@ export namespace Core{
 		[[nodiscard]] constexpr Tick updateDeltaTick() const noexcept{return getUpdateDelta();}
 
 	};
-	
 
-	
+	/**
+	 * @brief Splits variable frame deltas into a whole number of fixed simulation steps
+	 *
+	 * The leftover time stays in the accumulator, its ratio to the step is the render interpolation factor.
+	 * At most @link getMaxStepsPerFrame @endlink steps are issued per frame, time beyond that is dropped
+	 * so a slow frame cannot snowball into ever more catch-up steps.
+	 */
+	template <typename T>
+		requires (std::is_floating_point_v<T>)
+	class FixedTimestep{
+		using Tick = DirectAccessTimeUnit<T, TickRatio>;
+
+		T step{1};
+		unsigned maxStepsPerFrame{5};
+
+		T accumulator{};
+		std::size_t droppedSteps{};
+
+	public:
+		[[nodiscard]] constexpr FixedTimestep() noexcept = default;
+
+		/**
+		 * @param step simulation step in ticks
+		 * @param maxStepsPerFrame catch-up cap
+		 */
+		[[nodiscard]] constexpr explicit FixedTimestep(const Tick step, const unsigned maxStepsPerFrame = 5) noexcept :
+			step{T(step)}, maxStepsPerFrame{maxStepsPerFrame}{}
+
+		/**
+		 * @return steps to simulate this frame
+		 */
+		constexpr unsigned advance(const Tick delta) noexcept{
+			accumulator += T(delta);
+
+			auto steps = static_cast<unsigned>(accumulator / step);
+			accumulator -= static_cast<T>(steps) * step;
+
+			if(steps > maxStepsPerFrame){
+				droppedSteps += steps - maxStepsPerFrame;
+				steps = maxStepsPerFrame;
+			}
+
+			return steps;
+		}
+
+		constexpr void reset() noexcept{
+			accumulator = {};
+		}
+
+		[[nodiscard]] constexpr Tick getStep() const noexcept{ return {step}; }
+
+		[[nodiscard]] constexpr unsigned getMaxStepsPerFrame() const noexcept{ return maxStepsPerFrame; }
+
+		/** @brief [0, 1), progress from the last simulated state towards the next one */
+		[[nodiscard]] constexpr T getInterpolation() const noexcept{ return accumulator / step; }
+
+		/** @brief steps discarded by the catch-up cap so far */
+		[[nodiscard]] constexpr std::size_t getDroppedSteps() const noexcept{ return droppedSteps; }
+	};
 }
@@ -0,0 +1,319 @@
+module;
+
+#include <cassert>
+#include "../src/arc/core/profiler.hpp"
+
+export module Core.JobSystem;
+
+import Core.Profiler;
+import std;
+
+namespace Core{
+	struct JobState{
+		std::move_only_function<void()> task{};
+
+		/** @brief unfinished dependencies, plus one held by the submitter until it is registered everywhere */
+		std::atomic<unsigned> unmetDependencies{1};
+		std::atomic<bool> done{};
+
+		std::mutex dependentsMutex{};
+		std::vector<std::shared_ptr<JobState>> dependents{};
+	};
+
+	/**
+	 * @brief a queued unit of work, either a submitted job or a chunk of a parallel loop
+	 */
+	struct Job{
+		std::move_only_function<void()> task{};
+		std::shared_ptr<JobState> state{};
+	};
+
+	/**
+	 * @brief Queue of one thread, the owner pushes and pops at the back, thieves take from the front.
+	 */
+	class WorkQueue{
+		mutable std::mutex mutex{};
+		std::deque<Job> jobs{};
+
+	public:
+		void push(Job&& job){
+			std::scoped_lock lk{mutex};
+			jobs.push_back(std::move(job));
+		}
+
+		[[nodiscard]] std::optional<Job> pop(){
+			std::scoped_lock lk{mutex};
+			if(jobs.empty()) return std::nullopt;
+			Job job = std::move(jobs.back());
+			jobs.pop_back();
+			return job;
+		}
+
+		[[nodiscard]] std::optional<Job> steal(){
+			std::scoped_lock lk{mutex};
+			if(jobs.empty()) return std::nullopt;
+			Job job = std::move(jobs.front());
+			jobs.pop_front();
+			return job;
+		}
+	};
+
+	/** @brief index of the queue owned by the current thread, the shared injection queue for non-worker threads */
+	thread_local std::size_t localQueueIndex = std::numeric_limits<std::size_t>::max();
+	thread_local const void* localQueueOwner{};
+}
+
+export namespace Core{
+	/**
+	 * @brief Handle of a submitted job, can be waited on or used as a dependency of later jobs
+	 */
+	class JobHandle{
+		std::shared_ptr<JobState> state{};
+
+		friend class JobSystem;
+
+		[[nodiscard]] explicit JobHandle(std::shared_ptr<JobState> state) noexcept : state{std::move(state)}{}
+
+	public:
+		[[nodiscard]] JobHandle() = default;
+
+		[[nodiscard]] bool valid() const noexcept{
+			return state != nullptr;
+		}
+
+		[[nodiscard]] explicit operator bool() const noexcept{
+			return valid();
+		}
+
+		[[nodiscard]] bool done() const noexcept{
+			return !state || state->done.load(std::memory_order::acquire);
+		}
+	};
+
+	/**
+	 * @brief Engine owned work-stealing thread pool
+	 *
+	 * Each worker owns a queue and steals from the others when it runs dry, threads outside the pool submit to a shared queue.
+	 * Waiting (@link wait @endlink, @link parallel_for @endlink) never blocks a thread while there is work it could run,
+	 * so nested fork/join inside jobs cannot deadlock.
+	 */
+	class JobSystem{
+		std::vector<WorkQueue> queues;
+		std::vector<std::jthread> workers{};
+
+		/** @brief queued job count, workers sleep on it */
+		std::atomic<std::size_t> queued{};
+		std::atomic<bool> stopping{};
+
+	public:
+		/**
+		 * @param workerCount threads besides the caller, the hardware concurrency minus one by default
+		 */
+		[[nodiscard]] explicit JobSystem(const unsigned workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1)
+			: queues(workerCount + 1){
+			workers.reserve(workerCount);
+
+			for(unsigned i = 0; i < workerCount; ++i){
+				workers.emplace_back([this, i]{
+					localQueueIndex = i;
+					localQueueOwner = this;
+#if PROFILER_ENABLED
+					Profiler::setThreadName(std::format("worker {}", i));
+#endif
+					workerLoop();
+				});
+			}
+		}
+
+		~JobSystem(){
+			stopping.store(true, std::memory_order::release);
+			queued.fetch_add(1, std::memory_order::release);
+			queued.notify_all();
+			workers.clear();
+		}
+
+		JobSystem(const JobSystem& other) = delete;
+		JobSystem(JobSystem&& other) noexcept = delete;
+		JobSystem& operator=(const JobSystem& other) = delete;
+		JobSystem& operator=(JobSystem&& other) noexcept = delete;
+
+		/**
+		 * @brief worker threads plus the calling thread
+		 */
+		[[nodiscard]] unsigned concurrency() const noexcept{
+			return static_cast<unsigned>(workers.size() + 1);
+		}
+
+		/**
+		 * @param dependencies the job is queued only after all of them are done
+		 */
+		template <std::invocable<> Fn>
+		JobHandle submit(Fn&& fn, const std::initializer_list<JobHandle> dependencies = {}){
+			auto state = std::make_shared<JobState>();
+			state->task = std::forward<Fn>(fn);
+
+			for(const JobHandle& dependency : dependencies){
+				if(!dependency.state) continue;
+
+				std::scoped_lock lk{dependency.state->dependentsMutex};
+				if(dependency.state->done.load(std::memory_order::acquire)) continue;
+
+				state->unmetDependencies.fetch_add(1, std::memory_order::relaxed);
+				dependency.state->dependents.push_back(state);
+			}
+
+			JobHandle handle{state};
+			if(state->unmetDependencies.fetch_sub(1, std::memory_order::acq_rel) == 1){
+				enqueue(makeJob(std::move(state)));
+			}
+
+			return handle;
+		}
+
+		/**
+		 * @brief run queued jobs on the calling thread until the job is done
+		 */
+		void wait(const JobHandle& handle){
+			if(!handle.state) return;
+
+			while(!handle.done()){
+				if(!runOne()){
+					//nothing to help with, the job is running somewhere else
+					handle.state->done.wait(false, std::memory_order::acquire);
+				}
+			}
+		}
+
+		/**
+		 * @brief fork/join over [0, count), `fn(begin, end)` is called for chunks of about `grain` indices
+		 * @param grain 0 picks about four chunks per thread
+		 */
+		template <std::invocable<std::size_t, std::size_t> Fn>
+		void parallel_for(const std::size_t count, std::size_t grain, Fn fn){
+			if(count == 0) return;
+
+			if(grain == 0){
+				grain = std::max<std::size_t>(1, count / (concurrency() * 4));
+			}
+
+			const std::size_t chunks = (count + grain - 1) / grain;
+			if(chunks == 1 || workers.empty()){
+				std::invoke(fn, std::size_t{}, count);
+				return;
+			}
+
+			std::atomic<std::size_t> remaining{chunks - 1};
+
+			for(std::size_t chunk = 1; chunk < chunks; ++chunk){
+				const std::size_t begin = chunk * grain;
+				const std::size_t end = std::min(count, begin + grain);
+
+				enqueue(Job{[&fn, &remaining, begin, end]{
+					std::invoke(fn, begin, end);
+					remaining.fetch_sub(1, std::memory_order::release);
+				}});
+			}
+
+			std::invoke(fn, std::size_t{}, std::min(count, grain));
+
+			while(remaining.load(std::memory_order::acquire) != 0){
+				if(!runOne()) std::this_thread::yield();
+			}
+		}
+
+		/**
+		 * @brief fork/join `fn(element)` over a random access range
+		 */
+		template <std::ranges::random_access_range Rng, typename Fn>
+			requires std::invocable<Fn&, std::ranges::range_reference_t<Rng>>
+		void for_each(Rng&& range, Fn fn, const std::size_t grain = 0){
+			const auto begin = std::ranges::begin(range);
+
+			this->parallel_for(static_cast<std::size_t>(std::ranges::distance(range)), grain, [&fn, begin](const std::size_t from, const std::size_t to){
+				for(std::size_t i = from; i < to; ++i){
+					std::invoke(fn, begin[static_cast<std::ranges::range_difference_t<Rng>>(i)]);
+				}
+			});
+		}
+
+	private:
+		[[nodiscard]] std::size_t injectionQueueIndex() const noexcept{
+			return queues.size() - 1;
+		}
+
+		[[nodiscard]] std::size_t currentQueueIndex() const noexcept{
+			return localQueueOwner == this ? localQueueIndex : injectionQueueIndex();
+		}
+
+		[[nodiscard]] Job makeJob(std::shared_ptr<JobState>&& state){
+			Job job{};
+			job.task = std::move(state->task);
+			job.state = std::move(state);
+			return job;
+		}
+
+		void enqueue(Job&& job){
+			//count first, so a thief never decrements below zero
+			queued.fetch_add(1, std::memory_order::release);
+			queues[currentQueueIndex()].push(std::move(job));
+			queued.notify_one();
+		}
+
+		[[nodiscard]] std::optional<Job> find(){
+			const std::size_t self = currentQueueIndex();
+
+			if(auto job = queues[self].pop()) return job;
+
+			for(std::size_t offset = 1; offset < queues.size(); ++offset){
+				if(auto job = queues[(self + offset) % queues.size()].steal()) return job;
+			}
+
+			return std::nullopt;
+		}
+
+		/**
+		 * @return false if no job was found
+		 */
+		bool runOne(){
+			std::optional<Job> job = find();
+			if(!job) return false;
+
+			queued.fetch_sub(1, std::memory_order::relaxed);
+			job->task();
+
+			if(job->state) complete(*job->state);
+
+			return true;
+		}
+
+		void complete(JobState& state){
+			std::vector<std::shared_ptr<JobState>> dependents{};
+			{
+				std::scoped_lock lk{state.dependentsMutex};
+				state.done.store(true, std::memory_order::release);
+				dependents = std::move(state.dependents);
+			}
+
+			state.done.notify_all();
+
+			for(auto& dependent : dependents){
+				if(dependent->unmetDependencies.fetch_sub(1, std::memory_order::acq_rel) == 1){
+					enqueue(makeJob(std::move(dependent)));
+				}
+			}
+		}
+
+		void workerLoop(){
+			while(!stopping.load(std::memory_order::acquire)){
+				if(runOne()) continue;
+
+				if(const auto count = queued.load(std::memory_order::acquire); count == 0){
+					queued.wait(0, std::memory_order::acquire);
+				}else{
+					//a job is being pushed or was just taken by another thread
+					std::this_thread::yield();
+				}
+			}
+		}
+	};
+}
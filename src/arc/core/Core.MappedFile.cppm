@@ -0,0 +1,133 @@
+module;
+
+#if defined(_WIN32) || defined(_WIN64)
+#define WIN_SYS
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+export module Core.MappedFile;
+
+import Core.File;
+import ext.RuntimeException;
+import std;
+
+export namespace Core{
+	/**
+	 * @brief A read only view of a whole file mapped into memory, the pages are read by the system when first touched.
+	 */
+	class MappedFile{
+		const std::byte* data{};
+		std::size_t size{};
+
+#ifdef WIN_SYS
+		HANDLE file{INVALID_HANDLE_VALUE};
+		HANDLE mapping{};
+#endif
+
+	public:
+		[[nodiscard]] MappedFile() = default;
+
+		[[nodiscard]] explicit MappedFile(const File& source){
+#ifdef WIN_SYS
+			file = CreateFileW(source.absolutePath().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if(file == INVALID_HANDLE_VALUE){
+				throw ext::RuntimeException{std::format("Failed to open file '{}'", source.filename())};
+			}
+
+			LARGE_INTEGER fileSize{};
+			GetFileSizeEx(file, &fileSize);
+			size = static_cast<std::size_t>(fileSize.QuadPart);
+
+			//an empty file cannot be mapped
+			if(size == 0) return;
+
+			mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if(!mapping){
+				close();
+				throw ext::RuntimeException{std::format("Failed to map file '{}'", source.filename())};
+			}
+
+			data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+			const int descriptor = ::open(source.absolutePath().c_str(), O_RDONLY);
+			if(descriptor < 0){
+				throw ext::RuntimeException{std::format("Failed to open file '{}'", source.filename())};
+			}
+
+			struct stat status{};
+			::fstat(descriptor, &status);
+			size = static_cast<std::size_t>(status.st_size);
+
+			if(size != 0){
+				if(void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0); view != MAP_FAILED){
+					data = static_cast<const std::byte*>(view);
+				}
+			}
+
+			//the mapping stays valid after the descriptor is closed
+			::close(descriptor);
+#endif
+
+			if(size != 0 && !data){
+				close();
+				throw ext::RuntimeException{std::format("Failed to map file '{}'", source.filename())};
+			}
+		}
+
+		MappedFile(const MappedFile& other) = delete;
+
+		MappedFile(MappedFile&& other) noexcept{
+			this->operator=(std::move(other));
+		}
+
+		MappedFile& operator=(const MappedFile& other) = delete;
+
+		MappedFile& operator=(MappedFile&& other) noexcept{
+			if(this == &other) return *this;
+			close();
+
+			data = std::exchange(other.data, nullptr);
+			size = std::exchange(other.size, 0);
+#ifdef WIN_SYS
+			file = std::exchange(other.file, INVALID_HANDLE_VALUE);
+			mapping = std::exchange(other.mapping, nullptr);
+#endif
+
+			return *this;
+		}
+
+		~MappedFile(){
+			close();
+		}
+
+		[[nodiscard]] std::span<const std::byte> bytes() const noexcept{
+			return {data, data ? size : 0};
+		}
+
+		[[nodiscard]] bool empty() const noexcept{
+			return bytes().empty();
+		}
+
+	private:
+		void close() noexcept{
+#ifdef WIN_SYS
+			if(data) UnmapViewOfFile(data);
+			if(mapping) CloseHandle(mapping);
+			if(file != INVALID_HANDLE_VALUE) CloseHandle(file);
+			mapping = nullptr;
+			file = INVALID_HANDLE_VALUE;
+#else
+			if(data) ::munmap(const_cast<std::byte*>(data), size);
+#endif
+			data = nullptr;
+			size = 0;
+		}
+	};
+}
@@ -0,0 +1,211 @@
+export module Core.Profiler;
+
+import std;
+
+namespace Core::Profiler{
+	using Timestamp = std::int64_t;
+
+	/** @brief per thread, old zones are overwritten once it is full */
+	constexpr std::size_t RingCapacity = 1 << 15;
+
+	/**
+	 * @brief A finished zone, guarded by a sequence number so the exporter can read it while the owner keeps recording.
+	 *
+	 * The sequence is the ring index plus one once the slot is complete, zero while it is being written.
+	 */
+	struct EventSlot{
+		std::atomic<std::uint64_t> sequence{};
+		std::atomic<const char*> name{};
+		std::atomic<Timestamp> begin{};
+		std::atomic<Timestamp> end{};
+	};
+
+	struct ThreadBuffer{
+		std::uint32_t id{};
+		std::string name{};
+
+		/** @brief written by the owner only */
+		std::atomic<std::uint64_t> head{};
+		std::unique_ptr<EventSlot[]> slots{std::make_unique<EventSlot[]>(RingCapacity)};
+
+		void push(const char* name, const Timestamp begin, const Timestamp end) noexcept{
+			const std::uint64_t index = head.load(std::memory_order::relaxed);
+			EventSlot& slot = slots[index % RingCapacity];
+
+			slot.sequence.store(0, std::memory_order::relaxed);
+			std::atomic_thread_fence(std::memory_order::release);
+
+			slot.name.store(name, std::memory_order::relaxed);
+			slot.begin.store(begin, std::memory_order::relaxed);
+			slot.end.store(end, std::memory_order::relaxed);
+
+			slot.sequence.store(index + 1, std::memory_order::release);
+			head.store(index + 1, std::memory_order::release);
+		}
+	};
+
+	struct Registry{
+		std::mutex mutex{};
+		/** @brief never shrinks, zones of finished threads stay exportable */
+		std::vector<std::unique_ptr<ThreadBuffer>> buffers{};
+	};
+
+	Registry& registry(){
+		static Registry instance{};
+		return instance;
+	}
+
+	thread_local ThreadBuffer* localBuffer{};
+
+	ThreadBuffer& acquireBuffer(){
+		if(localBuffer) return *localBuffer;
+
+		Registry& reg = registry();
+		std::scoped_lock lk{reg.mutex};
+
+		auto& buffer = reg.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+		buffer->id = static_cast<std::uint32_t>(reg.buffers.size() - 1);
+		buffer->name = std::format("thread {}", buffer->id);
+
+		return *(localBuffer = buffer.get());
+	}
+
+	std::atomic<bool> recording{true};
+
+	[[nodiscard]] Timestamp now() noexcept{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+export namespace Core::Profiler{
+	/**
+	 * @brief Times its own lifetime on the current thread, use it through PROFILE_ZONE from profiler.hpp
+	 */
+	class Zone{
+		const char* name;
+		ThreadBuffer* buffer{};
+		Timestamp begin{};
+
+	public:
+		[[nodiscard]] explicit Zone(const char* name) noexcept : name{name}{
+			if(!recording.load(std::memory_order::relaxed)) return;
+
+			buffer = &acquireBuffer();
+			begin = now();
+		}
+
+		~Zone(){
+			if(!buffer) return;
+
+			buffer->push(name, begin, now());
+		}
+
+		Zone(const Zone& other) = delete;
+		Zone(Zone&& other) noexcept = delete;
+		Zone& operator=(const Zone& other) = delete;
+		Zone& operator=(Zone&& other) noexcept = delete;
+	};
+
+	/**
+	 * @brief shown as the thread name in the trace viewer
+	 */
+	void setThreadName(const std::string_view name){
+		ThreadBuffer& buffer = acquireBuffer();
+
+		std::scoped_lock lk{registry().mutex};
+		buffer.name = name;
+	}
+
+	/**
+	 * @brief zones opened while paused are not recorded
+	 */
+	void setRecording(const bool record) noexcept{
+		recording.store(record, std::memory_order::relaxed);
+	}
+
+	[[nodiscard]] bool isRecording() noexcept{
+		return recording.load(std::memory_order::relaxed);
+	}
+
+	/**
+	 * @brief Chrome trace event JSON of the zones still held by the ring buffers, open it in chrome://tracing or Perfetto
+	 *
+	 * Safe to call while other threads keep recording, zones overwritten during the read are skipped.
+	 */
+	[[nodiscard]] std::string toChromeTrace(){
+		struct Event{
+			std::uint32_t tid;
+			const char* name;
+			Timestamp begin;
+			Timestamp end;
+		};
+
+		std::vector<Event> events{};
+		std::vector<std::pair<std::uint32_t, std::string>> threads{};
+
+		{
+			Registry& reg = registry();
+			std::scoped_lock lk{reg.mutex};
+
+			for(const auto& buffer : reg.buffers){
+				threads.emplace_back(buffer->id, buffer->name);
+
+				const std::uint64_t head = buffer->head.load(std::memory_order::acquire);
+				const std::uint64_t first = head > RingCapacity ? head - RingCapacity : 0;
+
+				for(std::uint64_t index = first; index < head; ++index){
+					const EventSlot& slot = buffer->slots[index % RingCapacity];
+
+					const std::uint64_t sequence = slot.sequence.load(std::memory_order::acquire);
+					const Event event{
+						buffer->id,
+						slot.name.load(std::memory_order::relaxed),
+						slot.begin.load(std::memory_order::relaxed),
+						slot.end.load(std::memory_order::relaxed),
+					};
+					std::atomic_thread_fence(std::memory_order::acquire);
+
+					if(sequence != index + 1 || slot.sequence.load(std::memory_order::relaxed) != sequence) continue;
+
+					events.push_back(event);
+				}
+			}
+		}
+
+		const Timestamp origin = events.empty() ? 0 : std::ranges::min(events, {}, &Event::begin).begin;
+
+		std::string json{"{\"traceEvents\":[\n"};
+		bool first = true;
+
+		const auto separate = [&]{
+			if(!std::exchange(first, false)) json += ",\n";
+		};
+
+		for(const auto& [tid, name] : threads){
+			separate();
+			//names are plain identifiers written by the engine, no escaping needed
+			std::format_to(std::back_inserter(json),
+				R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{}"}}}})", tid, name);
+		}
+
+		for(const Event& event : events){
+			separate();
+			std::format_to(std::back_inserter(json),
+				R"({{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+				event.name, event.tid,
+				static_cast<double>(event.begin - origin) / 1000., static_cast<double>(event.end - event.begin) / 1000.);
+		}
+
+		json += "\n]}\n";
+		return json;
+	}
+
+	/**
+	 * @return false if the file cannot be written
+	 */
+	bool exportChromeTrace(const std::filesystem::path& path){
+		std::ofstream file{path, std::ios::binary};
+		file << toChromeTrace();
+		return static_cast<bool>(file);
+	}
+}
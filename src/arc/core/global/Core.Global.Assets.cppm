@@ -23,9 +23,12 @@ export namespace Core::Global::Asset{
 		constexpr std::string_view Font{"font"};
 	}
 
+	/**
+	 * @brief [file, name, drawn as distance field], the CJK face covers most code points and is scaled the most
+	 */
 	constexpr std::array DefFonts{
-		std::pair<std::string_view, std::string_view>{"SourceHanSerifSC-SemiBold.otf", "srcH"},
-		std::pair<std::string_view, std::string_view>{"telegrama.otf", "tele"}
+		std::tuple<std::string_view, std::string_view, bool>{"SourceHanSerifSC-SemiBold.otf", "srcH", true},
+		std::tuple<std::string_view, std::string_view, bool>{"telegrama.otf", "tele", false}
 	};
 
 	Graphic::ImageAtlas* atlas{nullptr};
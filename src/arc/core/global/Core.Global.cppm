@@ -18,6 +18,8 @@ export namespace Core {
     }
 
     struct Window;
+
+    class JobSystem;
 }
 
 
@@ -28,4 +30,5 @@ export namespace Core::Global{
     Window* window{};
     Graphic::Camera2D* mainCamera{};
 	Vulkan::VulkanManager* vulkanManager{};
+	JobSystem* jobSystem{};
 }
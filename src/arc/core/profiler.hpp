@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Scoped zone CPU profiler, see the module Core.Profiler.
+ * The zone macros expand to nothing unless the build defines PROFILER_ENABLED=1.
+ */
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+#if PROFILER_ENABLED
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+/** @brief time the rest of the enclosing scope, the name must outlive the profiler, e.g. a string literal */
+#define PROFILE_ZONE(name) const ::Core::Profiler::Zone PROFILE_CONCAT(profileZone_, __LINE__){name}
+
+#else
+
+#define PROFILE_ZONE(name) static_cast<void>(0)
+
+#endif
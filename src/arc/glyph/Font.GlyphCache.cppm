@@ -0,0 +1,148 @@
+export module Font.GlyphCache;
+
+export import Font;
+
+import Core.File;
+import Graphic.Pixmap;
+import std;
+
+export namespace Font::GlyphCache{
+	/**
+	 * @brief Rendered glyphs of a face kept on disk between launches, so they skip the rasterization.
+	 *
+	 * Layout: @link Header @endlink, @link Record @endlink for every glyph, then the RGBA pixels of the records in order.
+	 * A cache of another version, font file, face index or render mode is ignored and written again.
+	 */
+	constexpr std::uint32_t Magic{0x4359'4c47}; //GLYC
+	constexpr std::uint32_t Version{2};
+
+	constexpr std::string_view Extension{".glyphs"};
+
+	struct Header{
+		std::uint32_t magic{Magic};
+		std::uint32_t version{Version};
+		std::uint64_t fontHash{};
+		std::uint32_t faceIndex{};
+		std::uint32_t count{};
+		GlyphRenderMode renderMode{};
+	};
+
+	struct Record{
+		GlyphKey key{};
+		/** @brief FreeType metrics widened, `FT_Pos` differs between platforms */
+		std::array<std::int64_t, 8> metrics{};
+		std::uint32_t width{};
+		std::uint32_t height{};
+	};
+
+	static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Record>);
+
+	struct Entry{
+		GlyphKey key{};
+		GlyphRawMetrics metrics{};
+		Graphic::Pixmap bitmap{};
+	};
+
+	/**
+	 * @brief FNV-1a of the whole font file, stable between runs unlike @link std::hash @endlink
+	 */
+	[[nodiscard]] std::uint64_t hashFile(const Core::File& file){
+		std::uint64_t hash{0xcbf2'9ce4'8422'2325ull};
+
+		if(!file.exist() || file.getFileSize() == 0) return hash;
+
+		for(const std::byte byte : file.readBytes()){
+			hash ^= std::to_integer<std::uint64_t>(byte);
+			hash *= 0x0000'0100'0000'01b3ull;
+		}
+
+		return hash;
+	}
+
+	/**
+	 * @return empty if the file is missing, broken or built from something else
+	 */
+	[[nodiscard]] std::optional<std::vector<Entry>> read(const Core::File& file, const std::uint64_t fontHash, const std::uint32_t faceIndex, const GlyphRenderMode renderMode){
+		if(!file.exist() || file.getFileSize() < sizeof(Header)) return std::nullopt;
+
+		//read at once, the records and pixels are copied out of it without further io
+		const std::vector<std::byte> bytes = file.readBytes();
+
+		Header header{};
+		std::memcpy(&header, bytes.data(), sizeof(Header));
+
+		if(header.magic != Magic || header.version != Version || header.fontHash != fontHash || header.faceIndex != faceIndex || header.renderMode != renderMode){
+			return std::nullopt;
+		}
+
+		std::size_t pixelOffset = sizeof(Header) + header.count * sizeof(Record);
+		if(pixelOffset > bytes.size()) return std::nullopt;
+
+		std::vector<Entry> entries{};
+		entries.reserve(header.count);
+
+		for(std::uint32_t i = 0; i < header.count; ++i){
+			Record record{};
+			std::memcpy(&record, bytes.data() + sizeof(Header) + i * sizeof(Record), sizeof(Record));
+
+			auto& entry = entries.emplace_back();
+			entry.key = record.key;
+
+			auto& metrics = entry.metrics;
+			using Pos = decltype(metrics.width);
+			metrics.width = static_cast<Pos>(record.metrics[0]);
+			metrics.height = static_cast<Pos>(record.metrics[1]);
+			metrics.horiBearingX = static_cast<Pos>(record.metrics[2]);
+			metrics.horiBearingY = static_cast<Pos>(record.metrics[3]);
+			metrics.horiAdvance = static_cast<Pos>(record.metrics[4]);
+			metrics.vertBearingX = static_cast<Pos>(record.metrics[5]);
+			metrics.vertBearingY = static_cast<Pos>(record.metrics[6]);
+			metrics.vertAdvance = static_cast<Pos>(record.metrics[7]);
+
+			//the texel count cannot overflow 64 bits, its byte size is checked against what is left without multiplying
+			const std::uint64_t texels = std::uint64_t{record.width} * record.height;
+			if(texels == 0) continue;
+			if(texels > (bytes.size() - pixelOffset) / Graphic::Pixmap::Channels) return std::nullopt;
+
+			const std::size_t sizeBytes = static_cast<std::size_t>(texels) * Graphic::Pixmap::Channels;
+
+			entry.bitmap = Graphic::Pixmap{record.width, record.height};
+			std::memcpy(entry.bitmap.data(), bytes.data() + pixelOffset, sizeBytes);
+			pixelOffset += sizeBytes;
+		}
+
+		return entries;
+	}
+
+	/**
+	 * @param glyphs must stay alive while writing
+	 */
+	void write(Core::File& file, const std::uint64_t fontHash, const std::uint32_t faceIndex, const GlyphRenderMode renderMode, const std::span<const std::pair<GlyphKey, const BitmapGlyph*>> glyphs){
+		file.writeByte([&](std::ofstream& stream){
+			const Header header{.fontHash = fontHash, .faceIndex = faceIndex, .count = static_cast<std::uint32_t>(glyphs.size()), .renderMode = renderMode};
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+			for(const auto& [key, glyph] : glyphs){
+				const auto& metrics = glyph->metrics;
+
+				const Record record{
+					.key = key,
+					.metrics = {
+						metrics.width, metrics.height,
+						metrics.horiBearingX, metrics.horiBearingY, metrics.horiAdvance,
+						metrics.vertBearingX, metrics.vertBearingY, metrics.vertAdvance
+					},
+					.width = glyph->bitmap.valid() ? glyph->bitmap.getWidth() : 0,
+					.height = glyph->bitmap.valid() ? glyph->bitmap.getHeight() : 0,
+				};
+
+				stream.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+			}
+
+			for(const auto& glyph : glyphs | std::views::values){
+				if(!glyph->bitmap.valid()) continue;
+				stream.write(reinterpret_cast<const char*>(glyph->bitmap.data()), static_cast<std::streamsize>(glyph->bitmap.sizeBytes()));
+			}
+		});
+	}
+}
@@ -7,6 +7,8 @@ export module Font.Manager;
 export import Font;
 
 import Graphic.ImageRegion;
+import Core.JobSystem;
+import Core.File;
 
 import Geom.Vector2D;
 
@@ -20,42 +22,127 @@ export namespace Graphic{
 
 
 export namespace Font{
+	struct FontManager;
 
 	struct Glyph : Graphic::ImageViewRegion{
 		GlyphMetrics metrics{};
+		/** @brief border of the distance field around @link metrics @endlink in pixels, zero for bitmap glyphs */
+		float spread{};
 
 		[[nodiscard]] Glyph() = default;
 
-		[[nodiscard]] explicit Glyph(const ImageViewRegion& view, const GlyphMetrics& metrics)
-			: ImageViewRegion{view}, metrics{metrics}{}
+		[[nodiscard]] explicit Glyph(const ImageViewRegion& view, const GlyphMetrics& metrics, const float spread = 0)
+			: ImageViewRegion{view}, metrics{metrics}, spread{spread}{}
+
+		[[nodiscard]] constexpr bool isDistanceField() const noexcept{
+			return spread > 0;
+		}
 
 		[[nodiscard]] constexpr bool drawable() const noexcept{
 			return size.area() == 0;
 		}
 	};
 
+	/**
+	 * @brief A font face with a thread safe cache of its atlas glyphs.
+	 *
+	 * Cached glyphs are node based and never erased, references to them stay valid for the lifetime of the face.
+	 */
 	class IndexedFontFace : FontFaceStorage{
 		FontFaceID index{};
+		std::string sourcePath{};
+
+		mutable std::shared_mutex glyphMutex{};
+		std::unordered_map<GlyphKey, Glyph> validGlyphs{};
 
 	public:
 		using FontFaceStorage::FontFaceStorage;
 
-		std::unordered_map<GlyphKey, Glyph> validGlyphs{};
-
 		[[nodiscard]] IndexedFontFace() = default;
 
-		[[nodiscard]] IndexedFontFace(const std::string_view fontPath, const FontFaceID index)
+		[[nodiscard]] IndexedFontFace(const std::string_view fontPath, const FontFaceID index, const GlyphRenderMode mode = GlyphRenderMode::bitmap)
 			: FontFaceStorage{fontPath},
-			  index{index}{}
+			  index{index}, sourcePath{fontPath}{
+			renderMode = mode;
+		}
 
 		[[nodiscard]] FontFaceID getIndex() const noexcept{
 			return index;
 		}
 
+		[[nodiscard]] std::string_view getSourcePath() const noexcept{
+			return sourcePath;
+		}
+
+		/** @brief index of the face inside its font file */
+		[[nodiscard]] std::uint32_t getFileFaceIndex() const noexcept{
+			return static_cast<std::uint32_t>(face.getFaceIndex());
+		}
+
+		using FontFaceStorage::visitGlyphs;
+		using FontFaceStorage::glyphCount;
+
+		[[nodiscard]] GlyphRenderMode getRenderMode() const noexcept{
+			return renderMode;
+		}
+
+		/**
+		 * @brief the key the glyph is rasterized and cached with, every size of a distance field face shares one
+		 */
+		[[nodiscard]] GlyphKey atlasKeyOf(const GlyphKey key) const noexcept{
+			return renderMode == GlyphRenderMode::distanceField ? GlyphKey{key.code, DistanceFieldSize} : key;
+		}
+
+		/**
+		 * @brief scale from the cached glyph to the glyph of `size`, a zero axis follows the other one as FreeType does
+		 */
+		[[nodiscard]] Geom::Vec2 scaleOf(GlyphSizeType size) const noexcept{
+			if(renderMode != GlyphRenderMode::distanceField) return Geom::norBaseVec2<float>;
+
+			if(size.x == 0) size.x = size.y;
+			if(size.y == 0) size.y = size.x;
+
+			return size.as<float>() / static_cast<float>(DistanceFieldSize.y);
+		}
+
+		/**
+		 * @brief Caches a glyph rendered in an earlier run, its view is assigned once the bitmap is uploaded.
+		 * @return the cached glyph and its stored bitmap, the glyph is null if the key was cached already
+		 */
+		std::pair<Glyph*, const BitmapGlyph*> restoreGlyph(GlyphKey key, BitmapGlyph&& bitmap);
+
+		/**
+		 * @brief Keys passed to the lookups below are mapped by @link atlasKeyOf @endlink,
+		 * so the glyphs of a distance field face carry the metrics of @link DistanceFieldSize @endlink.
+		 * @return Nullable, the cached glyph
+		 */
+		[[nodiscard]] Glyph* findGlyph(GlyphKey key);
+
 		/**
-		 * @brief If guaranteed to get a glyph from cache, then atlas and page can be @code nullptr@endcode
+		 * @brief Rasterizes and uploads a missing glyph on the calling thread.
+		 * If guaranteed to get a glyph from cache, then atlas and page can be @code nullptr@endcode
 		 */
-		Glyph& obtainGlyph(GlyphKey key, const Graphic::ImageAtlas* atlas = nullptr, Graphic::ImagePage* page = nullptr);
+		Glyph& obtainGlyph(GlyphKey key, Graphic::ImageAtlas* atlas = nullptr, Graphic::ImagePage* page = nullptr);
+
+		/**
+		 * @brief A missing glyph is cached with its metrics only and rasterized by the manager in background,
+		 * its view stays empty until @link FontManager::flushUploads @endlink lands it.
+		 *
+		 * Layouts keep the returned reference, so they draw the glyph as soon as it lands without being parsed again.
+		 */
+		Glyph& requestGlyph(GlyphKey key, FontManager& manager);
+
+		/**
+		 * @brief reassigns the views of the landed glyphs from their named regions in `page`, after the page moved them
+		 */
+		void refreshGlyphViews(Graphic::ImagePage& page);
+
+		/**
+		 * @brief renders the bitmap of the glyph, thread safe
+		 */
+		[[nodiscard]] const BitmapGlyph& rasterize(const GlyphKey key){
+			return tryLoad(key.code, key.size);
+		}
 
 		//make it sso optm
 		[[nodiscard]] std::string toString_short(const CharCode code, const GlyphSizeType size){
@@ -72,16 +159,69 @@ export namespace Font{
 
 	struct FontManager{
 	private:
+		struct PendingGlyph{
+			IndexedFontFace* face{};
+			GlyphKey key{};
+			Glyph* glyph{};
+			const BitmapGlyph* bitmap{};
+		};
+
 		Graphic::ImageAtlas* atlas{};
 		Graphic::ImagePage* fontPage{};
 		std::string fontPageName{"font"};
 		ext::string_hash_map<IndexedFontFace> fontFaces{};
 		std::vector<IndexedFontFace*> fontFaces_fastAccess{};
 
+		/** @brief Nullable, glyphs are rasterized on the requesting thread without it */
+		Core::JobSystem* jobSystem{};
+
+		std::mutex pendingMutex{};
+		std::vector<PendingGlyph> pendingUploads{};
+		std::vector<Core::JobHandle> rasterizations{};
+
+		struct CacheState{
+			std::uint64_t fontHash{};
+			std::size_t glyphCount{};
+		};
+
+		/** @brief by face name, what the on disk cache holds */
+		ext::string_hash_map<CacheState> cacheStates{};
+
 	public:
 		[[nodiscard]] FontManager() = default;
 
-		[[nodiscard]] explicit FontManager(Graphic::ImageAtlas& atlas, std::string_view fontPageName = "font");
+		[[nodiscard]] explicit FontManager(Graphic::ImageAtlas& atlas, std::string_view fontPageName = "font", Core::JobSystem* jobSystem = nullptr);
+
+		~FontManager();
+
+		FontManager(const FontManager& other) = delete;
+		FontManager(FontManager&& other) noexcept = delete;
+		FontManager& operator=(const FontManager& other) = delete;
+		FontManager& operator=(FontManager&& other) noexcept = delete;
+
+		/**
+		 * @brief thread safe, rasterizes the glyph in background and queues its bitmap for the next @link flushUploads @endlink
+		 */
+		void queueRasterization(IndexedFontFace& face, GlyphKey key, Glyph& glyph);
+
+		/**
+		 * @brief Uploads every rasterized glyph with one command buffer and assigns their views.
+		 *
+		 * Call it once per frame on the thread drawing text, views are not synchronized with the drawing.
+		 * @return count of the landed glyphs
+		 */
+		std::size_t flushUploads();
+
+		/**
+		 * @brief Restores the glyphs of every registered face from `<directory>/<face name>.glyphs` and uploads them in one command buffer.
+		 * @return count of the restored glyphs
+		 */
+		std::size_t loadCache(const Core::File& directory);
+
+		/**
+		 * @brief Writes the caches of the faces that rendered new glyphs since @link loadCache @endlink
+		 */
+		void saveCache(const Core::File& directory);
 
 		[[nodiscard]] std::string_view pageName() const noexcept{
 			return fontPageName;
@@ -97,7 +237,7 @@ export namespace Font{
 
 		[[nodiscard]] Glyph& getGlyph(std::string_view fontName, GlyphKey key);
 
-		FontFaceID registerFace(std::string_view keyName, std::string_view fontName);
+		FontFaceID registerFace(std::string_view keyName, std::string_view fontName, GlyphRenderMode mode = GlyphRenderMode::bitmap);
 
 		[[nodiscard]] auto& getPrimaryFontFace() noexcept{
 			assert(!fontFaces_fastAccess.empty());
@@ -41,6 +41,10 @@ export namespace Font::TypeSettings{
 			for (auto && glyph : row.glyphs){
 				if(!glyph.glyph->view)continue;
 				auto [imageIndex, sz, dataPtr] = batch.acquire(glyph.glyph->view, 1);
+				const TextureIndex texture{
+					.textureIndex = imageIndex,
+					.mode = glyph.glyph->isDistanceField() ? TextureMode::distanceField : TextureMode::color
+				};
 
 				tempColor = glyph.fontColor;
 
@@ -49,10 +53,10 @@ export namespace Font::TypeSettings{
 				}
 
 				new(dataPtr) std::array{
-					Vertex_UI{glyph.v00().add(lineOff), {imageIndex}, tempColor, glyph.glyph->v01},
-					Vertex_UI{glyph.v10().add(lineOff), {imageIndex}, tempColor, glyph.glyph->v11},
-					Vertex_UI{glyph.v11().add(lineOff), {imageIndex}, tempColor, glyph.glyph->v10},
-					Vertex_UI{glyph.v01().add(lineOff), {imageIndex}, tempColor, glyph.glyph->v00},
+					Vertex_UI{glyph.v00().add(lineOff), texture, tempColor, glyph.glyph->v01},
+					Vertex_UI{glyph.v10().add(lineOff), texture, tempColor, glyph.glyph->v11},
+					Vertex_UI{glyph.v11().add(lineOff), texture, tempColor, glyph.glyph->v10},
+					Vertex_UI{glyph.v01().add(lineOff), texture, tempColor, glyph.glyph->v00},
 				};
 
 				// Draw::Drawer<Core::Vulkan::Vertex_UI>::Line::rectOrtho(param, context.stroke, Geom::OrthoRectFloat{glyph.src, glyph.end}.move(lineOff), context.color);
@@ -128,6 +128,19 @@ namespace Font{
 			std::basic_string<CharCode> codes{};
 			using PosType = decltype(codes)::size_type;
 
+			/**
+			 * @brief Byte offset in the source string where the scan of each code begins, its tokens included.
+			 * The appended or replaced terminating code shares the offset of the string end.
+			 */
+			std::vector<std::uint32_t> codeOffsets{};
+
+			/**
+			 * @return byte offset after the code, @code npos@endcode for the terminating one as it is not read from the string
+			 */
+			[[nodiscard]] std::size_t codeEndOffset(const PosType pos) const noexcept{
+				return pos + 1 < codeOffsets.size() ? codeOffsets[pos + 1] : std::string_view::npos;
+			}
+
 			struct TokenArgument{
 				std::uint32_t pos{};
 				std::string_view data{};
@@ -257,23 +270,64 @@ namespace Font{
 				return offset;
 			}
 
+			/**
+			 * @brief whether parsing from either context gives the same layout, the pen state is not compared
+			 */
+			[[nodiscard]] bool sameSettings(const FormatContext& other) const noexcept{
+				return parseScale == other.parseScale
+					&& minimumLineHeight == other.minimumLineHeight
+					&& lineSpacing == other.lineSpacing
+					&& currentOffset == other.currentOffset
+					&& colorHistory.stack == other.colorHistory.stack
+					&& offsetHistory.stack == other.offsetHistory.stack
+					&& sizeHistory.stack == other.sizeHistory.stack
+					&& fontHistory.stack == other.fontHistory.stack;
+			}
+
 			[[nodiscard]] IndexedFontFace& getFace() const{
 				const auto t = fontHistory.top(GlobalFontManager->getPrimaryFontFace());
 				if(t == nullptr) throw std::runtime_error("No Valid Font Face");
 				return *t;
 			}
 
+			/**
+			 * @brief missing glyphs are laid out with their metrics and drawn once @link FontManager::flushUploads @endlink lands them
+			 */
 			[[nodiscard]] Glyph& getGlyph(const CharCode code) const{
-				return getFace().obtainGlyph({code, getLastSize()}, GlobalFontManager->getAtlas(), GlobalFontManager->getFontPage());
+				return getFace().requestGlyph({code, getLastSize()}, *GlobalFontManager);
+			}
+
+			/**
+			 * @brief scale of the glyphs from @link getGlyph @endlink to the current size, distance field faces share one glyph for all sizes
+			 */
+			[[nodiscard]] Geom::Vec2 getGlyphScale() const{
+				return getFace().scaleOf(getLastSize());
 			}
 		};
 
 		export struct GlyphLayout{
 			struct Row{
+				/**
+				 * @brief The state the row was opened with, parsing resumes from here when only later text is edited.
+				 * The context of the first row is the one the whole parse started with.
+				 */
+				struct Checkpoint{
+					FormatContext context{};
+					std::uint32_t codeIndex{};
+					std::uint32_t textOffset{};
+					/** @brief byte offset after the first code, the row before depends on it when it wrapped */
+					std::size_t firstCodeEnd{std::string::npos};
+					/** @brief a wrapped row reopens on a code whose tokens ran already */
+					bool tokensApplied{};
+				};
+
 				float baselineHeight{};
 				Geom::Vec2 src{};
 				GlyphRect bound{};
 				std::vector<GlyphElement> glyphs{};
+				Checkpoint checkpoint{};
+				/** @brief vertical src before the rows are moved down by the layout height, restored for kept rows */
+				float parsedSrcY{};
 
 				[[nodiscard]] Geom::OrthoRectFloat getRectBound() const noexcept{
 					return {src.x, src.y - bound.descender, bound.width, bound.height()};
@@ -292,6 +346,23 @@ namespace Font{
 			float drawScale{1.f};
 			bool isCompressed{};
 
+			/** @brief text before this byte offset is unchanged since the last parse */
+			std::size_t dirtyOffset{};
+
+			/**
+			 * @brief The last row opened on an unchanged code, rows before it are kept by the parser.
+			 * 0 means the whole text has to be parsed again.
+			 */
+			[[nodiscard]] std::size_t resumableRow() const noexcept{
+				if(elements.empty()) return 0;
+
+				const auto itr = std::ranges::partition_point(elements.begin() + 1, elements.end(), [this](const Row& row){
+					return row.checkpoint.firstCodeEnd <= dirtyOffset;
+				});
+
+				return static_cast<std::size_t>(std::ranges::distance(elements.begin(), itr) - 1);
+			}
+
 			[[nodiscard]] constexpr Geom::Vec2 getDrawSize() const noexcept{
 				return size.copy().scl(drawScale);
 			}
@@ -334,12 +405,14 @@ namespace Font{
 					std::ranges::for_each(elements, &std::vector<GlyphElement>::clear, &Row::glyphs);
 					maximumSize = size;
 					isCompressed = false;
+					dirtyOffset = 0;
 					return true;
 				}else{
 					if(maximumSize.equalsTo(size))return false;
 					std::ranges::for_each(elements, &std::vector<GlyphElement>::clear, &Row::glyphs);
 					maximumSize = size;
 					isCompressed = false;
+					dirtyOffset = 0;
 					return true;
 				}
 			}
@@ -348,13 +421,20 @@ namespace Font{
 			void reset(std::string&& newText, const Geom::Vec2 size){
 				if constexpr (multiThread){
 					std::unique_lock lk{capture};
-					resetSize<false>(size);
-					text = std::move(newText);
+					resetText(std::move(newText), size);
 				}else{
-					resetSize<false>(size);
-					text = std::move(newText);
+					resetText(std::move(newText), size);
 				}
 			}
+
+		private:
+			void resetText(std::string&& newText, const Geom::Vec2 size){
+				resetSize<false>(size);
+
+				const auto unchanged = std::ranges::mismatch(text, newText).in1 - text.begin();
+				dirtyOffset = std::min(dirtyOffset, static_cast<std::size_t>(unchanged));
+				text = std::move(newText);
+			}
 		};
 
 		export struct TokenModifier{
@@ -557,7 +637,7 @@ namespace Font{
 			}
 
 			void beginParse(FormatContext& context, const std::shared_ptr<GlyphLayout>& target){
-				target->elements.emplace_back();
+				target->elements.emplace_back().checkpoint.context = context;
 				context.heightRemain = target->maximumSize.y;
 			}
 
@@ -572,6 +652,7 @@ namespace Font{
 
 				if(!(target->align & Align::Pos::left)) target->updateAlign();
 				for(auto&& element : target->elements){
+					element.parsedSrcY = element.src.y;
 					element.src.y += target->size.y;
 				}
 			}
@@ -759,6 +840,7 @@ Font::TypeSettings::FormattableText::FormattableText(const std::string_view stri
 	const auto size = string.size();
 
 	codes.reserve(string.size() + 1);
+	codeOffsets.reserve(string.size() + 1);
 
 	enum struct TokenState{
 		waiting,
@@ -767,6 +849,7 @@ Font::TypeSettings::FormattableText::FormattableText(const std::string_view stri
 	};
 
 	bool escapingNext{};
+	std::uint32_t scanBegin{};
 	TokenState recordingToken{};
 	decltype(string)::size_type tokenRegionBegin{InvalidPos};
 	TokenArgument* currentToken{};
@@ -837,6 +920,8 @@ Font::TypeSettings::FormattableText::FormattableText(const std::string_view stri
 			}
 
 			codes.push_back(charCode);
+			codeOffsets.push_back(scanBegin);
+			scanBegin = static_cast<std::uint32_t>(off + codeSize);
 		} else{
 			escapingNext = false;
 		}
@@ -850,25 +935,58 @@ Font::TypeSettings::FormattableText::FormattableText(const std::string_view stri
 		codes.back() = '\0';
 	} else{
 		codes.push_back(U'\0');
+		codeOffsets.push_back(scanBegin);
 		rows++;
 	}
 
 	codes.shrink_to_fit();
+	codeOffsets.shrink_to_fit();
 }
 
 void Font::TypeSettings::Parser::parse(FormatContext& context, const std::shared_ptr<GlyphLayout>& target) const{
-	target->elements.clear();
+	std::unique_lock lk{target->capture};
+
+	//rows before the first one touching the edited text are kept, the rest is parsed from its checkpoint
+	std::size_t resumeRow = target->resumableRow();
+	if(resumeRow && !context.sameSettings(target->elements.front().checkpoint.context)){
+		resumeRow = 0;
+	}
+
+	std::uint32_t baseIndex{};
+	std::uint32_t baseOffset{};
+	bool leadingTokensApplied{};
+
+	if(resumeRow){
+		auto& [resumeContext, codeIndex, textOffset, firstCodeEnd, tokensApplied] = target->elements[resumeRow].checkpoint;
+		context = std::move(resumeContext);
+		baseIndex = codeIndex;
+		baseOffset = textOffset;
+		leadingTokensApplied = tokensApplied;
+
+		target->elements.resize(resumeRow);
+		for(auto& row : target->elements){
+			row.src.y = row.parsedSrcY;
+		}
+	}else{
+		target->elements.clear();
+	}
+
 	target->size = {};
+	target->isCompressed = false;
+	target->dirtyOffset = std::string::npos;
 
-	FormattableText formattableText{target->text, {}};
+	FormattableText formattableText{std::string_view{target->text}.substr(baseOffset), {}};
 
-	std::unique_lock lk{target->capture};
-	target->elements.reserve(formattableText.rows + 16);
+	target->elements.reserve(resumeRow + formattableText.rows + 16);
 
 	FormattableText::TokenItr lastTokenItr = formattableText.tokens.begin();
-	std::uint32_t currentRow{};
+	if(leadingTokensApplied){
+		lastTokenItr = formattableText.getTokenGroup(0, lastTokenItr).end();
+	}
+
+	std::uint32_t currentRow{static_cast<std::uint32_t>(resumeRow)};
 
-	Func::beginParse(context, target);
+	if(!resumeRow) Func::beginParse(context, target);
 
 	auto view = formattableText.codes | std::views::enumerate;
 
@@ -882,23 +1000,46 @@ void Font::TypeSettings::Parser::parse(FormatContext& context, const std::shared
 		}
 	};
 
+	//a wrapped code is visited twice, its tokens only run on the first visit
+	std::optional<std::ptrdiff_t> tokensRunAt{};
+	if(leadingTokensApplied) tokensRunAt = 0;
+
 	for(auto itr = view.begin(); itr != view.end(); ++itr){
-		auto [index, code] = *itr;
+		auto [localIndex, code] = *itr;
+		const auto index = baseIndex + static_cast<std::uint32_t>(localIndex);
+
+		std::optional<GlyphLayout::Row::Checkpoint> checkpoint{};
+		if(currentRow >= target->elements.size()){
+			const auto codeEnd = formattableText.codeEndOffset(localIndex);
+
+			checkpoint = GlyphLayout::Row::Checkpoint{
+				.context = context,
+				.codeIndex = index,
+				.textOffset = baseOffset + formattableText.codeOffsets[localIndex],
+				.firstCodeEnd = codeEnd == std::string_view::npos ? std::string::npos : baseOffset + codeEnd,
+				.tokensApplied = tokensRunAt == localIndex
+			};
+		}
 
-		Func::execTokens(*this, lastTokenItr, formattableText, index, context, target);
+		Func::execTokens(*this, lastTokenItr, formattableText, localIndex, context, target);
+		tokensRunAt = localIndex;
 
 		auto& line = Func::getCurrentRow(currentRow, context, target);
+		if(checkpoint) line.checkpoint = std::move(*checkpoint);
+
 		const auto linePos = line.glyphs.size();
 
 		const Glyph& glyph = context.getGlyph(code);
+		const Geom::Vec2 glyphScale = context.getGlyphScale();
+		const GlyphMetrics metrics = GlyphMetrics{glyph.metrics}.scl(glyphScale);
 
-		if(glyph.metrics.size.y > context.heightRemain){
+		if(metrics.size.y > context.heightRemain){
 			endline();
 			target->isCompressed = true;
 			break;
 		}
 
-		if(context.lineRect.width + (glyph.metrics.advance.x) > target->maximumSize.x){
+		if(context.lineRect.width + (metrics.advance.x) > target->maximumSize.x){
 			if(code != U'\n') --itr;
 			if(!endline()) break;
 			continue;
@@ -909,7 +1050,14 @@ void Font::TypeSettings::Parser::parse(FormatContext& context, const std::shared
 
 		const Geom::Vec2 localPos = context.penPos - line.src + context.getCurrentOffset();
 
-		auto [src, end] = glyph.metrics.placeTo(localPos);
+		auto [src, end] = metrics.placeTo(localPos);
+
+		//the quad covers the distance field border, the line bound does not
+		if(glyph.isDistanceField()){
+			const Geom::Vec2 border = glyphScale * glyph.spread;
+			src -= border;
+			end += border;
+		}
 
 		current.code = code;
 		current.src = src;
@@ -918,11 +1066,11 @@ void Font::TypeSettings::Parser::parse(FormatContext& context, const std::shared
 		current.index = index;
 		current.layoutPos = TextLayoutPos{static_cast<unsigned short>(currentRow), static_cast<unsigned short>(linePos)};
 
-		context.lineRect.width += glyph.metrics.advance.x;
-		context.lineRect.ascender = Math::max(context.lineRect.ascender, glyph.metrics.ascender());
-		context.lineRect.descender = Math::max(context.lineRect.descender, glyph.metrics.descender());
+		context.lineRect.width += metrics.advance.x;
+		context.lineRect.ascender = Math::max(context.lineRect.ascender, metrics.ascender());
+		context.lineRect.descender = Math::max(context.lineRect.descender, metrics.descender());
 
-		context.penPos.addX(glyph.metrics.advance.x);
+		context.penPos.addX(metrics.advance.x);
 
 		if(code == U'\n' || code == 0){
 			if(!endline()) break;
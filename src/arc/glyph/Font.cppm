@@ -8,6 +8,7 @@ module;
 #include <ft2build.h>
 #include <freetype/freetype.h>
 #include <freetype/ftstroke.h>
+#include <freetype/ftmodapi.h>
 
 #include "../src/ext/enum_operator_gen.hpp"
 
@@ -62,6 +63,21 @@ namespace Font{
 
 	export using FontFaceID = std::uint32_t;
 
+	export enum struct GlyphRenderMode : std::uint8_t{
+		/** @brief a coverage bitmap rendered for every size */
+		bitmap,
+		/**
+		 * @brief a signed distance field rendered once at @link DistanceFieldSize @endlink,
+		 * other sizes reuse it by scaling the quad and the shader rebuilds the edge
+		 */
+		distanceField,
+	};
+
+	export constexpr GlyphSizeType DistanceFieldSize{0, 64};
+
+	/** @brief pixels of distance stored around the outline at @link DistanceFieldSize @endlink */
+	export constexpr int DistanceFieldSpread{8};
+
 	export struct GlyphKey{
 		CharCode code{};
 		GlyphSizeType size{};
@@ -99,6 +115,14 @@ namespace Font{
 			advance.y = normalizeLen<float>(metrics.vertAdvance);
 		}
 
+		GlyphMetrics& scl(const Geom::Vec2 scale) noexcept{
+			size *= scale;
+			horiBearing *= scale;
+			vertBearing *= scale;
+			advance *= scale;
+			return *this;
+		}
+
 		[[nodiscard]] float ascender() const noexcept{
 			return horiBearing.y;
 		}
@@ -296,6 +320,7 @@ namespace Font{
 	public:
 		FontFaceStorage* fallback{};
 		FontFace_Internal face{};
+		GlyphRenderMode renderMode{};
 
 		//OPTM flat it?
 		std::unordered_map<CharCode, std::unordered_map<GlyphSizeType, BitmapGlyph>> glyphs{};
@@ -332,21 +357,28 @@ namespace Font{
 			{
 				std::unique_lock readLock{readMutex};
 
+				//another thread may have loaded it between the locks, its glyph is referenced already and must stay
+				auto& sizedGlyphs = glyphs[code];
+				if(const auto sized = sizedGlyphs.find(size); sized != sizedGlyphs.end()){
+					return sized->second;
+				}
+
 				if(size != lastSize){
 					face.setSize(size.x, size.y);
 				}
 
 				if(const auto itr = emptyFontGlyphGenerators.find(code); itr != emptyFontGlyphGenerators.end()){
 					if(auto rst = face.loadAndGet(itr->second.referenceCode)){
-						return glyphs[code].insert_or_assign(size, BitmapGlyph{code, rst.value()->metrics, itr->second.scale}).first->second;
+						return sizedGlyphs.try_emplace(size, code, rst.value()->metrics, itr->second.scale).first->second;
 					}else{
 						error = rst.error();
 					}
 				}else{
 					if(auto rst = face.loadAndGet(code)){
 						//TODO better render process
-						FT_Render_Glyph(rst.value(), FT_RENDER_MODE_NORMAL);
-						return glyphs[code].insert_or_assign(size, BitmapGlyph{code, rst.value()}).first->second;
+						//the grid fitted metrics bound the distance field as well, its bitmap only adds the spread around
+						FT_Render_Glyph(rst.value(), renderMode == GlyphRenderMode::distanceField ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL);
+						return sizedGlyphs.try_emplace(size, code, rst.value()).first->second;
 					}else{
 						error = rst.error();
 					}
@@ -360,6 +392,86 @@ namespace Font{
 			std::unreachable();
 		}
 
+		/**
+		 * @brief Loads the outline without rendering it, the metrics are the ones @link tryLoad @endlink gives later.
+		 */
+		[[nodiscard]] FT_Glyph_Metrics loadMetrics(const CharCode code, const GlyphSizeType size){
+			assert((size.x != 0 || size.y != 0) && "must at least one none zero");
+
+			{
+				std::shared_lock readLock{readMutex};
+				if(const auto itr = glyphs.find(code); itr != glyphs.end()){
+					if(const auto sized = itr->second.find(size); sized != itr->second.end()){
+						return sized->second.metrics;
+					}
+				}
+			}
+
+			//nothing to render for these
+			if(emptyFontGlyphGenerators.contains(code)){
+				return tryLoad(code, size).metrics;
+			}
+
+			FT_Error error;
+
+			{
+				std::unique_lock readLock{readMutex};
+
+				//another thread may have loaded it between the locks
+				if(const auto itr = glyphs.find(code); itr != glyphs.end()){
+					if(const auto sized = itr->second.find(size); sized != itr->second.end()){
+						return sized->second.metrics;
+					}
+				}
+
+				if(size != lastSize){
+					face.setSize(size.x, size.y);
+				}
+
+				if(auto rst = face.loadAndGet(code)){
+					return rst.value()->metrics;
+				}else{
+					error = rst.error();
+				}
+			}
+
+			if(fallback)return fallback->loadMetrics(code, size);
+			check(error);
+
+			std::unreachable();
+		}
+
+		/**
+		 * @brief thread safe, adds a glyph rendered elsewhere, an already loaded one is kept
+		 */
+		const BitmapGlyph& store(const GlyphSizeType size, BitmapGlyph&& glyph){
+			std::unique_lock lk{readMutex};
+			return glyphs[glyph.code].try_emplace(size, std::move(glyph)).first->second;
+		}
+
+		/**
+		 * @brief thread safe, glyphs are never erased so references taken in the visitor stay valid
+		 */
+		template <std::invocable<GlyphSizeType, const BitmapGlyph&> Visitor>
+		void visitGlyphs(Visitor visitor){
+			std::shared_lock lk{readMutex};
+			for(const auto& sized : glyphs | std::views::values){
+				for(const auto& [size, glyph] : sized){
+					std::invoke(visitor, size, glyph);
+				}
+			}
+		}
+
+		[[nodiscard]] std::size_t glyphCount(){
+			std::shared_lock lk{readMutex};
+			std::size_t count{};
+			for(const auto& sized : glyphs | std::views::values){
+				count += sized.size();
+			}
+
+			return count;
+		}
+
 		[[nodiscard]] std::string toString(const CharCode code, const GlyphSizeType size) const{
 			return std::format("{}.{}.{}[{},{}]", face.getFamilyName(), face.getStyleName(), reinterpret_cast<const int&>(code), size.x, size.y);
 		}
@@ -407,6 +519,10 @@ module : private;
 
 Font::Library::Library(){
 	check(FT_Init_FreeType(&library));
+
+	//the sdf renderer works on outlines, bsdf on bitmaps, both keep the same border
+	check(FT_Property_Set(library, "sdf", "spread", &DistanceFieldSpread));
+	check(FT_Property_Set(library, "bsdf", "spread", &DistanceFieldSpread));
 }
 
 Font::Library::~Library(){
@@ -0,0 +1,563 @@
+export module Graphic.BlockCompression;
+
+import Graphic.Pixmap;
+import Geom.Vector2D;
+import std;
+
+export namespace Graphic{
+	/**
+	 * @brief GPU block formats of 4x4 texel blocks the CPU encoders write
+	 */
+	enum struct BlockFormat : std::uint8_t{
+		/** @brief one channel in 8 bytes a block, sampled as red only, e.g. glyph coverage */
+		bc4,
+		/** @brief RGBA in 16 bytes a block */
+		bc7,
+	};
+
+	constexpr std::uint32_t BlockExtent{4};
+
+	[[nodiscard]] constexpr std::size_t blockBytes(const BlockFormat format) noexcept{
+		return format == BlockFormat::bc4 ? 8 : 16;
+	}
+
+	[[nodiscard]] constexpr Geom::USize2 mipExtent(const Geom::USize2 size, const std::uint32_t level) noexcept{
+		return {std::max(size.x >> level, 1u), std::max(size.y >> level, 1u)};
+	}
+
+	[[nodiscard]] constexpr std::size_t levelSizeBytes(const BlockFormat format, const Geom::USize2 size) noexcept{
+		return std::size_t{(size.x + BlockExtent - 1) / BlockExtent} * ((size.y + BlockExtent - 1) / BlockExtent) * blockBytes(format);
+	}
+
+	/**
+	 * @brief the same level count the runtime mipmap generation uses, the smallest levels are left out
+	 */
+	[[nodiscard]] inline std::uint32_t mipLevelsOf(const Geom::USize2 size){
+		const auto logRst = std::log2(std::max(size.x, size.y));
+		return std::min(static_cast<std::uint32_t>(std::floor(std::max(0., logRst - 2))) + 1, 10u);
+	}
+
+	/**
+	 * @brief Block compressed levels laid out one after another from the largest, without owning them.
+	 */
+	struct CompressedView{
+		BlockFormat format{};
+		Geom::USize2 size{};
+		std::uint32_t mipLevels{};
+		std::span<const std::byte> data{};
+
+		[[nodiscard]] static constexpr std::size_t sizeBytes(const BlockFormat format, const Geom::USize2 size, const std::uint32_t mipLevels) noexcept{
+			std::size_t total{};
+			for(std::uint32_t level = 0; level < mipLevels; ++level){
+				total += levelSizeBytes(format, mipExtent(size, level));
+			}
+			return total;
+		}
+
+		[[nodiscard]] std::span<const std::byte> level(const std::uint32_t index) const noexcept{
+			return data.subspan(sizeBytes(format, size, index), levelSizeBytes(format, mipExtent(size, index)));
+		}
+	};
+
+	struct CompressedImage{
+		BlockFormat format{};
+		Geom::USize2 size{};
+		std::uint32_t mipLevels{};
+		std::vector<std::byte> data{};
+
+		[[nodiscard]] CompressedView view() const noexcept{
+			return {format, size, mipLevels, data};
+		}
+	};
+
+	/**
+	 * @brief box filtered half size, a side of one texel stays one texel
+	 */
+	[[nodiscard]] Pixmap downsample(const Pixmap& pixmap);
+
+	/**
+	 * @param channel of the RGBA texels encoded, the alpha by default
+	 */
+	void encodeBC4(const Pixmap& pixmap, std::span<std::byte> dst, std::uint32_t channel = 3);
+
+	/**
+	 * @brief Encodes with the single subset mode 6 only, fast and fine for smooth sprites, noisy blocks of several colors lose detail.
+	 */
+	void encodeBC7(const Pixmap& pixmap, std::span<std::byte> dst);
+
+	/**
+	 * @brief encodes the pixmap and its box filtered levels down to `mipLevels`
+	 */
+	[[nodiscard]] CompressedImage compress(const Pixmap& pixmap, BlockFormat format, std::uint32_t mipLevels);
+
+	/**
+	 * @brief Decodes the first level back to RGBA for devices that cannot sample the block format.
+	 * bc4 decodes to white with the channel as alpha, the way its view is swizzled; bc7 decodes the mode the encoder writes only.
+	 */
+	[[nodiscard]] Pixmap decompress(const CompressedView& compressed);
+}
+
+module : private;
+
+namespace Graphic{
+	using Block = std::array<std::array<std::uint8_t, 4>, 16>;
+
+	/**
+	 * @brief the texels out of the pixmap are clamped to its edge
+	 */
+	Block fetchBlock(const Pixmap& pixmap, const std::uint32_t bx, const std::uint32_t by){
+		Block block{};
+		const auto* data = pixmap.data();
+
+		for(std::uint32_t i = 0; i < 16; ++i){
+			const std::uint32_t x = std::min(bx * BlockExtent + i % BlockExtent, pixmap.getWidth() - 1);
+			const std::uint32_t y = std::min(by * BlockExtent + i / BlockExtent, pixmap.getHeight() - 1);
+
+			std::memcpy(block[i].data(), data + (std::size_t{y} * pixmap.getWidth() + x) * Pixmap::Channels, Pixmap::Channels);
+		}
+
+		return block;
+	}
+
+	class BitWriter{
+		std::array<std::uint64_t, 2> bits{};
+		std::uint32_t position{};
+
+	public:
+		void push(const std::uint64_t value, const std::uint32_t count) noexcept{
+			for(std::uint32_t i = 0; i < count; ++i){
+				bits[(position + i) / 64] |= (value >> i & 1) << (position + i) % 64;
+			}
+			position += count;
+		}
+
+		void write(std::span<std::byte> dst) const noexcept{
+			std::memcpy(dst.data(), bits.data(), dst.size());
+		}
+	};
+
+	void encodeBC4Block(const Block& block, const std::uint32_t channel, std::span<std::byte> dst){
+		std::array<int, 16> values{};
+		for(std::uint32_t i = 0; i < 16; ++i) values[i] = block[i][channel];
+
+		const auto [minItr, maxItr] = std::ranges::minmax_element(values);
+
+		struct Candidate{
+			int r0{};
+			int r1{};
+			std::array<int, 8> palette{};
+			std::array<std::uint8_t, 16> indices{};
+			int error{};
+		};
+
+		const auto evaluate = [&](Candidate& candidate){
+			for(std::uint32_t i = 0; i < 16; ++i){
+				int best = std::numeric_limits<int>::max();
+				for(std::uint8_t k = 0; k < 8; ++k){
+					const int diff = candidate.palette[k] - values[i];
+					if(diff * diff < best){
+						best = diff * diff;
+						candidate.indices[i] = k;
+					}
+				}
+				candidate.error += best;
+			}
+		};
+
+		//eight interpolated values between the extremes
+		Candidate full{*maxItr, *minItr};
+		full.palette = {full.r0, full.r1};
+		for(int k = 2; k < 8; ++k){
+			full.palette[k] = ((8 - k) * full.r0 + (k - 1) * full.r1 + 3) / 7;
+		}
+		evaluate(full);
+
+		//six between the inner values plus exact 0 and 255, suits coverage with transparent and opaque texels
+		int innerMin = 255, innerMax = 0;
+		for(const int value : values){
+			if(value == 0 || value == 255) continue;
+			innerMin = std::min(innerMin, value);
+			innerMax = std::max(innerMax, value);
+		}
+		if(innerMin > innerMax) innerMin = innerMax = 0;
+
+		Candidate bounded{innerMin, innerMax};
+		bounded.palette = {bounded.r0, bounded.r1};
+		for(int k = 2; k < 6; ++k){
+			bounded.palette[k] = ((6 - k) * bounded.r0 + (k - 1) * bounded.r1 + 2) / 5;
+		}
+		bounded.palette[6] = 0;
+		bounded.palette[7] = 255;
+		evaluate(bounded);
+
+		//the first mode needs r0 > r1, the second r0 <= r1
+		const Candidate& best = full.r0 > full.r1 && full.error <= bounded.error ? full : bounded;
+
+		BitWriter writer{};
+		writer.push(best.r0, 8);
+		writer.push(best.r1, 8);
+		for(const std::uint8_t index : best.indices) writer.push(index, 3);
+		writer.write(dst);
+	}
+
+	constexpr std::array<int, 16> BC7Weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+	struct BC7Endpoints{
+		std::array<std::array<float, 4>, 2> colors{};
+	};
+
+	struct BC7Encoding{
+		std::array<std::array<int, 4>, 2> quantized{};
+		std::array<int, 2> pBits{};
+		std::array<std::uint8_t, 16> indices{};
+		float error{std::numeric_limits<float>::max()};
+	};
+
+	/**
+	 * @brief quantizes the endpoints with the best shared bits and picks the indices along the line
+	 */
+	BC7Encoding fitBC7(const Block& block, const BC7Endpoints& endpoints){
+		BC7Encoding best{};
+
+		for(int p = 0; p < 4; ++p){
+			BC7Encoding encoding{};
+			encoding.pBits = {p & 1, p >> 1};
+			encoding.error = 0;
+
+			std::array<std::array<int, 4>, 2> decoded{};
+			for(int e = 0; e < 2; ++e){
+				for(int c = 0; c < 4; ++c){
+					const int q = std::clamp(static_cast<int>(std::lround((endpoints.colors[e][c] - static_cast<float>(encoding.pBits[e])) / 2.f)), 0, 127);
+					encoding.quantized[e][c] = q;
+					decoded[e][c] = q << 1 | encoding.pBits[e];
+				}
+			}
+
+			std::array<std::array<int, 4>, 16> palette{};
+			for(int k = 0; k < 16; ++k){
+				for(int c = 0; c < 4; ++c){
+					palette[k][c] = ((64 - BC7Weights[k]) * decoded[0][c] + BC7Weights[k] * decoded[1][c] + 32) >> 6;
+				}
+			}
+
+			std::array<float, 4> axis{};
+			float axisLength{};
+			for(int c = 0; c < 4; ++c){
+				axis[c] = static_cast<float>(decoded[1][c] - decoded[0][c]);
+				axisLength += axis[c] * axis[c];
+			}
+
+			for(std::uint32_t i = 0; i < 16; ++i){
+				float t{};
+				if(axisLength > 0){
+					for(int c = 0; c < 4; ++c) t += (static_cast<float>(block[i][c]) - static_cast<float>(decoded[0][c])) * axis[c];
+					t /= axisLength;
+				}
+
+				//the nearest index by projection and its neighbours, the weights are not evenly spaced
+				const int guess = std::clamp(static_cast<int>(std::lround(t * 15.f)), 0, 15);
+
+				int bestError = std::numeric_limits<int>::max();
+				for(int k = std::max(guess - 1, 0); k <= std::min(guess + 1, 15); ++k){
+					int error{};
+					for(int c = 0; c < 4; ++c){
+						const int diff = palette[k][c] - block[i][c];
+						error += diff * diff;
+					}
+
+					if(error < bestError){
+						bestError = error;
+						encoding.indices[i] = static_cast<std::uint8_t>(k);
+					}
+				}
+
+				encoding.error += static_cast<float>(bestError);
+			}
+
+			if(encoding.error < best.error) best = encoding;
+		}
+
+		return best;
+	}
+
+	void encodeBC7Block(const Block& block, std::span<std::byte> dst){
+		std::array<float, 4> mean{};
+		for(const auto& texel : block){
+			for(int c = 0; c < 4; ++c) mean[c] += texel[c];
+		}
+		for(float& m : mean) m /= 16.f;
+
+		std::array<std::array<float, 4>, 4> covariance{};
+		for(const auto& texel : block){
+			for(int r = 0; r < 4; ++r){
+				for(int c = 0; c < 4; ++c){
+					covariance[r][c] += (texel[r] - mean[r]) * (texel[c] - mean[c]);
+				}
+			}
+		}
+
+		//principal axis by power iteration
+		std::array<float, 4> axis{1, 1, 1, 1};
+		for(int iteration = 0; iteration < 8; ++iteration){
+			std::array<float, 4> next{};
+			for(int r = 0; r < 4; ++r){
+				for(int c = 0; c < 4; ++c) next[r] += covariance[r][c] * axis[c];
+			}
+
+			const float length = std::sqrt(std::ranges::fold_left(next, 0.f, [](const float sum, const float v){ return sum + v * v; }));
+			if(length < 1e-6f) break;
+			for(int c = 0; c < 4; ++c) axis[c] = next[c] / length;
+		}
+
+		float tMin = std::numeric_limits<float>::max(), tMax = std::numeric_limits<float>::lowest();
+		for(const auto& texel : block){
+			float t{};
+			for(int c = 0; c < 4; ++c) t += (texel[c] - mean[c]) * axis[c];
+			tMin = std::min(tMin, t);
+			tMax = std::max(tMax, t);
+		}
+
+		BC7Endpoints endpoints{};
+		for(int c = 0; c < 4; ++c){
+			endpoints.colors[0][c] = std::clamp(mean[c] + axis[c] * tMin, 0.f, 255.f);
+			endpoints.colors[1][c] = std::clamp(mean[c] + axis[c] * tMax, 0.f, 255.f);
+		}
+
+		BC7Encoding encoding = fitBC7(block, endpoints);
+
+		//least squares endpoints for the chosen indices, kept if they do better
+		{
+			float a{}, b{}, d{};
+			std::array<float, 4> x0{}, x1{};
+
+			for(std::uint32_t i = 0; i < 16; ++i){
+				const float w = static_cast<float>(BC7Weights[encoding.indices[i]]) / 64.f;
+				a += (1 - w) * (1 - w);
+				b += (1 - w) * w;
+				d += w * w;
+
+				for(int c = 0; c < 4; ++c){
+					x0[c] += (1 - w) * block[i][c];
+					x1[c] += w * block[i][c];
+				}
+			}
+
+			if(const float det = a * d - b * b; std::abs(det) > 1e-6f){
+				BC7Endpoints refined{};
+				for(int c = 0; c < 4; ++c){
+					refined.colors[0][c] = std::clamp((d * x0[c] - b * x1[c]) / det, 0.f, 255.f);
+					refined.colors[1][c] = std::clamp((a * x1[c] - b * x0[c]) / det, 0.f, 255.f);
+				}
+
+				if(const BC7Encoding second = fitBC7(block, refined); second.error < encoding.error){
+					encoding = second;
+				}
+			}
+		}
+
+		//the most significant bit of the first index is implied zero
+		if(encoding.indices[0] & 8){
+			std::swap(encoding.quantized[0], encoding.quantized[1]);
+			std::swap(encoding.pBits[0], encoding.pBits[1]);
+			for(auto& index : encoding.indices) index = 15 - index;
+		}
+
+		BitWriter writer{};
+		writer.push(1 << 6, 7);
+		for(int c = 0; c < 4; ++c){
+			writer.push(encoding.quantized[0][c], 7);
+			writer.push(encoding.quantized[1][c], 7);
+		}
+		writer.push(encoding.pBits[0], 1);
+		writer.push(encoding.pBits[1], 1);
+
+		writer.push(encoding.indices[0], 3);
+		for(std::uint32_t i = 1; i < 16; ++i) writer.push(encoding.indices[i], 4);
+
+		writer.write(dst);
+	}
+
+	class BitReader{
+		std::array<std::uint64_t, 2> bits{};
+		std::uint32_t position{};
+
+	public:
+		explicit BitReader(const std::span<const std::byte> src) noexcept{
+			std::memcpy(bits.data(), src.data(), std::min(src.size(), sizeof(bits)));
+		}
+
+		[[nodiscard]] std::uint32_t pull(const std::uint32_t count) noexcept{
+			std::uint32_t value{};
+			for(std::uint32_t i = 0; i < count; ++i){
+				value |= static_cast<std::uint32_t>(bits[(position + i) / 64] >> (position + i) % 64 & 1) << i;
+			}
+			position += count;
+			return value;
+		}
+	};
+
+	/**
+	 * @brief the palette the encoder picks indices from, both modes
+	 */
+	void decodeBC4Block(const std::span<const std::byte> src, Block& block){
+		BitReader reader{src};
+		const int r0 = static_cast<int>(reader.pull(8));
+		const int r1 = static_cast<int>(reader.pull(8));
+
+		std::array<int, 8> palette{r0, r1};
+		if(r0 > r1){
+			for(int k = 2; k < 8; ++k) palette[k] = ((8 - k) * r0 + (k - 1) * r1 + 3) / 7;
+		}else{
+			for(int k = 2; k < 6; ++k) palette[k] = ((6 - k) * r0 + (k - 1) * r1 + 2) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		for(auto& texel : block){
+			texel = {255, 255, 255, static_cast<std::uint8_t>(palette[reader.pull(3)])};
+		}
+	}
+
+	void decodeBC7Block(const std::span<const std::byte> src, Block& block){
+		BitReader reader{src};
+
+		if(reader.pull(7) != 1 << 6){
+			throw std::invalid_argument("Only BC7 mode 6 blocks can be decoded");
+		}
+
+		std::array<std::array<int, 4>, 2> decoded{};
+		for(int c = 0; c < 4; ++c){
+			decoded[0][c] = static_cast<int>(reader.pull(7)) << 1;
+			decoded[1][c] = static_cast<int>(reader.pull(7)) << 1;
+		}
+
+		const int p0 = static_cast<int>(reader.pull(1));
+		const int p1 = static_cast<int>(reader.pull(1));
+		for(int c = 0; c < 4; ++c){
+			decoded[0][c] |= p0;
+			decoded[1][c] |= p1;
+		}
+
+		for(std::uint32_t i = 0; i < 16; ++i){
+			const int weight = BC7Weights[reader.pull(i == 0 ? 3 : 4)];
+			for(int c = 0; c < 4; ++c){
+				block[i][c] = static_cast<std::uint8_t>(((64 - weight) * decoded[0][c] + weight * decoded[1][c] + 32) >> 6);
+			}
+		}
+	}
+
+	template <std::invocable<const Block&, std::span<std::byte>> Encoder>
+	void encodeBlocks(const Pixmap& pixmap, const std::span<std::byte> dst, const BlockFormat format, Encoder encoder){
+		const std::uint32_t blocksX = (pixmap.getWidth() + BlockExtent - 1) / BlockExtent;
+		const std::uint32_t blocksY = (pixmap.getHeight() + BlockExtent - 1) / BlockExtent;
+
+		if(dst.size() < levelSizeBytes(format, pixmap.size2D())){
+			throw std::invalid_argument("Insufficient block compression output size");
+		}
+
+		for(std::uint32_t by = 0; by < blocksY; ++by){
+			for(std::uint32_t bx = 0; bx < blocksX; ++bx){
+				encoder(fetchBlock(pixmap, bx, by), dst.subspan((std::size_t{by} * blocksX + bx) * blockBytes(format), blockBytes(format)));
+			}
+		}
+	}
+}
+
+Graphic::Pixmap Graphic::downsample(const Pixmap& pixmap){
+	const Geom::USize2 size = mipExtent(pixmap.size2D(), 1);
+	Pixmap result{size.x, size.y};
+
+	const auto* src = pixmap.data();
+	auto* dst = result.data();
+
+	for(std::uint32_t y = 0; y < size.y; ++y){
+		const std::uint32_t y0 = std::min(y * 2, pixmap.getHeight() - 1);
+		const std::uint32_t y1 = std::min(y * 2 + 1, pixmap.getHeight() - 1);
+
+		for(std::uint32_t x = 0; x < size.x; ++x){
+			const std::uint32_t x0 = std::min(x * 2, pixmap.getWidth() - 1);
+			const std::uint32_t x1 = std::min(x * 2 + 1, pixmap.getWidth() - 1);
+
+			for(std::uint32_t c = 0; c < Pixmap::Channels; ++c){
+				const auto at = [&](const std::uint32_t sx, const std::uint32_t sy){
+					return static_cast<std::uint32_t>(src[(std::size_t{sy} * pixmap.getWidth() + sx) * Pixmap::Channels + c]);
+				};
+
+				dst[(std::size_t{y} * size.x + x) * Pixmap::Channels + c] =
+					static_cast<Pixmap::DataType>((at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1) + 2) / 4);
+			}
+		}
+	}
+
+	return result;
+}
+
+void Graphic::encodeBC4(const Pixmap& pixmap, const std::span<std::byte> dst, const std::uint32_t channel){
+	encodeBlocks(pixmap, dst, BlockFormat::bc4, [channel](const Block& block, const std::span<std::byte> out){
+		encodeBC4Block(block, channel, out);
+	});
+}
+
+void Graphic::encodeBC7(const Pixmap& pixmap, const std::span<std::byte> dst){
+	encodeBlocks(pixmap, dst, BlockFormat::bc7, encodeBC7Block);
+}
+
+Graphic::CompressedImage Graphic::compress(const Pixmap& pixmap, const BlockFormat format, const std::uint32_t mipLevels){
+	CompressedImage image{format, pixmap.size2D(), mipLevels};
+	image.data.resize(CompressedView::sizeBytes(format, image.size, mipLevels));
+
+	Pixmap level{};
+	const Pixmap* current = &pixmap;
+
+	for(std::uint32_t index = 0; index < mipLevels; ++index){
+		if(index > 0){
+			level = downsample(*current);
+			current = &level;
+		}
+
+		const auto dst = std::span{image.data}.subspan(CompressedView::sizeBytes(format, image.size, index), levelSizeBytes(format, current->size2D()));
+
+		if(format == BlockFormat::bc4){
+			encodeBC4(*current, dst);
+		}else{
+			encodeBC7(*current, dst);
+		}
+	}
+
+	return image;
+}
+
+Graphic::Pixmap Graphic::decompress(const CompressedView& compressed){
+	const std::span<const std::byte> src = compressed.level(0);
+	const std::size_t bytes = blockBytes(compressed.format);
+
+	const std::uint32_t blocksX = (compressed.size.x + BlockExtent - 1) / BlockExtent;
+	const std::uint32_t blocksY = (compressed.size.y + BlockExtent - 1) / BlockExtent;
+
+	Pixmap pixmap{compressed.size.x, compressed.size.y};
+	auto* dst = pixmap.data();
+
+	Block block{};
+	for(std::uint32_t by = 0; by < blocksY; ++by){
+		for(std::uint32_t bx = 0; bx < blocksX; ++bx){
+			const auto encoded = src.subspan((std::size_t{by} * blocksX + bx) * bytes, bytes);
+
+			if(compressed.format == BlockFormat::bc4){
+				decodeBC4Block(encoded, block);
+			}else{
+				decodeBC7Block(encoded, block);
+			}
+
+			//the texels past the edge of a partial block are dropped
+			for(std::uint32_t i = 0; i < 16; ++i){
+				const std::uint32_t x = bx * BlockExtent + i % BlockExtent;
+				const std::uint32_t y = by * BlockExtent + i / BlockExtent;
+				if(x >= compressed.size.x || y >= compressed.size.y) continue;
+
+				std::memcpy(dst + (std::size_t{y} * compressed.size.x + x) * Pixmap::Channels, block[i].data(), Pixmap::Channels);
+			}
+		}
+	}
+
+	return pixmap;
+}
@@ -7,6 +7,7 @@ import Core.File;
 import Image;
 import ext.concepts;
 import Graphic.Color;
+import Graphic.Pixmap.Kernel;
 import Math;
 import std;
 
@@ -26,6 +27,14 @@ export namespace Graphic{
 
         std::unique_ptr<DataType[]> bitmapData{nullptr};
 
+        [[nodiscard]] ColorBits* pixels() const noexcept{
+            return reinterpret_cast<ColorBits*>(bitmapData.get());
+        }
+
+        [[nodiscard]] ColorBits* row(const size_type x, const size_type y) const noexcept{
+            return pixels() + static_cast<std::size_t>(y) * width + x;
+        }
+
     public:
         //TODO channel support
         static constexpr size_type Channels = 4; //FOR RGBA
@@ -138,7 +147,7 @@ export namespace Graphic{
         }
 
         void fill(const Color color) const{
-            std::fill_n(reinterpret_cast<ColorBits*>(bitmapData.get()), pixelSize(), color.rgba());
+            PixmapKernel::fill(pixels(), pixelSize(), color.rgba());
         }
 
         DataType& operator [](const size_t index){
@@ -146,16 +155,15 @@ export namespace Graphic{
         }
 
         void mix(const Color color, const float alpha) const{
-            for(size_type i = 0; i < pixelSize(); ++i){
-                Color src = get(i);
-                set(i, src.lerpRGB(color, alpha));
-            }
+            PixmapKernel::mix(pixels(), pixelSize(), color, alpha);
         }
 
         void mulWhite() const{
-            for(size_type i = 0; i < pixelSize(); ++i){
-                setRaw(i, getRaw(i) | 0x00'ff'ff'ff);
-            }
+            PixmapKernel::mulWhite(pixels(), pixelSize());
+        }
+
+        void premultiplyAlpha() const{
+            PixmapKernel::premultiply(pixels(), pixelSize());
         }
 
         void loadFrom(const Core::File& file) {
@@ -260,17 +268,18 @@ export namespace Graphic{
             return get(dataIndex(x, y));
         }
 
+        //row by row, as the pixels are stored
         void each(ext::invocable<void(Pixmap&, size_type, size_type)> auto&& func) {
-            for(size_type x = 0; x < width; x++) {
-                for(size_type y = 0; y < height; ++y) {
+            for(size_type y = 0; y < height; ++y) {
+                for(size_type x = 0; x < width; x++) {
                     func(*this, x, y);
                 }
             }
         }
 
         void each(ext::invocable<void(const Pixmap&, size_type, size_type)> auto&& func) const {
-            for(size_type x = 0; x < width; x++) {
-                for(size_type y = 0; y < height; ++y) {
+            for(size_type y = 0; y < height; ++y) {
+                for(size_type x = 0; x < width; x++) {
                     func(*this, x, y);
                 }
             }
@@ -282,36 +291,13 @@ export namespace Graphic{
         }
 
         static ColorBits blend(const ColorBits src, const ColorBits dst){
-            const ColorBits src_a = src & Color::a_Mask;
-            if(src_a == 0) return dst;
-
-            ColorBits dst_a = dst & Color::a_Mask;
-            if(dst_a == 0) return src;
-            ColorBits dst_r = dst >> Color::r_Offset & Color::a_Mask;
-            ColorBits dst_g = dst >> Color::g_Offset & Color::a_Mask;
-            ColorBits dst_b = dst >> Color::b_Offset & Color::a_Mask;
-
-            dst_a -=  static_cast<ColorBits>(static_cast<float>(dst_a) * (static_cast<float>(src_a) / Color::maxValF));
-            const ColorBits a = dst_a + src_a;
-            dst_r = static_cast<ColorBits>(static_cast<float>(dst_r * dst_a + (src >> Color::r_Offset & Color::a_Mask) * src_a) / static_cast<float>(static_cast<ColorBits>(a)));
-            dst_g = static_cast<ColorBits>(static_cast<float>(dst_g * dst_a + (src >> Color::g_Offset & Color::a_Mask) * src_a) / static_cast<float>(static_cast<ColorBits>(a)));
-            dst_b = static_cast<ColorBits>(static_cast<float>(dst_b * dst_a + (src >> Color::b_Offset & Color::a_Mask) * src_a) / static_cast<float>(static_cast<ColorBits>(a)));
-            return
-                dst_r << Color::r_Offset |
-                dst_g << Color::g_Offset |
-                dst_b << Color::b_Offset |
-                    a << Color::a_Offset;
+            return PixmapKernel::blend(src, dst);
         }
 
     public:
         void flipY() const{
-            const std::size_t rowDataCount = static_cast<std::size_t>(getWidth()) * Channels;
-
-            for(std::size_t y = 0; y < height / 2; ++y){
-                std::swap_ranges(
-                    bitmapData.get() + rowDataCount * y, bitmapData.get() + rowDataCount * y + rowDataCount,
-                    bitmapData.get() + rowDataCount * (height - y - 1)
-                );
+            for(size_type y = 0; y < height / 2; ++y){
+                PixmapKernel::swap(row(0, y), row(0, height - y - 1), width);
             }
         }
         void blend(const size_type x, const size_type y, const Color& color) const {
@@ -357,116 +343,87 @@ export namespace Graphic{
                 return;
             }
 
-            if(srcWidth == dstWidth && srcHeight == dstHeight){
-                size_type sx;
-                size_type dx;
-                size_type sy = srcy;
-                size_type dy = dsty;
+            //the parts out of either pixmap are clipped
+            if(srcx >= owidth || srcy >= oheight || dstx >= width || dsty >= height){
+                return;
+            }
 
+            const auto writeRow = [blending](ColorBits* dst, const ColorBits* src, const size_type count){
                 if(blending){
-                    for(; sy < srcy + srcHeight; sy++, dy++){
-                        if(sy >= oheight || dy >= height) break;
-
-                        for(sx = srcx, dx = dstx; sx < srcx + srcWidth; sx++, dx++){
-                            if(sx >= owidth || dx >= width) break;
-                            setRaw(dx, dy, blend(pixmap.getRaw(sx, sy), getRaw(dx, dy)));
-                        }
-                    }
+                    PixmapKernel::blend(dst, src, count);
                 }else{
-                        //TODO this can be optimized with scanlines, potentially
-                    for(; sy < srcy + srcHeight; sy++, dy++){
-                        if(sy >= oheight || dy >= height) break;
-
-                        for(sx = srcx, dx = dstx; sx < srcx + srcWidth; sx++, dx++){
-                            if(sx >= owidth || dx >= width) break;
-                            setRaw(dx, dy, pixmap.getRaw(sx, sy));
-                        }
-                    }
+                    std::memmove(dst, src, count * sizeof(ColorBits));
+                }
+            };
+
+            if(srcWidth == dstWidth && srcHeight == dstHeight){
+                const size_type count = std::min({srcWidth, owidth - srcx, width - dstx});
+                const size_type rows = std::min({srcHeight, oheight - srcy, height - dsty});
+
+                for(size_type i = 0; i < rows; ++i){
+                    writeRow(row(dstx, dsty + i), pixmap.row(srcx, srcy + i), count);
+                }
+
+                return;
+            }
+
+            //sampled rows go through a scratch row so the blend stays a row kernel
+            std::vector<ColorBits> scratch(dstWidth);
+
+            if(filtering){
+                //blit with bilinear filtering
+                const float x_ratio = (static_cast<float>(srcWidth) - 1) / static_cast<float>(dstWidth);
+                const float y_ratio = (static_cast<float>(srcHeight) - 1) / static_cast<float>(dstHeight);
+                const size_type rX = Math::max(Math::round<size_type>(x_ratio), 1u);
+                const size_type rY = Math::max(Math::round<size_type>(y_ratio), 1u);
+
+                //the far samples stay inside the source region
+                const size_type srcRight = std::min(srcx + srcWidth, owidth) - 1;
+                const size_type srcBottom = std::min(srcy + srcHeight, oheight) - 1;
+
+                PixmapKernel::BilinearColumns columns{};
+
+                for(size_type j = 0; j < dstWidth; j++){
+                    const float fx = x_ratio * static_cast<float>(j);
+                    const size_type sx = static_cast<size_type>(fx) + srcx;
+                    if(sx >= owidth || j + dstx >= width) break;
+
+                    columns.push(sx, std::min(sx + rX, srcRight), fx - std::floor(fx));
+                }
+
+                for(size_type i = 0; i < dstHeight; i++){
+                    const float fy = y_ratio * static_cast<float>(i);
+                    const size_type sy = static_cast<size_type>(fy) + srcy;
+                    const size_type dy = i + dsty;
+
+                    if(sy >= oheight || dy >= height) break;
+
+                    PixmapKernel::bilinear(scratch.data(), pixmap.row(0, sy), pixmap.row(0, std::min(sy + rY, srcBottom)), columns, fy - std::floor(fy));
+                    writeRow(row(dstx, dy), scratch.data(), static_cast<size_type>(columns.size()));
                 }
             }else{
-                if(filtering){
-                    //blit with bilinear filtering
-                    const float x_ratio = (static_cast<float>(srcWidth) - 1) / static_cast<float>(dstWidth);
-                    const float y_ratio = (static_cast<float>(srcHeight) - 1) / static_cast<float>(dstHeight);
-                    const size_type rX = Math::max(Math::round<size_type>(x_ratio), 1u);
-                    const size_type rY = Math::max(Math::round<size_type>(y_ratio), 1u);
-                    const size_type spitch = Pixmap::Channels * owidth;
-
-                    for(size_type i = 0; i < dstHeight; i++){
-                        const size_type sy = static_cast<size_type>(static_cast<float>(i) * y_ratio) + srcy;
-                        const size_type dy = i + dsty;
-                        const float ydiff = y_ratio * static_cast<float>(i) + static_cast<float>(srcy - sy);
-
-                        if(sy >= oheight || dy >= height) break;
-
-                        for(size_type j = 0; j < dstWidth; j++){
-                            const size_type sx = static_cast<size_type>(static_cast<float>(j) * x_ratio) + srcx;
-                            const size_type dx = j + dstx;
-                            const float xdiff = x_ratio * static_cast<float>(j) + static_cast<float>(srcx - sx);
-                            if(sx >= owidth || dx >= width) break;
-
-                            const size_type
-                                srcp = (sx + sy * owidth) * Pixmap::Channels;
-
-                            const ColorBits
-                                c1 = pixmap.getRaw(srcp),
-                                c2 = sx + rX < srcWidth  ? pixmap.getRaw(srcp + Pixmap::Channels *rX) : c1,
-                                c3 = sy + rY < srcHeight ? pixmap.getRaw(srcp + spitch * rY) : c1,
-                                c4 = sx + rX < srcWidth && sy + rY < srcHeight ? pixmap.getRaw(srcp + Pixmap::Channels * rX + spitch * rY) : c1;
-
-                            const float ta = (1 - xdiff) * (1 - ydiff);
-                            const float tb =      xdiff  * (1 - ydiff);
-                            const float tc = (1 - xdiff) *      ydiff ;
-                            const float td =      xdiff  *      ydiff ;
-
-                            const ColorBits r = Color::a_Mask & static_cast<ColorBits>(
-                                static_cast<float>((c1 & Color::r_Mask) >> Color::r_Offset) * ta +
-                                static_cast<float>((c2 & Color::r_Mask) >> Color::r_Offset) * tb +
-                                static_cast<float>((c3 & Color::r_Mask) >> Color::r_Offset) * tc +
-                                static_cast<float>((c4 & Color::r_Mask) >> Color::r_Offset) * td
-                            );
-                            const ColorBits g = Color::a_Mask & static_cast<ColorBits>(
-                                static_cast<float>((c1 & Color::g_Mask) >> Color::g_Offset) * ta +
-                                static_cast<float>((c2 & Color::g_Mask) >> Color::g_Offset) * tb +
-                                static_cast<float>((c3 & Color::g_Mask) >> Color::g_Offset) * tc +
-                                static_cast<float>((c4 & Color::g_Mask) >> Color::g_Offset) * td
-                            );
-                            const ColorBits b = Color::a_Mask & static_cast<ColorBits>(
-                                static_cast<float>((c1 & Color::b_Mask) >> Color::b_Offset) * ta +
-                                static_cast<float>((c2 & Color::b_Mask) >> Color::b_Offset) * tb +
-                                static_cast<float>((c3 & Color::b_Mask) >> Color::b_Offset) * tc +
-                                static_cast<float>((c4 & Color::b_Mask) >> Color::b_Offset) * td
-                            );
-                            const ColorBits a = Color::a_Mask & static_cast<ColorBits>(
-                                static_cast<float>((c1 & Color::a_Mask) >> Color::a_Offset) * ta +
-                                static_cast<float>((c2 & Color::a_Mask) >> Color::a_Offset) * tb +
-                                static_cast<float>((c3 & Color::a_Mask) >> Color::a_Offset) * tc +
-                                static_cast<float>((c4 & Color::a_Mask) >> Color::a_Offset) * td
-                            );
-
-                            const size_type srccol = r << Color::r_Offset | g << Color::g_Offset | b << Color::b_Offset | a << Color::a_Offset;
-
-                            setRaw(dx, dy, !blending ? srccol : blend(srccol, getRaw(dx, dy)));
-                        }
-                    }
-                }else{
-                    //blit with nearest neighbor filtering
-                    const size_type xratio = (srcWidth << 16) / dstWidth + 1;
-                    const size_type yratio = (srcHeight << 16) / dstHeight + 1;
-
-                    for(size_type i = 0; i < dstHeight; i++){
-                        const size_type sy = (i * yratio >> 16) + srcy;
-                        const size_type dy = i + dsty;
-                        if(sy >= oheight || dy >= height) break;
-
-                        for(size_type j = 0; j < dstWidth; j++){
-                            const size_type sx = (j * xratio >> 16) + srcx;
-                            const size_type dx = j + dstx;
-                            if(sx >= owidth || dx >= width) break;
-
-                            setRaw(dx, dy, !blending ? pixmap.getRaw(sx, sy) : blend(pixmap.getRaw(sx, sy), getRaw(dx, dy)));
-                        }
-                    }
+                //blit with nearest neighbor filtering
+                const size_type xratio = (srcWidth << 16) / dstWidth + 1;
+                const size_type yratio = (srcHeight << 16) / dstHeight + 1;
+
+                std::vector<size_type> columns{};
+                columns.reserve(dstWidth);
+
+                for(size_type j = 0; j < dstWidth; j++){
+                    const size_type sx = (j * xratio >> 16) + srcx;
+                    if(sx >= owidth || j + dstx >= width) break;
+
+                    columns.push_back(sx);
+                }
+
+                for(size_type i = 0; i < dstHeight; i++){
+                    const size_type sy = (i * yratio >> 16) + srcy;
+                    const size_type dy = i + dsty;
+                    if(sy >= oheight || dy >= height) break;
+
+                    const ColorBits* src = pixmap.row(0, sy);
+                    std::ranges::transform(columns, scratch.begin(), [src](const size_type sx){ return src[sx]; });
+                    writeRow(row(dstx, dy), scratch.data(), static_cast<size_type>(columns.size()));
                 }
             }
         }
@@ -0,0 +1,628 @@
+module;
+
+#include "../src/arc/math/simd.hpp"
+
+export module Graphic.Pixmap.Kernel;
+
+import Graphic.Color;
+import Math.SIMD;
+import std;
+
+export namespace Graphic::PixmapKernel{
+	using ColorBits = Color::ColorBits;
+
+	/**
+	 * @brief Source columns of one scaled row, shared by every row of a bilinear blit
+	 */
+	struct BilinearColumns{
+		std::vector<std::uint32_t> near{};
+		/** @brief the second sample, clamped to the source region */
+		std::vector<std::uint32_t> far{};
+		/** @brief weight of the far sample */
+		std::vector<float> weight{};
+
+		[[nodiscard]] std::size_t size() const noexcept{
+			return near.size();
+		}
+
+		void push(const std::uint32_t nearX, const std::uint32_t farX, const float farWeight){
+			near.push_back(nearX);
+			far.push_back(farX);
+			weight.push_back(farWeight);
+		}
+	};
+
+	/**
+	 * @brief Non premultiplied source over destination, the alpha of the destination is kept as the coverage left over.
+	 */
+	[[nodiscard]] constexpr ColorBits blend(const ColorBits src, const ColorBits dst) noexcept{
+		const ColorBits src_a = src & Color::a_Mask;
+		if(src_a == 0) return dst;
+
+		ColorBits dst_a = dst & Color::a_Mask;
+		if(dst_a == 0) return src;
+		ColorBits dst_r = dst >> Color::r_Offset & Color::a_Mask;
+		ColorBits dst_g = dst >> Color::g_Offset & Color::a_Mask;
+		ColorBits dst_b = dst >> Color::b_Offset & Color::a_Mask;
+
+		dst_a -=  static_cast<ColorBits>(static_cast<float>(dst_a) * (static_cast<float>(src_a) / Color::maxValF));
+		const ColorBits a = dst_a + src_a;
+		dst_r = static_cast<ColorBits>(static_cast<float>(dst_r * dst_a + (src >> Color::r_Offset & Color::a_Mask) * src_a) / static_cast<float>(static_cast<ColorBits>(a)));
+		dst_g = static_cast<ColorBits>(static_cast<float>(dst_g * dst_a + (src >> Color::g_Offset & Color::a_Mask) * src_a) / static_cast<float>(static_cast<ColorBits>(a)));
+		dst_b = static_cast<ColorBits>(static_cast<float>(dst_b * dst_a + (src >> Color::b_Offset & Color::a_Mask) * src_a) / static_cast<float>(static_cast<ColorBits>(a)));
+		return
+			dst_r << Color::r_Offset |
+			dst_g << Color::g_Offset |
+			dst_b << Color::b_Offset |
+				a << Color::a_Offset;
+	}
+
+	/**
+	 * @brief rounded `channel * alpha / 255` without a division, exact for every pair of bytes
+	 */
+	[[nodiscard]] constexpr ColorBits mulByte(const ColorBits channel, const ColorBits alpha) noexcept{
+		const ColorBits product = channel * alpha + 128;
+		return (product + (product >> 8)) >> 8;
+	}
+
+	[[nodiscard]] constexpr ColorBits premultiply(const ColorBits color) noexcept{
+		const ColorBits a = color & Color::a_Mask;
+
+		return
+			mulByte(color >> Color::r_Offset & Color::a_Mask, a) << Color::r_Offset |
+			mulByte(color >> Color::g_Offset & Color::a_Mask, a) << Color::g_Offset |
+			mulByte(color >> Color::b_Offset & Color::a_Mask, a) << Color::b_Offset |
+			a << Color::a_Offset;
+	}
+
+	/**
+	 * The row kernels below are selected at runtime by @link Math::SIMD::getInstructionSet @endlink (AVX2: 8 pixels, SSE: 4 pixels, or scalar),
+	 * every path gives the same bits as the scalar one.
+	 */
+
+	void fill(ColorBits* dst, std::size_t count, ColorBits value) noexcept;
+
+	/** @brief `dst[i] = blend(src[i], dst[i])`, the rows may not overlap */
+	void blend(ColorBits* dst, const ColorBits* src, std::size_t count) noexcept;
+
+	void premultiply(ColorBits* row, std::size_t count) noexcept;
+
+	/** @brief lerps the RGB of every pixel towards the color, same as @link Color::lerpRGB @endlink */
+	void mix(ColorBits* row, std::size_t count, const Color& color, float alpha) noexcept;
+
+	void mulWhite(ColorBits* row, std::size_t count) noexcept;
+
+	void swap(ColorBits* lhs, ColorBits* rhs, std::size_t count) noexcept;
+
+	/**
+	 * @brief Samples one scaled row between two source rows.
+	 * @param dst at least `columns.size()` large
+	 * @param farWeight weight of the far row
+	 */
+	void bilinear(ColorBits* dst, const ColorBits* nearRow, const ColorBits* farRow, const BilinearColumns& columns, float farWeight) noexcept;
+}
+
+module : private;
+
+namespace Graphic::PixmapKernel{
+	using Math::SIMD::InstructionSet;
+
+	constexpr ColorBits WhiteRGB{0x00'ff'ff'ff};
+
+	void mix_scalar(ColorBits* row, const std::size_t count, const Color& color, const float alpha) noexcept{
+		for(std::size_t i = 0; i < count; ++i){
+			Color src{};
+			src.rgba8888(row[i]);
+			row[i] = src.lerpRGB(color, alpha).rgba8888();
+		}
+	}
+
+	void bilinear_scalar(ColorBits* dst, const ColorBits* nearRow, const ColorBits* farRow, const BilinearColumns& columns,
+		const std::size_t begin, const float farWeight) noexcept{
+
+		for(std::size_t i = begin; i < columns.size(); ++i){
+			const float xdiff = columns.weight[i];
+			const ColorBits
+				c1 = nearRow[columns.near[i]],
+				c2 = nearRow[columns.far[i]],
+				c3 = farRow[columns.near[i]],
+				c4 = farRow[columns.far[i]];
+
+			const float ta = (1 - xdiff) * (1 - farWeight);
+			const float tb =      xdiff  * (1 - farWeight);
+			const float tc = (1 - xdiff) *      farWeight ;
+			const float td =      xdiff  *      farWeight ;
+
+			ColorBits result{};
+			for(const unsigned offset : {Color::r_Offset, Color::g_Offset, Color::b_Offset, Color::a_Offset}){
+				const ColorBits channel = Color::a_Mask & static_cast<ColorBits>(
+					static_cast<float>(c1 >> offset & Color::a_Mask) * ta +
+					static_cast<float>(c2 >> offset & Color::a_Mask) * tb +
+					static_cast<float>(c3 >> offset & Color::a_Mask) * tc +
+					static_cast<float>(c4 >> offset & Color::a_Mask) * td
+				);
+
+				result |= channel << offset;
+			}
+
+			dst[i] = result;
+		}
+	}
+
+#if SIMD_X86
+	/*
+	 * The vector paths keep every channel in a 32 bit lane of its own and repeat the float operations of the scalar path in the same order,
+	 * no lambdas here: they would not inherit the target attribute.
+	 */
+
+	SIMD_TARGET_SSE4_1
+	std::size_t blend_sse4_1(ColorBits* dst, const ColorBits* src, const std::size_t count) noexcept{
+		const __m128i mask = _mm_set1_epi32(Color::a_Mask);
+		const __m128 maxVal = _mm_set1_ps(Color::maxValF);
+
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+			const __m128i srcA = _mm_and_si128(s, mask);
+			const __m128i dstA = _mm_and_si128(d, mask);
+
+			const __m128i covered = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(dstA), _mm_div_ps(_mm_cvtepi32_ps(srcA), maxVal)));
+			const __m128i leftA = _mm_sub_epi32(dstA, covered);
+			const __m128i a = _mm_add_epi32(leftA, srcA);
+			const __m128 fa = _mm_cvtepi32_ps(a);
+
+			__m128i result = a;
+
+#define BLEND_CHANNEL(OFFSET) {\
+				const __m128i dc = _mm_and_si128(_mm_srli_epi32(d, OFFSET), mask);\
+				const __m128i sc = _mm_and_si128(_mm_srli_epi32(s, OFFSET), mask);\
+				const __m128i sum = _mm_add_epi32(_mm_mullo_epi32(dc, leftA), _mm_mullo_epi32(sc, srcA));\
+				result = _mm_or_si128(result, _mm_slli_epi32(_mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(sum), fa)), OFFSET));\
+			}
+
+			BLEND_CHANNEL(Color::r_Offset)
+			BLEND_CHANNEL(Color::g_Offset)
+			BLEND_CHANNEL(Color::b_Offset)
+#undef BLEND_CHANNEL
+
+			//a transparent source leaves the destination, this also drops the lanes divided by zero
+			result = _mm_blendv_epi8(result, d, _mm_cmpeq_epi32(srcA, _mm_setzero_si128()));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_AVX2
+	std::size_t blend_avx2(ColorBits* dst, const ColorBits* src, const std::size_t count) noexcept{
+		const __m256i mask = _mm256_set1_epi32(Color::a_Mask);
+		const __m256 maxVal = _mm256_set1_ps(Color::maxValF);
+
+		std::size_t i = 0;
+		for(; i + 8 <= count; i += 8){
+			const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+
+			const __m256i srcA = _mm256_and_si256(s, mask);
+			const __m256i dstA = _mm256_and_si256(d, mask);
+
+			const __m256i covered = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(dstA), _mm256_div_ps(_mm256_cvtepi32_ps(srcA), maxVal)));
+			const __m256i leftA = _mm256_sub_epi32(dstA, covered);
+			const __m256i a = _mm256_add_epi32(leftA, srcA);
+			const __m256 fa = _mm256_cvtepi32_ps(a);
+
+			__m256i result = a;
+
+#define BLEND_CHANNEL(OFFSET) {\
+				const __m256i dc = _mm256_and_si256(_mm256_srli_epi32(d, OFFSET), mask);\
+				const __m256i sc = _mm256_and_si256(_mm256_srli_epi32(s, OFFSET), mask);\
+				const __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(dc, leftA), _mm256_mullo_epi32(sc, srcA));\
+				result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(sum), fa)), OFFSET));\
+			}
+
+			BLEND_CHANNEL(Color::r_Offset)
+			BLEND_CHANNEL(Color::g_Offset)
+			BLEND_CHANNEL(Color::b_Offset)
+#undef BLEND_CHANNEL
+
+			result = _mm256_blendv_epi8(result, d, _mm256_cmpeq_epi32(srcA, _mm256_setzero_si256()));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_SSE4_1
+	std::size_t premultiply_sse4_1(ColorBits* row, const std::size_t count) noexcept{
+		const __m128i mask = _mm_set1_epi32(Color::a_Mask);
+		const __m128i half = _mm_set1_epi32(128);
+
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+			const __m128i a = _mm_and_si128(c, mask);
+
+			__m128i result = a;
+
+#define PREMULTIPLY_CHANNEL(OFFSET) {\
+				const __m128i product = _mm_add_epi32(_mm_mullo_epi32(_mm_and_si128(_mm_srli_epi32(c, OFFSET), mask), a), half);\
+				result = _mm_or_si128(result, _mm_slli_epi32(_mm_srli_epi32(_mm_add_epi32(product, _mm_srli_epi32(product, 8)), 8), OFFSET));\
+			}
+
+			PREMULTIPLY_CHANNEL(Color::r_Offset)
+			PREMULTIPLY_CHANNEL(Color::g_Offset)
+			PREMULTIPLY_CHANNEL(Color::b_Offset)
+#undef PREMULTIPLY_CHANNEL
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), result);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_AVX2
+	std::size_t premultiply_avx2(ColorBits* row, const std::size_t count) noexcept{
+		const __m256i mask = _mm256_set1_epi32(Color::a_Mask);
+		const __m256i half = _mm256_set1_epi32(128);
+
+		std::size_t i = 0;
+		for(; i + 8 <= count; i += 8){
+			const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+			const __m256i a = _mm256_and_si256(c, mask);
+
+			__m256i result = a;
+
+#define PREMULTIPLY_CHANNEL(OFFSET) {\
+				const __m256i product = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_and_si256(_mm256_srli_epi32(c, OFFSET), mask), a), half);\
+				result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_srli_epi32(_mm256_add_epi32(product, _mm256_srli_epi32(product, 8)), 8), OFFSET));\
+			}
+
+			PREMULTIPLY_CHANNEL(Color::r_Offset)
+			PREMULTIPLY_CHANNEL(Color::g_Offset)
+			PREMULTIPLY_CHANNEL(Color::b_Offset)
+#undef PREMULTIPLY_CHANNEL
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(row + i), result);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_SSE4_1
+	std::size_t mix_sse4_1(ColorBits* row, const std::size_t count, const Color& color, const float alpha) noexcept{
+		const __m128i mask = _mm_set1_epi32(Color::a_Mask);
+		const __m128 maxVal = _mm_set1_ps(Color::maxValF);
+		const __m128 t = _mm_set1_ps(alpha);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+			__m128i result = _mm_setzero_si128();
+
+#define MIX_CHANNEL(OFFSET, TARGET) {\
+				__m128 v = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c, OFFSET), mask)), maxVal);\
+				v = _mm_add_ps(v, _mm_mul_ps(t, _mm_sub_ps(_mm_set1_ps(TARGET), v)));\
+				v = _mm_max_ps(_mm_min_ps(v, one), zero);\
+				result = _mm_or_si128(result, _mm_and_si128(_mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(v, maxVal)), OFFSET), _mm_slli_epi32(mask, OFFSET)));\
+			}
+
+			MIX_CHANNEL(Color::r_Offset, color.r)
+			MIX_CHANNEL(Color::g_Offset, color.g)
+			MIX_CHANNEL(Color::b_Offset, color.b)
+#undef MIX_CHANNEL
+
+			//the alpha only goes through the float round trip
+			__m128 a = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(c, mask)), maxVal);
+			a = _mm_max_ps(_mm_min_ps(a, one), zero);
+			result = _mm_or_si128(result, _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(a, maxVal)), mask));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), result);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_AVX2
+	std::size_t mix_avx2(ColorBits* row, const std::size_t count, const Color& color, const float alpha) noexcept{
+		const __m256i mask = _mm256_set1_epi32(Color::a_Mask);
+		const __m256 maxVal = _mm256_set1_ps(Color::maxValF);
+		const __m256 t = _mm256_set1_ps(alpha);
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.f);
+
+		std::size_t i = 0;
+		for(; i + 8 <= count; i += 8){
+			const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+			__m256i result = _mm256_setzero_si256();
+
+#define MIX_CHANNEL(OFFSET, TARGET) {\
+				__m256 v = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c, OFFSET), mask)), maxVal);\
+				v = _mm256_add_ps(v, _mm256_mul_ps(t, _mm256_sub_ps(_mm256_set1_ps(TARGET), v)));\
+				v = _mm256_max_ps(_mm256_min_ps(v, one), zero);\
+				result = _mm256_or_si256(result, _mm256_and_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(v, maxVal)), OFFSET), _mm256_slli_epi32(mask, OFFSET)));\
+			}
+
+			MIX_CHANNEL(Color::r_Offset, color.r)
+			MIX_CHANNEL(Color::g_Offset, color.g)
+			MIX_CHANNEL(Color::b_Offset, color.b)
+#undef MIX_CHANNEL
+
+			__m256 a = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(c, mask)), maxVal);
+			a = _mm256_max_ps(_mm256_min_ps(a, one), zero);
+			result = _mm256_or_si256(result, _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(a, maxVal)), mask));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(row + i), result);
+		}
+
+		return i;
+	}
+
+	std::size_t bilinear_sse2(ColorBits* dst, const ColorBits* nearRow, const ColorBits* farRow, const BilinearColumns& columns, const float farWeight) noexcept{
+		const __m128i mask = _mm_set1_epi32(Color::a_Mask);
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 ydiff = _mm_set1_ps(farWeight);
+		const __m128 ydiffInv = _mm_sub_ps(one, ydiff);
+
+		const std::size_t count = columns.size();
+		const std::uint32_t* near = columns.near.data();
+		const std::uint32_t* far = columns.far.data();
+
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			const __m128i c1 = _mm_setr_epi32(nearRow[near[i]], nearRow[near[i + 1]], nearRow[near[i + 2]], nearRow[near[i + 3]]);
+			const __m128i c2 = _mm_setr_epi32(nearRow[far[i]], nearRow[far[i + 1]], nearRow[far[i + 2]], nearRow[far[i + 3]]);
+			const __m128i c3 = _mm_setr_epi32(farRow[near[i]], farRow[near[i + 1]], farRow[near[i + 2]], farRow[near[i + 3]]);
+			const __m128i c4 = _mm_setr_epi32(farRow[far[i]], farRow[far[i + 1]], farRow[far[i + 2]], farRow[far[i + 3]]);
+
+			const __m128 xdiff = _mm_loadu_ps(columns.weight.data() + i);
+			const __m128 xdiffInv = _mm_sub_ps(one, xdiff);
+
+			const __m128 ta = _mm_mul_ps(xdiffInv, ydiffInv);
+			const __m128 tb = _mm_mul_ps(xdiff, ydiffInv);
+			const __m128 tc = _mm_mul_ps(xdiffInv, ydiff);
+			const __m128 td = _mm_mul_ps(xdiff, ydiff);
+
+			__m128i result = _mm_setzero_si128();
+
+#define SAMPLE_CHANNEL(OFFSET) {\
+				__m128 sum = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c1, OFFSET), mask)), ta);\
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c2, OFFSET), mask)), tb));\
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c3, OFFSET), mask)), tc));\
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c4, OFFSET), mask)), td));\
+				result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(sum), mask), OFFSET));\
+			}
+
+			SAMPLE_CHANNEL(Color::r_Offset)
+			SAMPLE_CHANNEL(Color::g_Offset)
+			SAMPLE_CHANNEL(Color::b_Offset)
+			SAMPLE_CHANNEL(Color::a_Offset)
+#undef SAMPLE_CHANNEL
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_AVX2
+	std::size_t bilinear_avx2(ColorBits* dst, const ColorBits* nearRow, const ColorBits* farRow, const BilinearColumns& columns, const float farWeight) noexcept{
+		const __m256i mask = _mm256_set1_epi32(Color::a_Mask);
+		const __m256 one = _mm256_set1_ps(1.f);
+		const __m256 ydiff = _mm256_set1_ps(farWeight);
+		const __m256 ydiffInv = _mm256_sub_ps(one, ydiff);
+
+		const std::size_t count = columns.size();
+		const auto* nearBase = reinterpret_cast<const int*>(nearRow);
+		const auto* farBase = reinterpret_cast<const int*>(farRow);
+
+		std::size_t i = 0;
+		for(; i + 8 <= count; i += 8){
+			const __m256i near = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.near.data() + i));
+			const __m256i far = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.far.data() + i));
+
+			const __m256i c1 = _mm256_i32gather_epi32(nearBase, near, 4);
+			const __m256i c2 = _mm256_i32gather_epi32(nearBase, far, 4);
+			const __m256i c3 = _mm256_i32gather_epi32(farBase, near, 4);
+			const __m256i c4 = _mm256_i32gather_epi32(farBase, far, 4);
+
+			const __m256 xdiff = _mm256_loadu_ps(columns.weight.data() + i);
+			const __m256 xdiffInv = _mm256_sub_ps(one, xdiff);
+
+			const __m256 ta = _mm256_mul_ps(xdiffInv, ydiffInv);
+			const __m256 tb = _mm256_mul_ps(xdiff, ydiffInv);
+			const __m256 tc = _mm256_mul_ps(xdiffInv, ydiff);
+			const __m256 td = _mm256_mul_ps(xdiff, ydiff);
+
+			__m256i result = _mm256_setzero_si256();
+
+#define SAMPLE_CHANNEL(OFFSET) {\
+				__m256 sum = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c1, OFFSET), mask)), ta);\
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c2, OFFSET), mask)), tb));\
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c3, OFFSET), mask)), tc));\
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c4, OFFSET), mask)), td));\
+				result = _mm256_or_si256(result, _mm256_slli_epi32(_mm256_and_si256(_mm256_cvttps_epi32(sum), mask), OFFSET));\
+			}
+
+			SAMPLE_CHANNEL(Color::r_Offset)
+			SAMPLE_CHANNEL(Color::g_Offset)
+			SAMPLE_CHANNEL(Color::b_Offset)
+			SAMPLE_CHANNEL(Color::a_Offset)
+#undef SAMPLE_CHANNEL
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_AVX2
+	std::size_t fill_avx2(ColorBits* dst, const std::size_t count, const ColorBits value) noexcept{
+		const __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+
+		std::size_t i = 0;
+		for(; i + 8 <= count; i += 8){
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_AVX2
+	std::size_t mulWhite_avx2(ColorBits* row, const std::size_t count) noexcept{
+		const __m256i white = _mm256_set1_epi32(WhiteRGB);
+
+		std::size_t i = 0;
+		for(; i + 8 <= count; i += 8){
+			auto* ptr = reinterpret_cast<__m256i*>(row + i);
+			_mm256_storeu_si256(ptr, _mm256_or_si256(_mm256_loadu_si256(ptr), white));
+		}
+
+		return i;
+	}
+
+	SIMD_TARGET_AVX2
+	std::size_t swap_avx2(ColorBits* lhs, ColorBits* rhs, const std::size_t count) noexcept{
+		std::size_t i = 0;
+		for(; i + 8 <= count; i += 8){
+			auto* l = reinterpret_cast<__m256i*>(lhs + i);
+			auto* r = reinterpret_cast<__m256i*>(rhs + i);
+
+			const __m256i lv = _mm256_loadu_si256(l);
+			_mm256_storeu_si256(l, _mm256_loadu_si256(r));
+			_mm256_storeu_si256(r, lv);
+		}
+
+		return i;
+	}
+
+	/*
+	 * The plain loads and stores and the scalar loaded bilinear samples need nothing above SSE2
+	 */
+
+	std::size_t fill_sse2(ColorBits* dst, const std::size_t count, const ColorBits value) noexcept{
+		const __m128i v = _mm_set1_epi32(static_cast<int>(value));
+
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+		}
+
+		return i;
+	}
+
+	std::size_t mulWhite_sse2(ColorBits* row, const std::size_t count) noexcept{
+		const __m128i white = _mm_set1_epi32(WhiteRGB);
+
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			auto* ptr = reinterpret_cast<__m128i*>(row + i);
+			_mm_storeu_si128(ptr, _mm_or_si128(_mm_loadu_si128(ptr), white));
+		}
+
+		return i;
+	}
+
+	std::size_t swap_sse2(ColorBits* lhs, ColorBits* rhs, const std::size_t count) noexcept{
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4){
+			auto* l = reinterpret_cast<__m128i*>(lhs + i);
+			auto* r = reinterpret_cast<__m128i*>(rhs + i);
+
+			const __m128i lv = _mm_loadu_si128(l);
+			_mm_storeu_si128(l, _mm_loadu_si128(r));
+			_mm_storeu_si128(r, lv);
+		}
+
+		return i;
+	}
+#endif
+
+	void fill(ColorBits* dst, const std::size_t count, const ColorBits value) noexcept{
+		std::size_t i = 0;
+
+#if SIMD_X86
+		if(const auto set = Math::SIMD::getInstructionSet(); set >= InstructionSet::avx2) i = fill_avx2(dst, count, value);
+		else if(set >= InstructionSet::sse2) i = fill_sse2(dst, count, value);
+#endif
+
+		std::fill(dst + i, dst + count, value);
+	}
+
+	void blend(ColorBits* dst, const ColorBits* src, const std::size_t count) noexcept{
+		std::size_t i = 0;
+
+#if SIMD_X86
+		if(const auto set = Math::SIMD::getInstructionSet(); set >= InstructionSet::avx2) i = blend_avx2(dst, src, count);
+		else if(set >= InstructionSet::sse4_1) i = blend_sse4_1(dst, src, count);
+#endif
+
+		for(; i < count; ++i){
+			dst[i] = blend(src[i], dst[i]);
+		}
+	}
+
+	void premultiply(ColorBits* row, const std::size_t count) noexcept{
+		std::size_t i = 0;
+
+#if SIMD_X86
+		if(const auto set = Math::SIMD::getInstructionSet(); set >= InstructionSet::avx2) i = premultiply_avx2(row, count);
+		else if(set >= InstructionSet::sse4_1) i = premultiply_sse4_1(row, count);
+#endif
+
+		for(; i < count; ++i){
+			row[i] = premultiply(row[i]);
+		}
+	}
+
+	void mix(ColorBits* row, const std::size_t count, const Color& color, const float alpha) noexcept{
+		std::size_t i = 0;
+
+#if SIMD_X86
+		if(const auto set = Math::SIMD::getInstructionSet(); set >= InstructionSet::avx2) i = mix_avx2(row, count, color, alpha);
+		else if(set >= InstructionSet::sse4_1) i = mix_sse4_1(row, count, color, alpha);
+#endif
+
+		mix_scalar(row + i, count - i, color, alpha);
+	}
+
+	void mulWhite(ColorBits* row, const std::size_t count) noexcept{
+		std::size_t i = 0;
+
+#if SIMD_X86
+		if(const auto set = Math::SIMD::getInstructionSet(); set >= InstructionSet::avx2) i = mulWhite_avx2(row, count);
+		else if(set >= InstructionSet::sse2) i = mulWhite_sse2(row, count);
+#endif
+
+		for(; i < count; ++i){
+			row[i] |= WhiteRGB;
+		}
+	}
+
+	void swap(ColorBits* lhs, ColorBits* rhs, const std::size_t count) noexcept{
+		std::size_t i = 0;
+
+#if SIMD_X86
+		if(const auto set = Math::SIMD::getInstructionSet(); set >= InstructionSet::avx2) i = swap_avx2(lhs, rhs, count);
+		else if(set >= InstructionSet::sse2) i = swap_sse2(lhs, rhs, count);
+#endif
+
+		std::swap_ranges(lhs + i, lhs + count, rhs + i);
+	}
+
+	void bilinear(ColorBits* dst, const ColorBits* nearRow, const ColorBits* farRow, const BilinearColumns& columns, const float farWeight) noexcept{
+		std::size_t i = 0;
+
+#if SIMD_X86
+		if(const auto set = Math::SIMD::getInstructionSet(); set >= InstructionSet::avx2) i = bilinear_avx2(dst, nearRow, farRow, columns, farWeight);
+		else if(set >= InstructionSet::sse2) i = bilinear_sse2(dst, nearRow, farRow, columns, farWeight);
+#endif
+
+		bilinear_scalar(dst, nearRow, farRow, columns, i, farWeight);
+	}
+}
@@ -19,6 +19,7 @@ export import Core.Vulkan.Util;
 export import Core.Vulkan.DescriptorBuffer;
 export import Core.Vulkan.DescriptorLayout;
 export import Core.Vulkan.Preinstall;
+export import Graphic.Batch.TextureTable;
 
 import std;
 import ext.array_queue;
@@ -64,6 +65,8 @@ namespace Graphic{
 
 	export class VerticesDataBase;
 
+	export struct BatchInterface;
+
 	export
 	template <std::derived_from<VerticesDataBase> VerticesData>
 	struct BasicBatch;
@@ -71,15 +74,33 @@ namespace Graphic{
 	export
 	constexpr std::size_t BatchMaxGroupCount{2048 * 4};
 
+	/**
+	 * @brief the largest quad count a frame grows to before it is split, the initial capacity is @link BatchMaxGroupCount @endlink
+	 */
+	export
+	constexpr std::size_t BatchMaxGrowGroupCount{BatchMaxGroupCount * 8};
+
+	/**
+	 * @brief What a batch unit is, every acquired unit is one quad either way
+	 */
+	export
+	enum struct QuadSubmission{
+		/** @brief four vertices per quad, drawn with the quad index list */
+		vertices,
+		/** @brief one instance per quad, the vertex shader expands the corners of the first index group */
+		instances
+	};
+
 	export
 	template <bool atomic>
 	struct VerticesCounter{
-		static constexpr std::uint32_t MaxCount = BatchMaxGroupCount;
-
 	protected:
 		ext::cond_atomic<std::uint32_t, atomic> count{};
 		ext::cond_atomic<bool, atomic> acquirable{true};
 
+		/** @brief quads the staging memory holds, only changed while no one acquires */
+		std::uint32_t capacity{BatchMaxGroupCount};
+
 	public:
 		[[nodiscard]] VerticesCounter() = default;
 
@@ -90,12 +111,14 @@ namespace Graphic{
 		VerticesCounter(VerticesCounter&& other) noexcept requires (atomic){
 			count = other.count.load();
 			acquirable = other.acquirable.load();
+			capacity = other.capacity;
 		}
 
 		VerticesCounter& operator=(VerticesCounter&& other) noexcept requires (atomic) {
 			if(this == &other) return *this;
 			count = other.count.load();
 			acquirable = other.acquirable.load();
+			capacity = other.capacity;
 			return *this;
 		}
 
@@ -112,7 +135,11 @@ namespace Graphic{
 		}
 
 		[[nodiscard]] std::size_t getCount() const noexcept{
-			return std::min(MaxCount, static_cast<std::uint32_t>(count));
+			return std::min(capacity, static_cast<std::uint32_t>(count));
+		}
+
+		[[nodiscard]] std::size_t getCapacity() const noexcept{
+			return capacity;
 		}
 
 		[[nodiscard]] bool empty() const noexcept{
@@ -147,6 +174,12 @@ namespace Graphic{
 			return buffer;
 		}
 
+		/**
+		 * @brief replace the staging memory with a larger one, must not be transferring
+		 * @param keptSize bytes carried over from the old memory
+		 */
+		void reallocate(const BatchInterface& batch, VkDeviceSize size, std::size_t keptSize);
+
 		VerticesDataBase(const VerticesDataBase& other) = delete;
 
 		VerticesDataBase(VerticesDataBase&& other) noexcept = default;
@@ -162,11 +195,22 @@ namespace Graphic{
 
 		void activate(const std::ptrdiff_t unitOffset) noexcept{
 			if constexpr (requiresClean){
-				std::memset(vertData, 0, unitOffset * std::min<std::uint32_t>(ext::adapted_atomic_exchange(this->count, 0), BatchMaxGroupCount));
+				std::memset(vertData, 0, unitOffset * std::min<std::uint32_t>(ext::adapted_atomic_exchange(this->count, 0), this->capacity));
 			}
 			this->acquirable = true;
 		}
 
+		/**
+		 * @brief grow the staging memory to at least `count` quads, the acquired ones are kept, no one may acquire concurrently
+		 */
+		void reserve(const BatchInterface& batch, const std::size_t count, const std::ptrdiff_t unitOffset){
+			if(count <= this->capacity) return;
+
+			const auto next = static_cast<std::uint32_t>(std::bit_ceil(count));
+			reallocate(batch, next * unitOffset, this->getCount() * unitOffset);
+			this->capacity = next;
+		}
+
 		/**
 		 * @return [data ptr, success count]
 		 */
@@ -174,8 +218,9 @@ namespace Graphic{
 			const auto offset = this->count += count;
 
 			std::size_t successCount{count};
-			if(offset > BatchMaxGroupCount){
-				successCount -= offset - BatchMaxGroupCount;
+			if(offset > this->capacity){
+				//the frame may have been full before this call
+				successCount -= std::min<std::size_t>(offset - this->capacity, count);
 			}
 
 			return {static_cast<std::byte*>(vertData) + (offset - count) * unitOffset, successCount};
@@ -189,6 +234,9 @@ namespace Graphic{
 
 		static constexpr std::size_t MaximumAllowedSamplersSize{4};
 
+		/** @brief size of the sampler array the batch shaders index into */
+		static constexpr std::size_t TextureSlotCount{BindlessTextures ? TextureTable::Capacity : MaximumAllowedSamplersSize};
+
 		static constexpr std::uint32_t VerticesGroupCount{4};
 		static constexpr std::uint32_t IndicesGroupCount{6};
 
@@ -205,6 +253,9 @@ namespace Graphic{
 			Core::Vulkan::Fence fence{};
 			ImageSet usedImages_prev{};
 
+			/** @brief replaces the per unit descriptors in bindless mode */
+			const TextureTable* textureTable{};
+
 			decltype(auto) getBarriers() const{
 				return getBarriars(
 						vertexBuffer,
@@ -212,31 +263,48 @@ namespace Graphic{
 						descriptorBuffer_Double);
 			}
 
-			auto getDescriptorBufferBindInfo() const{
+			[[nodiscard]] VkDescriptorBufferBindingInfoEXT getDescriptorBufferBindInfo() const{
+				if(textureTable){
+					return textureTable->getBindInfo(VK_BUFFER_USAGE_2_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT);
+				}
+
 				return descriptorBuffer_Double.getBindInfo(VK_BUFFER_USAGE_2_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT);
 			}
 
 			[[nodiscard]] CommandUnit() = default;
 
-			[[nodiscard]] explicit CommandUnit(const BatchInterface& batch)
-				:
-				vertexBuffer{
+			[[nodiscard]] static Core::Vulkan::ExclusiveBuffer createVertexBuffer(const BatchInterface& batch){
+				return {
 					batch.context->physicalDevice, batch.context->device,
-					(batch.unitOffset * BatchMaxGroupCount),
+					(batch.unitOffset * batch.groupCapacity),
 					VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-				},
+				};
+			}
+
+			[[nodiscard]] explicit CommandUnit(const BatchInterface& batch)
+				:
+				vertexBuffer{createVertexBuffer(batch)},
 				indirectBuffer{
 					batch.context->physicalDevice, batch.context->device,
 					sizeof(VkDrawIndexedIndirectCommand),
 					VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
 				},
-				descriptorBuffer_Double{batch.context->physicalDevice, batch.context->device, batch.layout, batch.layout.size()},
 				transferCommand{batch.context->device, batch.transientCommandPool},
-				fence{batch.context->device, Core::Vulkan::Fence::CreateFlags::signal}
-			{}
+				fence{batch.context->device, Core::Vulkan::Fence::CreateFlags::signal},
+				textureTable{batch.textureTable.get()}
+			{
+				if(!textureTable){
+					descriptorBuffer_Double = {batch.context->physicalDevice, batch.context->device, batch.layout, batch.layout.size()};
+				}
+			}
 
+			/**
+			 * @brief no-op in bindless mode, the frames never record used images then
+			 */
 			void updateDescriptorSets(const ImageSet& imageSet, VkSampler sampler) const{
+				if(textureTable) return;
+
 				const auto end = std::ranges::find(imageSet, static_cast<VkImageView>(nullptr));
 				const std::span span{imageSet.begin(), end};
 
@@ -253,38 +321,64 @@ namespace Graphic{
 
 		//OPTM make unit offset as a template constexpr argument after the framework has basically done
 		std::ptrdiff_t unitOffset{};
+		QuadSubmission submission{};
+
+		/** @brief quads a unit can draw at once, follows the largest submitted frame */
+		std::uint32_t groupCapacity{BatchMaxGroupCount};
 
 		Core::Vulkan::DescriptorLayout layout{};
 		Core::Vulkan::IndexBuffer indexBuffer{};
 
 		VkSampler sampler{};
 
+		/** @brief null unless @link BindlessTextures @endlink */
+		std::unique_ptr<TextureTable> textureTable{};
+
 		ext::circular_array<CommandUnit, UnitSize> units{};
 		std::function<void(const CommandUnit&, std::size_t)> externalDrawCall{};
 
+		/**
+		 * @brief the unit vertex buffers and the index buffer were replaced, draw commands binding them must be recorded again
+		 *
+		 * Called once the fence of every unit is signaled, the draws are expected to be submitted along with it.
+		 * Only the commands binding the units are guaranteed not pending.
+		 */
+		std::function<void()> externalUnitsReallocated{};
+
 	protected:
 		ImageSet currentUsedImages{};
 		ImageIndex lastImageIndex{};
 		VkImageView lastUsedImageView{};
+		/** @brief bindless mode only, see @link TextureTable::getEpoch @endlink */
+		std::uint64_t lastTableEpoch{};
 
 	public:
 
 		[[nodiscard]] BatchInterface() = default;
 
-		[[nodiscard]] explicit BatchInterface(const Core::Vulkan::Context& context, const std::size_t vertexSize, VkSampler sampler) :
+		/**
+		 * @param vertexSize size of a vertex, or of an instance with @link QuadSubmission::instances @endlink
+		 */
+		[[nodiscard]] explicit BatchInterface(const Core::Vulkan::Context& context, const std::size_t vertexSize, VkSampler sampler,
+			const QuadSubmission submission = QuadSubmission::vertices) :
 			context{&context},
 			transientCommandPool{
 				context.device,
 				context.graphicFamily(),
 				VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
 			},
-			unitOffset{static_cast<std::ptrdiff_t>(vertexSize * VerticesGroupCount)},
+			unitOffset{static_cast<std::ptrdiff_t>(vertexSize * (submission == QuadSubmission::instances ? 1 : VerticesGroupCount))},
+			submission{submission},
 			layout{
 				context.device, [](Core::Vulkan::DescriptorLayout& layout){
-					layout.builder.push_seq(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
-											MaximumAllowedSamplersSize);
-
-					layout.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+					if constexpr (BindlessTextures){
+						TextureTable::defineLayout(layout);
+					}else{
+						layout.builder.push_seq(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT,
+												MaximumAllowedSamplersSize);
+
+						layout.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+					}
 				}
 			},
 			indexBuffer{
@@ -292,14 +386,23 @@ namespace Graphic{
 					context, transientCommandPool, Core::Vulkan::Util::BatchIndices<BatchMaxGroupCount>)
 			}, sampler{sampler}{
 
+			if constexpr (BindlessTextures){
+				textureTable = std::make_unique<TextureTable>(context.physicalDevice, context.device, sampler);
+			}
+
 			for(auto& commands : units)commands = CommandUnit{*this};
 		}
 
-		void setSampler(VkSampler sampler) noexcept{
+		void setSampler(VkSampler sampler){
 			if(!sampler)throw std::invalid_argument("invalid null sampler");
+			if(textureTable)throw std::logic_error("the sampler is baked into the texture table");
 			this->sampler = sampler;
 		}
 
+		[[nodiscard]] bool isBindless() const noexcept{
+			return textureTable != nullptr;
+		}
+
 		void bindBuffersTo(VkCommandBuffer commandBuffer, const std::size_t unitIndex){
 			vkCmdBindVertexBuffers(commandBuffer, 0, 1, units[unitIndex].vertexBuffer.as_data(), Core::Vulkan::Seq::Offset<0>);
 			vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, indexBuffer.indexType);
@@ -312,7 +415,51 @@ namespace Graphic{
 		}
 
 	protected:
+		/**
+		 * @brief grow every unit to draw `count` quads at once.
+		 *
+		 * Recorded draw commands of every unit reference the replaced buffers, the index buffer is shared among them,
+		 * so this waits for the fence of each unit, the other queues and batches go on.
+		 * Capacities only grow, a batch stalls once per new peak and never in steady state.
+		 */
+		void reserveUnits(const std::size_t count){
+			if(count <= groupCapacity) return;
+
+			for(const auto& unit : units){
+				unit.fence.wait();
+			}
+
+			groupCapacity = static_cast<std::uint32_t>(std::bit_ceil(count));
+
+			for(auto& unit : units){
+				unit.vertexBuffer = CommandUnit::createVertexBuffer(*this);
+			}
+
+			if(submission == QuadSubmission::vertices){
+				indexBuffer = Core::Vulkan::Util::createIndexBuffer(
+					*context, transientCommandPool,
+					Core::Vulkan::Util::generateIndexReferences<std::uint32_t>(groupCapacity, Core::Vulkan::Util::StandardIndexBase));
+			}
+
+			if(externalUnitsReallocated) externalUnitsReallocated();
+		}
+
+		/**
+		 * @return @link InvalidImageIndex @endlink in bindless mode only once the table has to be recycled
+		 */
 		[[nodiscard]] ImageIndex getMappedImageIndex(VkImageView imageView){
+			if(textureTable){
+				const std::uint64_t epoch = textureTable->getEpoch();
+				if(imageView == lastUsedImageView && epoch == lastTableEpoch){
+					return lastImageIndex;
+				}
+
+				//the epoch is read first, a slot freed meanwhile drops the cache on the next call
+				lastTableEpoch = epoch;
+				lastUsedImageView = imageView;
+				return lastImageIndex = textureTable->indexOf(imageView);
+			}
+
 			if(imageView == lastUsedImageView){
 				return lastImageIndex;
 			}
@@ -360,8 +507,9 @@ namespace Graphic{
 	public:
 		[[nodiscard]] BasicBatch() = default;
 
-		[[nodiscard]] explicit BasicBatch(const Core::Vulkan::Context& context, const std::size_t vertexSize, VkSampler sampler) :
-					BatchInterface{context, vertexSize, sampler}{
+		[[nodiscard]] explicit BasicBatch(const Core::Vulkan::Context& context, const std::size_t vertexSize, VkSampler sampler,
+			const QuadSubmission submission = QuadSubmission::vertices) :
+					BatchInterface{context, vertexSize, sampler, submission}{
 			for(auto& frame : frames)static_cast<VerticesDataBase&>(frame) = {*this};
 		}
 
@@ -383,9 +531,11 @@ namespace Graphic{
 				.pBufferMemoryBarriers = barriers.data(),
 			};
 
+			const bool instanced = submission == QuadSubmission::instances;
+
 			new(commandUnit.indirectBuffer.getMappedData()) VkDrawIndexedIndirectCommand{
-				.indexCount = transferCount * IndicesGroupCount,
-				.instanceCount = 1,
+				.indexCount = instanced ? IndicesGroupCount : transferCount * IndicesGroupCount,
+				.instanceCount = instanced ? transferCount : 1,
 				.firstIndex = 0,
 				.vertexOffset = 0,
 				.firstInstance = 0
@@ -403,13 +553,32 @@ namespace Graphic{
 								  scopedCommand, commandUnit.vertexBuffer.get(), transferCount * unitOffset);
 				}
 				commandUnit.indirectBuffer.cmdFlushToDevice(scopedCommand, sizeof(VkDrawIndexedIndirectCommand));
-				commandUnit.descriptorBuffer_Double.cmdFlushToDevice(scopedCommand, commandUnit.descriptorBuffer_Double.size);
+				if(!commandUnit.textureTable){
+					commandUnit.descriptorBuffer_Double.cmdFlushToDevice(scopedCommand, commandUnit.descriptorBuffer_Double.size);
+				}
 
 				frameData->transferDoneEvent.cmdSet(scopedCommand, dependencyInfo);
 			}
 		}
 	};
 
+	void VerticesDataBase::reallocate(const BatchInterface& batch, const VkDeviceSize size, const std::size_t keptSize){
+		Core::Vulkan::StagingBuffer next{
+			batch.context->physicalDevice,
+			batch.context->device,
+			size,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+			VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		};
+
+		void* nextData = next.memory.map_noInvalidation();
+		std::memcpy(nextData, vertData, keptSize);
+
+		buffer = std::move(next);
+		vertData = nextData;
+	}
+
 	template <std::derived_from<VerticesDataBase> VerticesData>
 	VerticesDataBase::VerticesDataBase(const BasicBatch<VerticesData>& batch) :
 		buffer{
@@ -20,9 +20,32 @@ namespace Graphic{
 		}
 	};
 
+	/**
+	 * @brief Batch owned by a single thread.
+	 *
+	 * A frame grows its staging memory instead of being split when it runs out of quads, up to @link BatchMaxGrowGroupCount @endlink,
+	 * so a frame is usually submitted with a single transfer and a single draw. The units grow along, see @link reserveUnits @endlink.
+	 */
 	export struct Batch_Exclusive : BasicBatch<ExclusiveVerticesData>{
+	private:
+		/** @brief see @link drawAfter @endlink */
+		Batch_Exclusive* predecessor{};
+
+	public:
 		using BasicBatch::BasicBatch;
 
+		/**
+		 * @brief The batches draw into the same attachments, this one as a later pass: before a frame of this batch is submitted,
+		 * `other` submits what it holds. Acquiring from either never flushes the other, the order within a pass is up to the depth test.
+		 */
+		void drawAfter(Batch_Exclusive& other) noexcept{
+			predecessor = &other;
+		}
+
+		[[nodiscard]] bool hasPending() const noexcept{
+			return !pendingDrawCalls.empty() || !frames[currentIndex].empty();
+		}
+
 		void consumeAll(){
 			while(true){
 				if(!consumeOne())break;
@@ -42,12 +65,18 @@ namespace Graphic{
 				return false;
 			}
 
+			if(predecessor && predecessor->hasPending()){
+				predecessor->consumeAll();
+			}
+
 			SubmittedDrawCall topDrawCall = pendingDrawCalls.front();
 			pendingDrawCalls.pop();
 
 			const auto index = units.get_index();
 			CommandUnit& commandUnit = units++;
 
+			reserveUnits(topDrawCall.frameData->getCount());
+
 			if(topDrawCall.usedImages != commandUnit.usedImages_prev){
 				commandUnit.updateDescriptorSets(topDrawCall.usedImages, sampler);
 				commandUnit.usedImages_prev = topDrawCall.usedImages;
@@ -67,8 +96,12 @@ namespace Graphic{
 			ImageIndex imageIndex = getMappedImageIndex(imageView);
 
 			while(imageIndex == InvalidImageIndex){
-				toNextVerticesData(currentIndex);
-				clearImageState();
+				if(textureTable){
+					recycleTextureTable();
+				}else{
+					toNextVerticesData(currentIndex);
+					clearImageState();
+				}
 
 				imageIndex = getMappedImageIndex(imageView);
 			}
@@ -79,6 +112,20 @@ namespace Graphic{
 
 
 	private:
+		/**
+		 * @brief bindless mode only, every slot is taken: submit the quads drawn with them and start the table over
+		 */
+		void recycleTextureTable(){
+			textureTable->beginRecycle();
+
+			consumeAll();
+			for(const auto& unit : units){
+				unit.fence.wait();
+			}
+
+			textureTable->endRecycle();
+		}
+
 		std::tuple<std::byte*, std::size_t> acquireValidSegments(const std::size_t count){
 			std::pair<std::byte*, std::size_t> rst{};
 
@@ -91,7 +138,13 @@ namespace Graphic{
 					return rst;
 				}
 
-				frame.undo(rst.second);
+				frame.undo(count);
+
+				if(const std::size_t required = frame.getCount() + count; required <= BatchMaxGrowGroupCount){
+					frame.reserve(*this, required, unitOffset);
+					continue;
+				}
+
 				toNextVerticesData(currentIndex);
 			}
 		}
@@ -1,6 +1,7 @@
 module;
 
 #include <vulkan/vulkan.h>
+#include "../src/arc/core/profiler.hpp"
 
 export module Graphic.Batch.MultiThread;
 
@@ -11,63 +12,187 @@ import ext.array_queue;
 import ext.circular_array;
 
 import ext.cond_atomic;
+import Core.Profiler;
 
 export namespace Graphic{
 	class LockableVerticesData : public UniversalVerticesData<true>{
-		std::shared_mutex capturedMutex{};
+		/** @brief filled in order, a slot never changes until the frame is activated again */
+		std::array<std::atomic<VkImageView>, BatchInterface::MaximumAllowedSamplersSize> usedImages{};
 
 	public:
 		[[nodiscard]] LockableVerticesData() = default;
 
-		[[nodiscard]] std::shared_lock<decltype(capturedMutex)> capture(){
-			return std::shared_lock{capturedMutex};
+		/**
+		 * @brief zero the whole staging memory, unused tails of reserved chunks then draw nothing
+		 */
+		void clearAll(const std::ptrdiff_t unitOffset) noexcept{
+			std::memset(vertData, 0, unitOffset * capacity);
+		}
+
+		/**
+		 * @brief lock free, find the slot of the image or take the first empty one
+		 */
+		[[nodiscard]] ImageIndex mapImage(VkImageView imageView) noexcept{
+			for(const auto& [index, slot] : usedImages | std::views::enumerate){
+				VkImageView cur = slot.load(std::memory_order::acquire);
+
+				if(!cur && slot.compare_exchange_strong(cur, imageView, std::memory_order::acq_rel)){
+					return static_cast<ImageIndex>(index);
+				}
+
+				if(cur == imageView){
+					return static_cast<ImageIndex>(index);
+				}
+			}
+
+			return BatchInterface::InvalidImageIndex;
 		}
 
-		[[nodiscard]] std::pair<bool, std::unique_lock<decltype(capturedMutex)>> tryCaptureUnique(){
-			if(capturedMutex.try_lock()){
-				return {true, std::unique_lock{capturedMutex, std::adopt_lock}};
-			}else{
-				return {false, {}};
+		[[nodiscard]] BatchInterface::ImageSet getUsedImages() const noexcept{
+			BatchInterface::ImageSet images{};
+			for(const auto& [image, slot] : std::views::zip(images, usedImages)){
+				image = slot.load(std::memory_order::acquire);
 			}
+			return images;
 		}
-		[[nodiscard]] std::unique_lock<decltype(capturedMutex)> captureUnique(){
-			return std::unique_lock{capturedMutex};
+
+		void setUsedImages(const BatchInterface::ImageSet& images) noexcept{
+			for(const auto& [image, slot] : std::views::zip(images, usedImages)){
+				slot.store(image, std::memory_order::relaxed);
+			}
 		}
 	};
 
 
 	//TODO support move assignment
 	//OPTM use shared index buffer instead of exclusive one
+	/**
+	 * @brief Batch that any thread can draw into concurrently
+	 *
+	 * Each writing thread reserves chunks of @link ChunkGroupCount @endlink quads from the current frame with one atomic add
+	 * and keeps a local copy of the texture slots it has seen, so drawing a quad normally touches thread owned memory only.
+	 * A write is guarded by a per-thread capture counter, the frame is transferred only after every capture on it is released.
+	 * The frame is swapped under @link overflowMutex @endlink when it runs out of quads, or texture slots unless the batch is bindless.
+	 * A frame that ran out of quads makes the next one grow, up to @link BatchMaxGrowGroupCount @endlink, and the units grow along
+	 * when it is consumed, so a steady load settles on one swap per frame instead of stalling on the device.
+	 */
 	struct Batch_MultiThread : BasicBatch<LockableVerticesData>{
+		/** @brief quads reserved per thread at once */
+		static constexpr std::uint32_t ChunkGroupCount{64};
+
 	private:
-		std::shared_mutex imageUpdateMutex{};
+		struct alignas(std::hardware_destructive_interference_size) WriterState{
+			/** @brief unreleased draw args of this thread, per frame */
+			std::array<std::atomic<std::uint32_t>, BufferSize> captures{};
+			/** @brief see @link FrameCapture::release @endlink */
+			std::atomic<bool> waited{};
 
-		std::mutex overflowMutex{};
+			std::uint64_t chunkGeneration{InvalidGeneration};
+			std::byte* chunkCursor{};
+			std::uint32_t chunkRemaining{};
+
+			std::uint64_t imageGeneration{InvalidGeneration};
+			ImageSet imageCache{};
+
+			/** @brief bindless mode only */
+			VkImageView lastImageView{};
+			ImageIndex lastImageIndex{};
+			std::uint64_t lastTableEpoch{};
+
+			WriterState* next{};
+		};
+
+		static constexpr std::uint64_t InvalidGeneration{~0ULL};
+
+		enum struct SwapCause{
+			flush,
+			outOfImages,
+			/** @brief the next frame grows */
+			outOfQuads
+		};
+
+		struct LocalWriters{
+			std::vector<std::pair<std::uint64_t, WriterState*>> entries{};
+			/** @brief value of @link destroyedCount @endlink when the entries were last swept */
+			std::uint64_t sweptAt{};
+		};
 
-		std::binary_semaphore semaphore_indexIncrement{1};
+		static inline std::atomic<std::uint64_t> lastBatchID{};
 
-		/** @brief shared lock when acquire valid draw args, unique lock when swap frame*/
-		std::shared_mutex frameSeekingMutex{};
+		/** @brief guards @link liveBatches @endlink, taken only on construction, destruction and sweeps */
+		static inline std::mutex registryMutex{};
+		static inline std::unordered_set<std::uint64_t> liveBatches{};
+		static inline std::atomic<std::uint64_t> destroyedCount{};
+
+		/**
+		 * @brief ids are never reused, a thread drops the entries of destroyed batches itself on its next lookup after any destruction
+		 */
+		static inline thread_local LocalWriters localWriters{};
+
+		std::uint64_t batchID{lastBatchID.fetch_add(1, std::memory_order::relaxed) + 1};
+		std::atomic<WriterState*> writers{};
+
+		/** @brief count of frame swaps, the frame being written is `generation % BufferSize` */
+		std::atomic<std::uint64_t> generation{};
+
+		/** @brief guards the frame swap only, never held while waiting for the writers of a frame */
+		std::mutex overflowMutex{};
 
 		std::mutex drawQueueMutex{};
 
+		/** @brief frames are transferred one at a time in queue order */
+		std::mutex consumeMutex{};
+
+		/** @brief bindless mode only, one writer recycles the texture table at a time */
+		std::mutex recycleMutex{};
+
+		/** @brief the unit each frame was last transferred by, guarded by @link consumeMutex @endlink */
+		std::array<const CommandUnit*, BufferSize> transferUnits{};
+
 	public:
-		using BasicBatch<LockableVerticesData>::BasicBatch;
+		[[nodiscard]] Batch_MultiThread(){
+			registerBatch();
+		}
+
+		[[nodiscard]] explicit Batch_MultiThread(const Core::Vulkan::Context& context, const std::size_t vertexSize, VkSampler sampler,
+			const QuadSubmission submission = QuadSubmission::vertices) :
+			BasicBatch{context, vertexSize, sampler, submission}{
+			for(auto& frame : frames){
+				frame.clearAll(unitOffset);
+			}
+
+			registerBatch();
+		}
+
+		~Batch_MultiThread(){
+			{
+				std::scoped_lock lock{registryMutex};
+				liveBatches.erase(batchID);
+				destroyedCount.fetch_add(1, std::memory_order::relaxed);
+			}
+
+			WriterState* cur = writers.load(std::memory_order::acquire);
+			while(cur){
+				delete std::exchange(cur, cur->next);
+			}
+		}
+
+		Batch_MultiThread(const Batch_MultiThread& other) = delete;
+		Batch_MultiThread(Batch_MultiThread&& other) noexcept = delete;
+		Batch_MultiThread& operator=(const Batch_MultiThread& other) = delete;
+		Batch_MultiThread& operator=(Batch_MultiThread&& other) noexcept = delete;
 
 		void consumeAll(){
+			PROFILE_ZONE("Batch_MultiThread::consumeAll");
+
 			while(true){
 				if(!consumeOne())break;
 			}
 
-			{
-				std::shared_lock lkm{frameSeekingMutex};
-				if(overflowMutex.try_lock()){
-					std::lock_guard lk{overflowMutex, std::adopt_lock};
-					if(!currentVerticesData().empty()){
-						toNextVerticesData(currentIndex, lkm, true);
-						consumeOne();
-					}
-				}
+			const std::uint64_t gen = generation.load(std::memory_order::acquire);
+			if(!frames[gen % BufferSize].empty()){
+				toNextVerticesData(gen, SwapCause::flush);
+				consumeOne();
 			}
 		}
 
@@ -75,201 +200,343 @@ export namespace Graphic{
 		 * @brief multi call is allowed, do nothing when there is no frame valid
 		 */
 		bool consumeOne(){
-			SubmittedDrawCall topDrawCall;
+			std::lock_guard lk{consumeMutex};
+			return consumeFront(nullptr);
+		}
 
-			{
-				std::lock_guard lkq{drawQueueMutex};
+		/**
+		 * @return at most `count` quads, the frame stays untransferred until the returned capture is released
+		 */
+		[[nodiscard]] LockableDrawArgs acquire(VkImageView imageView, const std::size_t count = 1){
+			if(!imageView) throw std::invalid_argument("ImageView is null");
 
-				if(pendingDrawCalls.empty()){
-					return false;
+			WriterState& local = localWriter();
+
+			while(true){
+				//no capture is held here, so the table may be recycled by the lookup
+				const ImageIndex tableIndex = textureTable ? tableIndexOf(local, imageView) : InvalidImageIndex;
+
+				if(auto rst = tryAcquire(local, imageView, tableIndex, count)){
+					return std::move(*rst);
 				}
+			}
+		}
 
-				topDrawCall = pendingDrawCalls.front();
-				pendingDrawCalls.pop();
+		/**
+		 * @brief Guarantee obtain all required draw data space within one call
+		 *
+		 * The captures of the earlier chunks are held while the later ones are acquired, so the frame swaps this causes
+		 * never take a lock a consuming thread holds while it waits for writers. `count` should not span every buffered frame.
+		 */
+		[[nodiscard]] std::vector<LockableDrawArgs> acquireOnce(VkImageView imageView, const std::size_t count){
+			if(!imageView) throw std::invalid_argument("ImageView is null");
+
+			WriterState& local = localWriter();
+
+			std::vector<LockableDrawArgs> drawArgs{};
+			drawArgs.reserve(count / ChunkGroupCount + 2);
+
+			while(true){
+				const ImageIndex tableIndex = textureTable ? tableIndexOf(local, imageView) : InvalidImageIndex;
+
+				std::size_t remaining = count;
+				while(remaining > 0){
+					auto rst = tryAcquire(local, imageView, tableIndex, remaining);
+					if(!rst) break;
+
+					if(rst->validCount == 0){
+						throw std::invalid_argument("unable to acquire draw arguments");
+					}
+
+					remaining -= rst->validCount;
+					drawArgs.push_back(std::move(*rst));
+				}
+
+				if(remaining == 0) return drawArgs;
+
+				//the table is being recycled, the chunks taken so far stay zeroed and draw nothing
+				drawArgs.clear();
 			}
+		}
 
-			auto index = units.get_index();
-			CommandUnit& commandUnit = units++;
+	private:
+		void registerBatch(){
+			std::scoped_lock lock{registryMutex};
+			liveBatches.insert(batchID);
+		}
 
-			if(topDrawCall.usedImages != commandUnit.usedImages_prev){
-				commandUnit.updateDescriptorSets(topDrawCall.usedImages, sampler);
-				commandUnit.usedImages_prev = topDrawCall.usedImages;
+		static void evictStaleWriters(){
+			std::scoped_lock lock{registryMutex};
+			localWriters.sweptAt = destroyedCount.load(std::memory_order::relaxed);
+			std::erase_if(localWriters.entries, [](const std::pair<std::uint64_t, WriterState*>& entry){
+				return !liveBatches.contains(entry.first);
+			});
+		}
+
+		[[nodiscard]] WriterState& localWriter(){
+			if(destroyedCount.load(std::memory_order::relaxed) != localWriters.sweptAt){
+				evictStaleWriters();
 			}
 
-			recordTransferCommand(topDrawCall.frameData, commandUnit);
-			topDrawCall.frameData->setTransferring();
+			for(const auto& [id, state] : localWriters.entries){
+				if(id == batchID) return *state;
+			}
 
-			submitCommand(commandUnit, index);
+			auto* state = new WriterState{};
+			state->next = writers.load(std::memory_order::relaxed);
+			while(!writers.compare_exchange_weak(state->next, state, std::memory_order::release, std::memory_order::relaxed)){}
 
-			return true;
+			localWriters.entries.emplace_back(batchID, state);
+			return *state;
 		}
 
-		[[nodiscard]] LockableDrawArgs acquire(VkImageView imageView, const std::size_t count = 1){
-			if(!imageView) throw std::invalid_argument("ImageView is null");
+		/**
+		 * @return null if the texture table changed since `tableIndex` was looked up, no capture is held then
+		 */
+		[[nodiscard]] std::optional<LockableDrawArgs> tryAcquire(WriterState& local, VkImageView imageView, const ImageIndex tableIndex, const std::size_t count){
+			while(true){
+				const std::uint64_t gen = generation.load(std::memory_order::acquire);
+				const std::size_t frameIndex = gen % BufferSize;
+				LockableVerticesData& frame = frames[frameIndex];
+
+				//pairs with the swap, either the swap sees this capture or this thread sees the swap
+				local.captures[frameIndex].fetch_add(1, std::memory_order::seq_cst);
+				if(generation.load(std::memory_order::seq_cst) != gen){
+					FrameCapture::release(local.captures[frameIndex], local.waited);
+					continue;
+				}
+
+				//the slots were recycled since the lookup, the index may name another view now
+				if(textureTable && textureTable->getEpoch() != local.lastTableEpoch){
+					FrameCapture::release(local.captures[frameIndex], local.waited);
+					return std::nullopt;
+				}
 
-			std::shared_lock dependencyLk{frameSeekingMutex};
-			ImageIndex imageIndex = getMappedImageIndex(imageView);
+				const ImageIndex imageIndex = textureTable ? tableIndex : mapImage(local, frame, gen, imageView);
+				if(imageIndex == InvalidImageIndex){
+					FrameCapture::release(local.captures[frameIndex], local.waited);
+					toNextVerticesData(gen, SwapCause::outOfImages);
+					continue;
+				}
 
-			while(imageIndex == InvalidImageIndex){
-				if(overflowMutex.try_lock()){
-					std::lock_guard lk{overflowMutex, std::adopt_lock};
+				if(local.chunkGeneration != gen || local.chunkRemaining == 0){
+					const auto [ptr, reserved] = frame.acquire(std::max<std::size_t>(count, ChunkGroupCount), unitOffset);
 
-					toNextVerticesData(currentIndex, dependencyLk);
+					if(reserved == 0){
+						local.chunkGeneration = InvalidGeneration;
+						FrameCapture::release(local.captures[frameIndex], local.waited);
+						toNextVerticesData(gen, SwapCause::outOfQuads);
+						continue;
+					}
 
-					std::unique_lock lockWrite{imageUpdateMutex};
-					clearImageState();
+					local.chunkGeneration = gen;
+					local.chunkCursor = ptr;
+					local.chunkRemaining = static_cast<std::uint32_t>(reserved);
 				}
 
-				imageIndex = getMappedImageIndex(imageView);
+				const std::uint32_t validCount = std::min(static_cast<std::uint32_t>(count), local.chunkRemaining);
+				std::byte* const data = local.chunkCursor;
+
+				local.chunkCursor += validCount * unitOffset;
+				local.chunkRemaining -= validCount;
+
+				return LockableDrawArgs{imageIndex, validCount, data, FrameCapture{local.captures[frameIndex], local.waited}};
 			}
+		}
+
+		/**
+		 * @brief bindless mode only, table slots are persistent so the cache survives frame swaps
+		 */
+		[[nodiscard]] ImageIndex tableIndexOf(WriterState& local, VkImageView imageView){
+			while(true){
+				//a freed slot may name another view now, the epoch is read before the lookup
+				const std::uint64_t epoch = textureTable->getEpoch();
+				if(local.lastImageView == imageView && local.lastTableEpoch == epoch){
+					return local.lastImageIndex;
+				}
+
+				if(const ImageIndex index = textureTable->indexOf(imageView); index != InvalidImageIndex){
+					local.lastImageIndex = index;
+					local.lastImageView = imageView;
+					local.lastTableEpoch = epoch;
+					return index;
+				}
 
-			auto [ptr, sz, lk] = acquireValidSegments(dependencyLk, count);
-			return {imageIndex, static_cast<std::uint32_t>(sz), ptr, std::move(lk)};
+				recycleTextureTable();
+			}
 		}
 
 		/**
-		 * @brief Guarantee obtain all required draw data space within one call
+		 * @brief bindless mode only, the calling thread must hold no capture
+		 *
+		 * Writers that looked the old slots up either see the epoch moved after their capture and look up again,
+		 * or hold a capture of a frame flushed here, which is waited for before the slots are handed out again.
 		 */
-		[[nodiscard]] std::vector<LockableDrawArgs> acquireOnce(VkImageView imageView, std::size_t count){
-			std::vector<LockableDrawArgs> drawArgs{};
-			drawArgs.reserve(count / 4 + 1);
+		void recycleTextureTable(){
+			std::lock_guard lk{recycleMutex};
+
+			//recycled by another writer meanwhile, or a slot was freed
+			if(!textureTable->isFull()) return;
+
+			textureTable->beginRecycle();
 
-			while(count > 0){
-				const auto& rst = drawArgs.emplace_back(acquire(imageView, count));
-				if(rst.validCount == 0){
-					throw std::invalid_argument("unable to acquire draw arguments");
+			//swapped even if it looks empty, a writer may have captured it without reserving quads yet
+			toNextVerticesData(generation.load(std::memory_order::acquire), SwapCause::flush);
+			consumeAll();
+
+			{
+				//fences are reset under the consume lock
+				std::lock_guard lkc{consumeMutex};
+				for(const auto& unit : units){
+					unit.fence.wait();
 				}
-				count -= rst.validCount;
 			}
 
-			return drawArgs;
+			textureTable->endRecycle();
 		}
 
-	private:
-		[[nodiscard]] ImageIndex getMappedImageIndex(VkImageView imageView){
-			std::shared_lock lockRead{imageUpdateMutex};
+		[[nodiscard]] static ImageIndex mapImage(WriterState& local, LockableVerticesData& frame, const std::uint64_t gen, VkImageView imageView) noexcept{
+			if(local.imageGeneration != gen){
+				local.imageGeneration = gen;
+				local.imageCache.fill(nullptr);
+			}
 
-			if(imageView == lastUsedImageView){
-				return lastImageIndex;
+			for(const auto& [index, image] : local.imageCache | std::views::enumerate){
+				if(image == imageView) return static_cast<ImageIndex>(index);
 			}
 
-			for(const auto& [index, usedImage] : currentUsedImages | std::views::enumerate){
-				if(usedImage == imageView){
-					return index;
-				}
+			const ImageIndex index = frame.mapImage(imageView);
+			if(index != InvalidImageIndex){
+				local.imageCache[index] = imageView;
+			}
 
-				if(!usedImage){
-					lockRead.unlock();
-					std::unique_lock lockWrite{imageUpdateMutex};
+			return index;
+		}
 
-					if(!usedImage){
-						usedImage = lastUsedImageView = imageView;
-						lastImageIndex = index;
-						return index;
-					}
+		/**
+		 * @brief call with @link consumeMutex @endlink held
+		 * @param expected pops the front only if it is this frame, any frame if null
+		 */
+		bool consumeFront(const LockableVerticesData* expected){
+			SubmittedDrawCall topDrawCall;
+
+			{
+				std::lock_guard lkq{drawQueueMutex};
 
-					if(usedImage == imageView) return index;
+				if(pendingDrawCalls.empty() || (expected && pendingDrawCalls.front().frameData != expected)){
+					return false;
 				}
+
+				topDrawCall = pendingDrawCalls.front();
+				pendingDrawCalls.pop();
+
+				//marked while still guarded, a swap never sees the frame neither queued nor transferring
+				topDrawCall.frameData->setTransferring();
 			}
 
-			return InvalidImageIndex;
-		}
+			//slots may still be taken until the last writer of the frame leaves
+			waitForWriters(*topDrawCall.frameData);
+			topDrawCall.usedImages = topDrawCall.frameData->getUsedImages();
 
-		std::tuple<std::byte*, std::size_t, std::shared_lock<std::shared_mutex>> acquireValidSegments(
-			std::shared_lock<std::shared_mutex>& externalLock, std::size_t count){
-			std::pair<std::byte*, std::size_t> rst{};
+			auto index = units.get_index();
+			CommandUnit& commandUnit = units++;
 
-			while(true){
-				auto& frame = currentVerticesData();
+			reserveUnits(topDrawCall.frameData->getCount());
 
-				rst = frame.acquire(count, unitOffset);
+			if(topDrawCall.usedImages != commandUnit.usedImages_prev){
+				commandUnit.updateDescriptorSets(topDrawCall.usedImages, sampler);
+				commandUnit.usedImages_prev = topDrawCall.usedImages;
+			}
 
-				if(rst.second == count){
-					return {rst.first, count, frame.capture()};
-				}
+			recordTransferCommand(topDrawCall.frameData, commandUnit);
+			transferUnits[topDrawCall.frameData - frames.data()] = &commandUnit;
 
-				if(overflowMutex.try_lock()){
-					std::lock_guard lk{overflowMutex, std::adopt_lock};
+			submitCommand(commandUnit, index);
 
-					toNextVerticesData(currentIndex, externalLock);
-				}
-			}
+			return true;
 		}
 
-		LockableVerticesData& currentVerticesData() noexcept{
-			semaphore_indexIncrement.acquire();
-			auto& f = frames[currentIndex];
-			semaphore_indexIncrement.release();
-			return f;
+		[[nodiscard]] bool isQueued(const LockableVerticesData& frame){
+			std::lock_guard lkq{drawQueueMutex};
+			return !pendingDrawCalls.empty() && pendingDrawCalls.front().frameData == &frame;
 		}
 
 		/**
-		* @param currentFrameIndex atomic usage
-		* @param acquirer requester thread lock
-		* @param checkState
-		* @return next frame
-		*/
-		LockableVerticesData& toNextVerticesData(const std::size_t currentFrameIndex, std::shared_lock<std::shared_mutex>& acquirer, const bool checkState = true){
+		 * @brief blocks until every capture on the frame is released, the last release of a writer wakes this
+		 */
+		void waitForWriters(const LockableVerticesData& frame) const noexcept{
+			const std::size_t frameIndex = &frame - frames.data();
+
+			for(WriterState* cur = writers.load(std::memory_order::acquire); cur; cur = cur->next){
+				std::atomic<std::uint32_t>& captures = cur->captures[frameIndex];
+
+				cur->waited.store(true, std::memory_order::seq_cst);
+				for(std::uint32_t count; (count = captures.load(std::memory_order::seq_cst)) != 0;){
+					captures.wait(count, std::memory_order::seq_cst);
+				}
+				cur->waited.store(false, std::memory_order::relaxed);
+			}
+		}
+
+		/**
+		 * @brief move writers to the next frame and queue the current one, a no-op if another thread already swapped
+		 * @param expectedGeneration the generation the caller failed to write into
+		 * @param cause @link SwapCause::outOfImages @endlink starts the next frame with no texture slots instead of the current ones
+		 */
+		void toNextVerticesData(const std::uint64_t expectedGeneration, const SwapCause cause){
+			const std::size_t currentFrameIndex = expectedGeneration % BufferSize;
 			const std::size_t nextFrameIndex = (currentFrameIndex + 1) % BufferSize;
 			LockableVerticesData& currentFrame = frames[currentFrameIndex];
 			LockableVerticesData& nextFrame = frames[nextFrameIndex];
 
-			acquirer.unlock();
+			while(true){
+				{
+					std::lock_guard lk{overflowMutex};
 
-			semaphore_indexIncrement.acquire();
-			if(currentFrameIndex == currentIndex){
+					if(generation.load(std::memory_order::relaxed) != expectedGeneration) return;
 
-				//Consume if overflow
-				//TODO post tasks to other thread and wait here
-				if(checkState){
-					while(!nextFrame.isAcquirable()){
-						consumeOne();
+					if(nextFrame.isAcquirable() || (!isQueued(nextFrame) && nextFrame.isNotTransferring())){
+						if(!nextFrame.isAcquirable()) nextFrame.activate(unitOffset);
 
-						if(nextFrame.isNotTransferring()){
-							nextFrame.activate(unitOffset);
-							break;
+						//nobody writes to or transfers the next frame here, capacities only grow so it settles on the peak load
+						if(const std::size_t grown = std::min(currentFrame.getCapacity() * 2, BatchMaxGrowGroupCount);
+							cause == SwapCause::outOfQuads && grown > nextFrame.getCapacity()){
+							nextFrame.reserve(*this, grown, unitOffset);
+							nextFrame.clearAll(unitOffset);
 						}
-					}
-				}
-
-				//Check if already swapped
-				{
-					std::unique_lock ulk{frameSeekingMutex};
 
-					//swap index to next buffer
-					currentIndex = nextFrameIndex;
+						//keep the slot order, so the descriptors of the next frame usually need no update
+						nextFrame.setUsedImages(cause == SwapCause::outOfImages ? ImageSet{} : currentFrame.getUsedImages());
 
-					ulk.unlock();
-					acquirer.lock();
+						//forbid write, enter waiting stage
+						currentFrame.endAcquire();
+						currentIndex = nextFrameIndex;
+						generation.store(expectedGeneration + 1, std::memory_order::seq_cst);
 
-					semaphore_indexIncrement.release();
+						std::lock_guard lkq{drawQueueMutex};
+						pendingDrawCalls.emplace(&currentFrame);
+						return;
+					}
 				}
 
-				//forbid write, enter waiting stage
-				//don't wait the capture of each frame
-				currentFrame.endAcquire();
-				{
-					std::lock_guard lkq{drawQueueMutex};
-					{
-						std::shared_lock lk{imageUpdateMutex};
-						pendingDrawCalls.emplace(&currentFrame, currentUsedImages);
+				//Consume if overflow, outside the swap lock: the caller may hold captures of earlier frames, see acquireOnce.
+				//The consume lock is only tried, its holder may be waiting for those captures, the loop then polls the device instead
+				if(std::unique_lock lk{consumeMutex, std::try_to_lock}; lk){
+					//the next frame is the oldest one, if it is queued it is the front
+					if(!consumeFront(&nextFrame)){
+						//in flight, every fence reset under the lock is submitted before it is released
+						if(const CommandUnit* unit = transferUnits[nextFrameIndex]) unit->fence.wait();
 					}
+				}else{
+					std::this_thread::yield();
 				}
-
-
-			} else{
-				semaphore_indexIncrement.release();
-				acquirer.lock();
 			}
-
-			return nextFrame;
 		}
 
 		void recordTransferCommand(LockableVerticesData* frameData, CommandUnit& commandUnit) const{
 			std::uint32_t count{};
 
 			if(frameData){
-				auto lk = frameData->captureUnique();
 				count = frameData->getCount();
 			}
 
@@ -0,0 +1,203 @@
+module;
+
+#include <vulkan/vulkan.h>
+
+#ifndef BINDLESS_TEXTURES
+#define BINDLESS_TEXTURES 1
+#endif
+
+export module Graphic.Batch.TextureTable;
+
+export import Core.Vulkan.DescriptorBuffer;
+export import Core.Vulkan.DescriptorLayout;
+import Core.Vulkan.Image;
+import Graphic.BatchData;
+
+import std;
+
+export namespace Graphic{
+	/**
+	 * @brief Batches address textures through a @link TextureTable @endlink instead of a per frame sampler set,
+	 * shaders are compiled with `BindlessTextures` defined then.
+	 */
+	constexpr bool BindlessTextures = BINDLESS_TEXTURES;
+
+	/**
+	 * @brief A persistent descriptor array of every image view a batch has drawn with.
+	 *
+	 * A view takes a slot the first time it is looked up and keeps it until it is destroyed or the table is recycled,
+	 * so frames never break because of the textures they use. Slots are only appended, writing a new one
+	 * while the GPU reads the others is safe with descriptor buffers, no update after bind pool is involved.
+	 *
+	 * A destroyed view leaves the table through @link Core::Vulkan::ImageView::addDestroyListener @endlink,
+	 * its slot is given to the next new view and the @link getEpoch @endlink advances so index caches are dropped.
+	 *
+	 * Once every slot is taken, lookups of new views return @link InvalidIndex @endlink and the owning batch recycles the table:
+	 * @link beginRecycle @endlink, submit every quad drawn with the old slots and wait for the device, then @link endRecycle @endlink.
+	 */
+	class TextureTable{
+	public:
+		/** @brief the whole @link ImageIndex @endlink range except the invalid index */
+		static constexpr std::uint32_t Capacity{std::numeric_limits<ImageIndex>::max()};
+
+		/** @brief the same value as the invalid image index of the batches */
+		static constexpr ImageIndex InvalidIndex{static_cast<ImageIndex>(Capacity)};
+
+	private:
+		VkSampler sampler{};
+
+		Core::Vulkan::DescriptorLayout layout{};
+		Core::Vulkan::DescriptorBuffer descriptorBuffer{};
+
+		mutable std::shared_mutex mutex{};
+		std::unordered_map<VkImageView, ImageIndex> indices{};
+		std::vector<ImageIndex> freeSlots{};
+		ImageIndex slotCount{};
+
+		/** @brief no slot is handed out while the quads drawn with the old ones are still pending */
+		bool recycling{};
+
+		std::atomic<std::uint64_t> epoch{};
+
+	public:
+		/**
+		 * @brief the set layout of the table, batch pipelines should build theirs with the same function to stay compatible
+		 */
+		static void defineLayout(Core::Vulkan::DescriptorLayout& layout){
+			layout.builder.push_seq(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, Capacity);
+			layout.pushBindingFlag(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT);
+			layout.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+		}
+
+		[[nodiscard]] TextureTable() = default;
+
+		[[nodiscard]] TextureTable(VkPhysicalDevice physicalDevice, VkDevice device, VkSampler sampler) :
+			sampler{sampler},
+			layout{device, defineLayout},
+			descriptorBuffer{physicalDevice, device, layout, layout.size()}{
+			//host coherent, kept mapped so registering a view is a plain memory write
+			descriptorBuffer.map();
+
+			Core::Vulkan::ImageView::addDestroyListener(this, [this](VkImageView imageView){
+				release(imageView);
+			});
+		}
+
+		~TextureTable(){
+			Core::Vulkan::ImageView::removeDestroyListener(this);
+			descriptorBuffer.unmap();
+		}
+
+		TextureTable(const TextureTable& other) = delete;
+		TextureTable(TextureTable&& other) noexcept = delete;
+		TextureTable& operator=(const TextureTable& other) = delete;
+		TextureTable& operator=(TextureTable&& other) noexcept = delete;
+
+		/**
+		 * @brief thread safe, registers the view if it has no slot yet
+		 * @return @link InvalidIndex @endlink if the view has no slot and none is free, or the table is being recycled
+		 */
+		[[nodiscard]] ImageIndex indexOf(VkImageView imageView){
+			{
+				std::shared_lock lk{mutex};
+				if(const auto itr = indices.find(imageView); itr != indices.end()){
+					return itr->second;
+				}
+			}
+
+			std::unique_lock lk{mutex};
+
+			if(const auto itr = indices.find(imageView); itr != indices.end()){
+				return itr->second;
+			}
+
+			if(recycling || (freeSlots.empty() && slotCount == Capacity)){
+				return InvalidIndex;
+			}
+
+			ImageIndex slot;
+			if(freeSlots.empty()){
+				slot = slotCount++;
+			}else{
+				slot = freeSlots.back();
+				freeSlots.pop_back();
+			}
+
+			const auto itr = indices.try_emplace(imageView, slot).first;
+
+			descriptorBuffer.loadImage(0, itr->second, VkDescriptorImageInfo{
+				.sampler = sampler,
+				.imageView = imageView,
+				.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+			});
+
+			return itr->second;
+		}
+
+		/**
+		 * @brief thread safe, frees the slot of the view, a no-op if it has none
+		 *
+		 * The device must be done with the frames drawing it, which destroying the view requires anyway.
+		 */
+		void release(VkImageView imageView){
+			std::unique_lock lk{mutex};
+
+			const auto itr = indices.find(imageView);
+			if(itr == indices.end()) return;
+
+			freeSlots.push_back(itr->second);
+			indices.erase(itr);
+			epoch.fetch_add(1, std::memory_order::release);
+		}
+
+		[[nodiscard]] bool isFull() const{
+			std::shared_lock lk{mutex};
+			return freeSlots.empty() && slotCount == Capacity;
+		}
+
+		/**
+		 * @brief thread safe, forgets every view, lookups return @link InvalidIndex @endlink until @link endRecycle @endlink
+		 *
+		 * Indices handed out before stay valid on the device until then, the descriptors are only rewritten afterwards.
+		 */
+		void beginRecycle(){
+			std::unique_lock lk{mutex};
+
+			indices.clear();
+			freeSlots.clear();
+			slotCount = 0;
+			recycling = true;
+			epoch.fetch_add(1, std::memory_order::seq_cst);
+		}
+
+		/**
+		 * @brief the device must be done with every frame drawn before @link beginRecycle @endlink
+		 */
+		void endRecycle(){
+			std::unique_lock lk{mutex};
+
+			recycling = false;
+			epoch.fetch_add(1, std::memory_order::seq_cst);
+		}
+
+		/**
+		 * @brief advances whenever a slot is freed, an index cached at an older epoch may name another view now
+		 */
+		[[nodiscard]] std::uint64_t getEpoch() const noexcept{
+			return epoch.load(std::memory_order::seq_cst);
+		}
+
+		[[nodiscard]] std::size_t size() const{
+			std::shared_lock lk{mutex};
+			return indices.size();
+		}
+
+		[[nodiscard]] const Core::Vulkan::DescriptorLayout& getLayout() const noexcept{
+			return layout;
+		}
+
+		[[nodiscard]] VkDescriptorBufferBindingInfoEXT getBindInfo(const VkBufferUsageFlags usage) const{
+			return descriptorBuffer.getBindInfo(usage);
+		}
+	};
+}
@@ -370,6 +370,134 @@ export namespace Graphic::Draw{
 		};
 	};
 
+#ifndef OnDefine
+	/**
+	 * @brief Writes one @link Instance_World @endlink per quad for batches with @link QuadSubmission::instances @endlink.
+	 *
+	 * Only the single coloured rectangles are here, gradients and polygon segments are not rectangles.
+	 */
+	template <>
+	struct Drawer<Instance_World>{
+		template <VertexModifier<Instance_World&> M>
+		static void quad(
+			const DrawParam<M>& param,
+			const Geom::Vec2 center, const Geom::Vec2 size, const Geom::Vec2 axis,
+			const Color& color){
+
+			assert(param.uv != nullptr);
+
+			Instance_World& instance = *new(param.dataPtr) Instance_World{
+				.position = center,
+				.size = size,
+				.axis = axis,
+				.textureParam = param.index,
+				.texCoord = {param.uv->v00, param.uv->v11},
+				.color = color
+			};
+
+			std::invoke(param.modifier, instance);
+		}
+
+		template <VertexModifier<Instance_World&> M>
+		static void rect(
+			const DrawParam<M>& param,
+			const Geom::Transform center,
+			const Geom::Vec2 size,
+			const Color& color
+		){
+			//the same extent as the vertex path
+			Drawer::quad(param, center.vec, size * .5f, {Math::cosDeg(center.rot), Math::sinDeg(center.rot)}, color);
+		}
+
+		template <VertexModifier<Instance_World&> M>
+		static void rectOrtho(
+			const DrawParam<M>& param,
+			const Geom::OrthoRectFloat& bound,
+			const Color& color
+		){
+			Drawer::quad(param, bound.getCenter(), bound.getSize(), {1, 0}, color);
+		}
+
+		template <VertexModifier<Instance_World&> M>
+		static void rectOrtho(
+			const DrawParam<M>& param,
+			const Geom::Vec2 pos,
+			const float size,
+			const Color& color
+		){
+			Drawer::rectOrtho(param, Geom::OrthoRectFloat{pos, size}, color);
+		}
+
+		struct Line{
+			template <VertexModifier<Instance_World&> M>
+			static void line(
+				const DrawParam<M>& param,
+				const float stroke,
+				const Geom::Vec2 src, const Geom::Vec2 dst,
+				const Color& c, const bool cap = true){
+				const Geom::Vec2 diff = dst - src;
+				const float len = diff.length();
+
+				Drawer::quad(param,
+					(src + dst) * .5f,
+					{cap ? len + stroke : len, stroke},
+					len > 0 ? diff / len : Geom::Vec2{1, 0},
+					c);
+			}
+
+			template <VertexModifier<Instance_World&> M>
+			static void lineAngleCenter(const DrawParam<M>& param,
+			                            const float stroke, const Geom::Transform trans, const float length, const Color& c,
+			                            const bool cap = true){
+				Drawer::quad(param, trans.vec,
+					{cap ? length + stroke : length, stroke},
+					{Math::cosDeg(trans.rot), Math::sinDeg(trans.rot)}, c);
+			}
+
+			template <VertexModifier<Instance_World&> M>
+			static void lineAngle(const DrawParam<M>& param,
+			                      const float stroke, const Geom::Transform trans, const float length, const Color& c,
+			                      const bool cap = true){
+				const Geom::Vec2 axis{Math::cosDeg(trans.rot), Math::sinDeg(trans.rot)};
+
+				Drawer::quad(param, trans.vec + axis * (length * .5f),
+					{cap ? length + stroke : length, stroke},
+					axis, c);
+			}
+
+			template <unsigned count, AutoAcquirableParam M, typename T>
+				requires requires{
+					requires count > 0;
+				}
+			static void circularPoly_fixed(
+				M& auto_param,
+				const float stroke,
+				const T& poly, const Color& color, const bool cap = true){
+
+				static_assert(std::convertible_to<decltype(poly[0]), Geom::Vec2>, "[x] should be converitible to vec2 for line drawing");
+
+				Geom::Vec2 last{poly[count - 1]};
+				for(unsigned i = 0; i < count; ++i){
+					const auto cur = poly[i];
+					Line::line(++auto_param, stroke, last, cur, color, cap);
+					last = cur;
+				}
+			}
+
+			template <AutoAcquirableParam M>
+			static void rectOrtho(
+				M& auto_param,
+				const float stroke,
+				const Geom::OrthoRectFloat& rect, const Color& color, const bool cap = true){
+				Line::line(++auto_param, stroke, rect.vert_00(), rect.vert_01(), color, cap);
+				Line::line(++auto_param, stroke, rect.vert_01(), rect.vert_11(), color, cap);
+				Line::line(++auto_param, stroke, rect.vert_11(), rect.vert_10(), color, cap);
+				Line::line(++auto_param, stroke, rect.vert_10(), rect.vert_00(), color, cap);
+			}
+		};
+	};
+#endif
+
 	inline const ImageViewRegion* WhiteRegion{};
 
 	struct DrawContext{
@@ -71,6 +71,10 @@ export namespace Graphic::Draw{
 		constexpr void operator()(type& v) const noexcept{
 			v.depth = depth;
 		}
+
+		constexpr void operator()(Instance_World& v) const noexcept{
+			v.depth = depth;
+		}
 	};
 
 	template <typename T, std::size_t GroupCount = 4>
@@ -89,9 +93,13 @@ export namespace Graphic::Draw{
 			// std::ranges::uninitialized_default_construct_n(t, GroupCount);
 		}
 
-		template <typename... Args, VertexModifier<T&> ModifyCallable = std::identity>
+		/**
+		 * @param Generator usually a @link VertexProjection @endlink, the arguments may convert to its attribute types
+		 */
+		template <typename Gen, VertexModifier<T&> ModifyCallable = std::identity, typename... Args>
+			requires std::invocable<const Gen&, T*, ModifyCallable, const Args&...>
 		constexpr void operator()(
-			const VertexProjection<T, std::decay_t<Args>...>& Generator,
+			const Gen& Generator,
 			ModifyCallable modifier,
 			const Args&... args
 		){
@@ -114,23 +122,17 @@ export namespace Graphic::Draw{
 			};
 	};
 
-	template <>
-	struct DefGenerator<Vertex_UI>{
-		static constexpr VertexProjection value{
-				&Vertex_UI::position,
-				&Vertex_UI::textureParam,
-				&Vertex_UI::color,
-				&Vertex_UI::texCoord,
-			};
-	};
-
-	template <>
-	struct DefGenerator<Vertex_World>{
+	/**
+	 * @brief the same argument order for every layout of a vertex, packed attributes convert from the full ones
+	 */
+	template <typename Vertex>
+		requires (ext::is_any_of<Vertex, Vertex_UI_F32, Vertex_UI_Packed, Vertex_World_F32, Vertex_World_Packed>)
+	struct DefGenerator<Vertex>{
 		static constexpr VertexProjection value{
-				&Vertex_World::position,
-				&Vertex_World::textureParam,
-				&Vertex_World::color,
-				&Vertex_World::texCoord,
+				&Vertex::position,
+				&Vertex::textureParam,
+				&Vertex::color,
+				&Vertex::texCoord,
 			};
 	};
 
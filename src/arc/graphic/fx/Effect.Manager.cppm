@@ -1,7 +1,13 @@
+module;
+
+#include "../src/arc/core/profiler.hpp"
+
 export module Graphic.Effect.Manager;
 
 export import Graphic.Effect;
 
+import Core.Profiler;
+
 import ext.object_pool;
 import ext.algo;
 import Geom.Rect_Orthogonal;
@@ -39,6 +45,8 @@ namespace Graphic{
 	public:
 
 		void update(const float delta_in_ticks) noexcept{
+			PROFILE_ZONE("EffectManager::update");
+
 			auto end = actives.end();
 			auto cur = actives.begin();
 
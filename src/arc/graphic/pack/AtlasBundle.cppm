@@ -0,0 +1,276 @@
+export module Graphic.AtlasBundle;
+
+import Core.File;
+import Graphic.Pixmap;
+import Graphic.BlockCompression;
+import Geom.Vector2D;
+import Geom.Rect_Orthogonal;
+import std;
+
+export namespace Graphic::AtlasBundle{
+	/**
+	 * @brief The pages of one atlas page packed offline with their named regions, loaded with one upload per page.
+	 *
+	 * Layout: @link Header @endlink, @link PageRecord @endlink for every page, @link RegionRecord @endlink for every region,
+	 * the names with the page name first, then the pixels of every page at an aligned offset so they are read from the mapping in place.
+	 * A block compressed page holds its whole mip chain, an RGBA page only the first level.
+	 */
+	constexpr std::uint32_t Magic{0x424c'5441}; //ATLB
+	constexpr std::uint32_t Version{2};
+
+	constexpr std::string_view Extension{".atlas"};
+
+	constexpr std::uint64_t DataAlignment{256};
+
+	enum struct PixelFormat : std::uint32_t{
+		rgba8,
+		bc4,
+		bc7,
+	};
+
+	[[nodiscard]] constexpr std::optional<BlockFormat> blockFormatOf(const PixelFormat format) noexcept{
+		switch(format){
+			case PixelFormat::bc4 : return BlockFormat::bc4;
+			case PixelFormat::bc7 : return BlockFormat::bc7;
+			default : return std::nullopt;
+		}
+	}
+
+	struct Header{
+		std::uint32_t magic{Magic};
+		std::uint32_t version{Version};
+		PixelFormat format{};
+		std::uint32_t pageWidth{};
+		std::uint32_t pageHeight{};
+		std::uint32_t pageCount{};
+		std::uint32_t regionCount{};
+		/** @brief the baked regions are apart by at least this much */
+		std::uint32_t margin{};
+		std::uint32_t pageNameSize{};
+		std::uint32_t namesSize{};
+		std::uint32_t mipLevels{1};
+	};
+
+	struct PageRecord{
+		std::uint64_t offset{};
+		std::uint64_t size{};
+	};
+
+	struct RegionRecord{
+		std::uint32_t page{};
+		std::uint32_t nameOffset{};
+		std::uint32_t nameSize{};
+		std::uint32_t x{};
+		std::uint32_t y{};
+		std::uint32_t width{};
+		std::uint32_t height{};
+	};
+
+	static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<PageRecord> && std::is_trivially_copyable_v<RegionRecord>);
+
+	struct Region{
+		std::string name{};
+		std::uint32_t page{};
+		Geom::OrthoRectUInt bound{};
+	};
+
+	struct RegionView{
+		std::string_view name{};
+		std::uint32_t page{};
+		Geom::OrthoRectUInt bound{};
+	};
+
+	[[nodiscard]] constexpr std::uint64_t pageSizeBytes(const Header& header) noexcept{
+		if(const auto block = blockFormatOf(header.format)){
+			return CompressedView::sizeBytes(*block, {header.pageWidth, header.pageHeight}, header.mipLevels);
+		}
+
+		return std::uint64_t{header.pageWidth} * header.pageHeight * Pixmap::Channels;
+	}
+
+	/**
+	 * @brief A checked bundle, the names and pixels point into the parsed bytes.
+	 */
+	class View{
+		Header header{};
+		std::span<const std::byte> bytes{};
+
+		friend std::optional<View> parse(std::span<const std::byte> bytes);
+
+		[[nodiscard]] constexpr std::size_t pagesOffset() const noexcept{
+			return sizeof(Header);
+		}
+
+		[[nodiscard]] constexpr std::size_t regionsOffset() const noexcept{
+			return pagesOffset() + std::size_t{header.pageCount} * sizeof(PageRecord);
+		}
+
+		[[nodiscard]] constexpr std::size_t namesOffset() const noexcept{
+			return regionsOffset() + std::size_t{header.regionCount} * sizeof(RegionRecord);
+		}
+
+	public:
+		[[nodiscard]] std::string_view pageName() const noexcept{
+			return {reinterpret_cast<const char*>(bytes.data() + namesOffset()), header.pageNameSize};
+		}
+
+		[[nodiscard]] Geom::USize2 pageSize() const noexcept{
+			return {header.pageWidth, header.pageHeight};
+		}
+
+		[[nodiscard]] std::uint32_t pageCount() const noexcept{
+			return header.pageCount;
+		}
+
+		[[nodiscard]] std::uint32_t regionCount() const noexcept{
+			return header.regionCount;
+		}
+
+		[[nodiscard]] std::uint32_t margin() const noexcept{
+			return header.margin;
+		}
+
+		[[nodiscard]] PixelFormat format() const noexcept{
+			return header.format;
+		}
+
+		/**
+		 * @return empty for an RGBA page
+		 */
+		[[nodiscard]] std::optional<CompressedView> compressedPage(const std::uint32_t index) const noexcept{
+			if(const auto block = blockFormatOf(header.format)){
+				return CompressedView{*block, pageSize(), header.mipLevels, pageData(index)};
+			}
+
+			return std::nullopt;
+		}
+
+		[[nodiscard]] std::span<const std::byte> pageData(const std::uint32_t index) const noexcept{
+			PageRecord record{};
+			std::memcpy(&record, bytes.data() + pagesOffset() + index * sizeof(PageRecord), sizeof(PageRecord));
+			return bytes.subspan(record.offset, record.size);
+		}
+
+		[[nodiscard]] RegionView region(const std::uint32_t index) const noexcept{
+			RegionRecord record{};
+			std::memcpy(&record, bytes.data() + regionsOffset() + index * sizeof(RegionRecord), sizeof(RegionRecord));
+
+			return {
+				std::string_view{reinterpret_cast<const char*>(bytes.data() + namesOffset() + record.nameOffset), record.nameSize},
+				record.page, Geom::OrthoRectUInt{record.x, record.y, record.width, record.height}
+			};
+		}
+	};
+
+	/**
+	 * @return empty if the bytes are not a bundle of this version or any record points out of them
+	 */
+	[[nodiscard]] std::optional<View> parse(const std::span<const std::byte> bytes){
+		View view{};
+		if(bytes.size() < sizeof(Header)) return std::nullopt;
+
+		std::memcpy(&view.header, bytes.data(), sizeof(Header));
+		view.bytes = bytes;
+
+		const Header& header = view.header;
+		if(header.magic != Magic || header.version != Version || header.format > PixelFormat::bc7) return std::nullopt;
+		if(header.pageWidth == 0 || header.pageHeight == 0) return std::nullopt;
+
+		//a full chain down to a single texel at most
+		const auto maxMipLevels = static_cast<std::uint32_t>(std::bit_width(std::max(header.pageWidth, header.pageHeight)));
+		if(header.mipLevels == 0 || header.mipLevels > maxMipLevels || (header.format == PixelFormat::rgba8 && header.mipLevels != 1)) return std::nullopt;
+		if(view.namesOffset() + header.namesSize > bytes.size() || header.pageNameSize > header.namesSize) return std::nullopt;
+
+		for(std::uint32_t i = 0; i < header.pageCount; ++i){
+			PageRecord record{};
+			std::memcpy(&record, bytes.data() + view.pagesOffset() + i * sizeof(PageRecord), sizeof(PageRecord));
+
+			if(record.size != pageSizeBytes(header) || record.offset > bytes.size() || record.size > bytes.size() - record.offset){
+				return std::nullopt;
+			}
+		}
+
+		for(std::uint32_t i = 0; i < header.regionCount; ++i){
+			RegionRecord record{};
+			std::memcpy(&record, bytes.data() + view.regionsOffset() + i * sizeof(RegionRecord), sizeof(RegionRecord));
+
+			if(record.page >= header.pageCount || std::uint64_t{record.nameOffset} + record.nameSize > header.namesSize) return std::nullopt;
+			if(std::uint64_t{record.x} + record.width > header.pageWidth || std::uint64_t{record.y} + record.height > header.pageHeight) return std::nullopt;
+		}
+
+		return view;
+	}
+
+	/**
+	 * @param pages of `pageSize` each
+	 * @param format the pages are encoded to with their mip chain unless RGBA
+	 */
+	void write(Core::File& file, const std::string_view pageName, const Geom::USize2 pageSize, const std::uint32_t margin,
+		const std::span<const Pixmap> pages, const std::span<const Region> regions, const PixelFormat format = PixelFormat::rgba8){
+
+		std::string names{pageName};
+		std::vector<RegionRecord> regionRecords{};
+		regionRecords.reserve(regions.size());
+
+		for(const auto& [name, page, bound] : regions){
+			regionRecords.push_back({
+				.page = page,
+				.nameOffset = static_cast<std::uint32_t>(names.size()),
+				.nameSize = static_cast<std::uint32_t>(name.size()),
+				.x = bound.getSrcX(),
+				.y = bound.getSrcY(),
+				.width = bound.getWidth(),
+				.height = bound.getHeight()
+			});
+
+			names += name;
+		}
+
+		const std::optional<BlockFormat> block = blockFormatOf(format);
+
+		const Header header{
+			.format = format,
+			.pageWidth = pageSize.x,
+			.pageHeight = pageSize.y,
+			.pageCount = static_cast<std::uint32_t>(pages.size()),
+			.regionCount = static_cast<std::uint32_t>(regions.size()),
+			.margin = margin,
+			.pageNameSize = static_cast<std::uint32_t>(pageName.size()),
+			.namesSize = static_cast<std::uint32_t>(names.size()),
+			.mipLevels = block ? mipLevelsOf(pageSize) : 1
+		};
+
+		const auto align = [](const std::uint64_t offset){
+			return (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+		};
+
+		std::vector<PageRecord> pageRecords{};
+		pageRecords.reserve(pages.size());
+
+		std::uint64_t offset = sizeof(Header) + pages.size() * sizeof(PageRecord) + regionRecords.size() * sizeof(RegionRecord) + names.size();
+		for(std::size_t i = 0; i < pages.size(); ++i){
+			offset = align(offset);
+			pageRecords.push_back({offset, pageSizeBytes(header)});
+			offset += pageSizeBytes(header);
+		}
+
+		file.writeByte([&](std::ofstream& stream){
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			stream.write(reinterpret_cast<const char*>(pageRecords.data()), static_cast<std::streamsize>(pageRecords.size() * sizeof(PageRecord)));
+			stream.write(reinterpret_cast<const char*>(regionRecords.data()), static_cast<std::streamsize>(regionRecords.size() * sizeof(RegionRecord)));
+			stream.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+			for(const auto& [pixmap, record] : std::views::zip(pages, pageRecords)){
+				const auto padding = static_cast<std::streamsize>(record.offset - static_cast<std::uint64_t>(stream.tellp()));
+				for(std::streamsize i = 0; i < padding; ++i) stream.put('\0');
+
+				if(block){
+					const CompressedImage compressed = compress(pixmap, *block, header.mipLevels);
+					stream.write(reinterpret_cast<const char*>(compressed.data.data()), static_cast<std::streamsize>(record.size));
+				}else{
+					stream.write(reinterpret_cast<const char*>(pixmap.data()), static_cast<std::streamsize>(record.size));
+				}
+			}
+		});
+	}
+}
@@ -10,13 +10,21 @@ import ext.handle_wrapper;
 import Core.Vulkan.Buffer.CommandBuffer;
 import Core.Vulkan.Buffer.ExclusiveBuffer;
 import Core.Vulkan.CommandPool;
+import Core.Vulkan.UploadQueue;
+import Core.Vulkan.Image;
 
 import Graphic.ImageRegion;
 import Graphic.Pixmap;
+import Graphic.AtlasBundle;
+import Graphic.BlockCompression;
+
+import Core.File;
+import Core.MappedFile;
 
 import Geom.Vector2D;
 import Geom.Rect_Orthogonal;
 import ext.allocator_2D;
+import ext.shelf_allocator_2D;
 import ext.heterogeneous;
 import ext.meta_programming;
 import std;
@@ -29,14 +37,27 @@ namespace Graphic{
 	using PointType = Geom::Vector2D<T>;
 	using SizeType = Geom::Vector2D<T>;
 
+	/**
+	 * @brief how the subpages of a page place their regions
+	 */
+	export enum struct PagePacker : std::uint8_t{
+		/** @brief @link ext::allocator_2D @endlink, regions of any shape */
+		tree,
+		/** @brief @link ext::shelf_allocator_2D @endlink, many small regions of similar heights and churn, can be compacted */
+		shelf,
+	};
 
 	export struct SubpageData{
-		ext::allocator_2D allocator2D;
+		std::variant<ext::allocator_2D, ext::shelf_allocator_2D> allocator2D;
 		Core::Vulkan::Texture texture{};
 
+		using Relocation = ext::shelf_allocator_2D::relocation;
+
 		struct AllocatedViewRegion : ImageViewRegion{
 			ext::dependency<SubpageData*> srcAllocator{};
 			Geom::OrthoRectUInt region{};
+			/** @brief source of the allocation, the region may have shrunk since */
+			PointType origin{};
 
 			[[nodiscard]] AllocatedViewRegion() = default;
 
@@ -52,7 +73,7 @@ namespace Graphic{
 				const Geom::Rect_Orthogonal<std::uint32_t> internal,
 				SubpageData* srcAllocator)
 				: ImageViewRegion{imageView, srcImageSize, internal},
-				  srcAllocator{srcAllocator}, region{internal}{}
+				  srcAllocator{srcAllocator}, region{internal}, origin{internal.getSrc()}{}
 
 			void shrink(const std::uint32_t size){
 				region.shrink(size);
@@ -60,8 +81,18 @@ namespace Graphic{
 				setUV_fromInternal(region);
 			}
 
+			/**
+			 * @brief follows the allocation moved to `to` by a compaction
+			 */
+			void relocate(const PointType to){
+				region.setSrc(region.getSrc() - origin + to);
+				origin = to;
+
+				setUV_fromInternal(region);
+			}
+
 			~AllocatedViewRegion(){
-				if(srcAllocator)srcAllocator->deallocate(region.getSrc());
+				if(srcAllocator)srcAllocator->deallocate(origin);
 			}
 
 			AllocatedViewRegion(const AllocatedViewRegion& other) = delete;
@@ -73,22 +104,108 @@ namespace Graphic{
 			AllocatedViewRegion& operator=(AllocatedViewRegion&& other) noexcept = default;
 		};
 
-		auto allocate(const SizeType size){
-			return allocator2D.allocate(size);
+		/**
+		 * @brief a block compressed subpage rounds the size up to whole blocks, the shelves then keep every region block aligned
+		 */
+		std::optional<Rect> allocate(SizeType size){
+			if(blockFormat){
+				size.add(BlockExtent - 1).div(BlockExtent).mul(BlockExtent);
+			}
+
+			return std::visit([size](auto& allocator){
+				return allocator.allocate(size);
+			}, allocator2D);
 		}
 
-		auto deallocate(const PointType point){
-			return allocator2D.deallocate(point);
+		void deallocate(const PointType point){
+			std::visit([point](auto& allocator){
+				allocator.deallocate(point);
+			}, allocator2D);
+		}
+
+		[[nodiscard]] T getValidArea() const{
+			return std::visit([](const auto& allocator){
+				return allocator.get_valid_area();
+			}, allocator2D);
+		}
+
+		/**
+		 * @brief takes the whole area, for content placed offline, later allocations go to other subpages
+		 */
+		void seal(){
+			std::visit([](auto& allocator){
+				(void)allocator.allocate(allocator.extent());
+			}, allocator2D);
+		}
+
+		/**
+		 * @param createTexture false to leave the image to the caller, e.g. to create it from a baked bundle
+		 * @param blockFormat the regions written at runtime are encoded to, the texture has a single level then
+		 */
+		[[nodiscard]] explicit SubpageData(const Core::Vulkan::Context* context, const SizeType size, const PagePacker packer = PagePacker::tree, const bool createTexture = true, const std::optional<BlockFormat> blockFormat = std::nullopt) // NOLINT(*-pro-type-member-init)
+			: allocator2D{makeAllocator(size, packer)}, texture{context->physicalDevice, context->device}, blockFormat{createTexture ? blockFormat : std::nullopt}{
+			if(!createTexture) return;
+
+			if(blockFormat){
+				texture.createCompressed(size, 1, *blockFormat);
+			}else{
+				texture.createEmpty(size, 1);
+			}
 		}
 
-		[[nodiscard]] explicit SubpageData(const Core::Vulkan::Context* context, const SizeType size) // NOLINT(*-pro-type-member-init)
-			: allocator2D{size}, texture{context->physicalDevice, context->device}{
-			texture.createEmpty(size, 1);
+		[[nodiscard]] std::optional<BlockFormat> getBlockFormat() const noexcept{
+			return blockFormat;
 		}
 
+		/**
+		 * @brief Repacks the allocations of a shelf subpage, the texture content is not moved yet.
+		 * @return the moved allocations, always empty for the tree packer
+		 */
+		[[nodiscard]] std::vector<Relocation> compact(){
+			if(auto* shelf = std::get_if<ext::shelf_allocator_2D>(&allocator2D)){
+				return shelf->compact();
+			}
+
+			return {};
+		}
+
+		[[nodiscard]] VkDeviceSize relocationBufferSize(const std::span<const Relocation> relocations) const{
+			return std::ranges::fold_left(relocations, VkDeviceSize{}, [this](const VkDeviceSize size, const Relocation& relocation){
+				return size + regionSizeBytes(relocation.from.getSize());
+			});
+		}
+
+		/**
+		 * @brief Moves the texture content along the relocations through `buffer` and regenerates the mipmaps.
+		 * A block compressed subpage moves whole blocks, its allocations are block aligned.
+		 * @param buffer at least @link relocationBufferSize @endlink large, as the places may overlap each other
+		 */
+		void relocateContent(VkCommandBuffer commandBuffer, VkBuffer buffer, const std::span<const Relocation> relocations) const;
+
+	private:
+		std::optional<BlockFormat> blockFormat{};
+
+		[[nodiscard]] VkDeviceSize regionSizeBytes(const SizeType size) const noexcept{
+			return blockFormat ? levelSizeBytes(*blockFormat, size) : VkDeviceSize{size.area()} * Pixmap::Channels;
+		}
+
+		static std::variant<ext::allocator_2D, ext::shelf_allocator_2D> makeAllocator(const SizeType size, const PagePacker packer){
+			if(packer == PagePacker::shelf){
+				return std::variant<ext::allocator_2D, ext::shelf_allocator_2D>{std::in_place_type<ext::shelf_allocator_2D>, size};
+			}
+
+			return std::variant<ext::allocator_2D, ext::shelf_allocator_2D>{std::in_place_type<ext::allocator_2D>, size};
+		}
+
+	public:
+
 		template <typename T>
 			requires (ext::is_any_of<T, VkImage, VkBuffer>)
 		std::optional<AllocatedViewRegion> tryAllocate(VkCommandBuffer commandBuffer, T dataHandle, const Rect region, const std::uint32_t margin){
+			if(blockFormat){
+				throw std::invalid_argument("Block compressed pages are written from pixmaps only");
+			}
+
 			if(const auto rect = allocate(region.getSize().add(margin))){
 				const Rect rst = rect->copy().setSize(region.getSize());
 
@@ -105,6 +222,29 @@ namespace Graphic{
 
 			return std::nullopt;
 		}
+
+		/**
+		 * @brief the pixmap is only staged, it lands on the texture with the next flush of the queue
+		 */
+		std::optional<AllocatedViewRegion> tryAllocate(Core::Vulkan::UploadQueue& queue, const Pixmap& pixmap, const std::uint32_t margin){
+			if(const auto rect = allocate(pixmap.size2D().add(margin))){
+				const Rect rst = rect->copy().setSize(pixmap.size2D());
+
+				if(blockFormat){
+					//the whole allocation is encoded, the margin read by filtering is transparent instead of undefined
+					Pixmap padded{rect->getWidth(), rect->getHeight()};
+					padded.set(pixmap, 0, 0);
+
+					queue.writeBlocks(texture, compress(padded, *blockFormat, 1).data, *rect);
+				}else{
+					queue.write(texture, pixmap, rst);
+				}
+
+				return AllocatedViewRegion{texture.getView(), texture.getSize(), rst, this};
+			}
+
+			return std::nullopt;
+		}
 	};
 
 	export struct ImagePage{
@@ -113,19 +253,44 @@ namespace Graphic{
 
 		std::uint32_t margin{4};
 
+		/**
+		 * @brief called after a compaction moved the regions of a subpage, the named regions have been moved already.
+		 * Views copied out of the regions have to be refreshed here.
+		 */
+		std::function<void(const SubpageData&, std::span<const SubpageData::Relocation>)> relocateCallback{};
+
 	private:
 		std::string name{};
 		SizeType imageSize{};
+		PagePacker packer{};
+		/** @brief of the subpages created at runtime, baked bundle pages carry their own */
+		std::optional<BlockFormat> blockFormat{};
 		std::shared_mutex writeMutex{};
 
 	public:
-		[[nodiscard]] explicit ImagePage(const std::string_view name, const SizeType size = DefTexturePageSize)
+		[[nodiscard]] explicit ImagePage(const std::string_view name, const SizeType size = DefTexturePageSize, const PagePacker packer = PagePacker::tree, const std::optional<BlockFormat> blockFormat = std::nullopt)
 			: name{name},
-			  imageSize{size}{}
+			  imageSize{size}, packer{packer}, blockFormat{blockFormat}{}
 
 		SubpageData& createPage(const Core::Vulkan::Context* context){
+			return createPage(context, imageSize);
+		}
+
+		SubpageData& createPage(const Core::Vulkan::Context* context, const SizeType size, const bool createTexture = true){
 			std::unique_lock lk{writeMutex};
-			return subpages.emplace_back(SubpageData{context, imageSize});
+			return subpages.emplace_back(SubpageData{context, size, packer, createTexture, blockFormat});
+		}
+
+		[[nodiscard]] PagePacker getPacker() const noexcept{
+			return packer;
+		}
+
+		[[nodiscard]] std::optional<BlockFormat> getBlockFormat() const noexcept{
+			return blockFormat;
+		}
+
+		[[nodiscard]] SizeType getImageSize() const noexcept{
+			return imageSize;
 		}
 
 		template <typename T>
@@ -151,6 +316,38 @@ namespace Graphic{
 			return std::move(rst.value());
 		}
 
+		/**
+		 * @brief allocates in the existing subpages only
+		 */
+		[[nodiscard]] std::optional<SubpageData::AllocatedViewRegion> tryAllocate(Core::Vulkan::UploadQueue& queue, const Pixmap& pixmap){
+			for(std::shared_lock lk{writeMutex}; auto& subpass : subpages){
+				if(std::optional<SubpageData::AllocatedViewRegion> (rst) = subpass.tryAllocate(queue, pixmap, margin)){
+					return rst;
+				}
+			}
+
+			return std::nullopt;
+		}
+
+		[[nodiscard]] SubpageData::AllocatedViewRegion allocate(
+			const Core::Vulkan::Context* context,
+			Core::Vulkan::UploadQueue& queue,
+			const Pixmap& pixmap){
+
+			if(std::optional<SubpageData::AllocatedViewRegion> (rst) = tryAllocate(queue, pixmap)){
+				return std::move(rst.value());
+			}
+
+			SubpageData& newSubpage = createPage(context);
+			std::optional<SubpageData::AllocatedViewRegion> rst = newSubpage.tryAllocate(queue, pixmap, margin);
+
+			if(!rst){
+				throw std::invalid_argument("Invalid region size");
+			}
+
+			return std::move(rst.value());
+		}
+
 		[[nodiscard]] constexpr std::string_view getName() const noexcept{
 			return name;
 		}
@@ -186,11 +383,38 @@ namespace Graphic{
 			return ImagePage::registerNamedRegion(std::string{name}, allocate<T>(context, commandBuffer, std::move(data), region));
 		}
 
+		/**
+		 * @brief moves the named regions of `subpage` along the relocations and notifies @link relocateCallback @endlink
+		 * @param regions unnamed regions of the subpage to move as well
+		 */
+		void relocateRegions(const SubpageData& subpage, const std::span<const SubpageData::Relocation> relocations, const std::span<SubpageData::AllocatedViewRegion> regions = {}){
+			std::unordered_map<PointType, PointType> destinations{};
+			destinations.reserve(relocations.size());
+
+			for(const auto& [from, to] : relocations){
+				destinations.try_emplace(from.getSrc(), to);
+			}
+
+			const auto relocate = [&](SubpageData::AllocatedViewRegion& region){
+				if(region.srcAllocator != &subpage) return;
+
+				if(const auto itr = destinations.find(region.origin); itr != destinations.end()){
+					region.relocate(itr->second);
+				}
+			};
+
+			std::ranges::for_each(namedImageRegions | std::views::values, relocate);
+			std::ranges::for_each(regions, relocate);
+
+			if(relocateCallback) relocateCallback(subpage, relocations);
+		}
+
 		std::vector<Pixmap> exportImages(const Core::Vulkan::CommandPool& commandPool, VkQueue queue) const{
 			std::vector<Pixmap> pixmaps{};
 			pixmaps.reserve(subpages.size());
 
 			for (const auto & subpage : subpages){
+				if(subpage.texture.isCompressed()) continue;
 				pixmaps.push_back(subpage.texture.exportToPixmap(commandPool.getTransient(queue)));
 			}
 
@@ -206,13 +430,17 @@ namespace Graphic{
 
 		ext::string_hash_map<ImagePage> pages{};
 
+		/** @brief pixmap allocations are staged here, destroyed before the pages it writes to */
+		Core::Vulkan::UploadQueue uploadQueue{};
+
 		[[nodiscard]] ImageAtlas() = default;
 
 		[[nodiscard]] explicit ImageAtlas(const Core::Vulkan::Context& context) :
 			context{&context},
 			transientCommandPool{
 				context.device, context.graphicFamily(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT
-			}{}
+			},
+			uploadQueue{context}{}
 
 		[[nodiscard]] ImagePage* findPage(const std::string_view name){
 			if(const auto page = pages.find(name); page != pages.end()) return &page->second;
@@ -224,8 +452,17 @@ namespace Graphic{
 			return nullptr;
 		}
 
-		ImagePage& registerPage(std::string_view name, SizeType size = DefTexturePageSize){
-			return pages.try_emplace(std::string(name), name, size).first->second;
+		/**
+		 * @param blockFormat encodes the regions of the page written at runtime, dropped if the device cannot sample it.
+		 * Such a page has no mipmaps and takes pixmaps only, meant for glyph pages, e.g. @link BlockFormat::bc4 @endlink.
+		 * Any other runtime page stays RGBA8.
+		 */
+		ImagePage& registerPage(std::string_view name, SizeType size = DefTexturePageSize, PagePacker packer = PagePacker::tree, std::optional<BlockFormat> blockFormat = std::nullopt){
+			if(blockFormat && !Core::Vulkan::supportsBlockFormat(context->physicalDevice, *blockFormat)){
+				blockFormat = std::nullopt;
+			}
+
+			return pages.try_emplace(std::string(name), name, size, packer, blockFormat).first->second;
 		}
 
 		[[nodiscard]] AllocatedImageViewRegion allocate(
@@ -234,11 +471,77 @@ namespace Graphic{
 			return page.allocate(context, obtainTransientCommand(), image, region);
 		}
 
-		[[nodiscard]] AllocatedImageViewRegion allocate(ImagePage& page, const Pixmap& pixmap) const{
-			const Core::Vulkan::StagingBuffer buffer(context->physicalDevice, context->device, pixmap.sizeBytes());
-			buffer.memory.loadData(pixmap.data(), pixmap.sizeBytes());
+		/**
+		 * @brief the region is usable by frames submitted after the next @link flushUploads @endlink
+		 */
+		[[nodiscard]] AllocatedImageViewRegion allocate(ImagePage& page, const Pixmap& pixmap){
+			return allocate(page, pixmap, {});
+		}
+
+		/**
+		 * @brief stages all pixmaps into one upload batch
+		 * @return regions in the order of the pixmaps
+		 */
+		[[nodiscard]] std::vector<AllocatedImageViewRegion> allocate(ImagePage& page, const std::span<const Pixmap* const> pixmaps){
+			std::vector<AllocatedImageViewRegion> regions{};
+			regions.reserve(pixmaps.size());
+
+			for(const Pixmap* pixmap : pixmaps){
+				regions.push_back(allocate(page, *pixmap, regions));
+			}
+
+			return regions;
+		}
+
+		/**
+		 * @brief Repacks the allocations of a shelf subpage and moves the texture content and the named regions along.
+		 * Waits for the device, meant for the rare case a page runs out of room.
+		 * @param regions unnamed regions of the page to move as well
+		 * @return the moved allocations
+		 */
+		std::vector<SubpageData::Relocation> compact(ImagePage& page, SubpageData& subpage, const std::span<AllocatedImageViewRegion> regions = {}){
+			std::vector<SubpageData::Relocation> relocations = subpage.compact();
+			if(relocations.empty()) return relocations;
+
+			//staged writes target the old places, they land before the content moves
+			flushUploads();
+
+			{
+				const Core::Vulkan::ExclusiveBuffer buffer{
+					context->physicalDevice, context->device, subpage.relocationBufferSize(relocations),
+					VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+				};
+
+				subpage.relocateContent(obtainTransientCommand(), buffer.get(), relocations);
+			}
+
+			page.relocateRegions(subpage, relocations, regions);
+
+			return relocations;
+		}
+
+		/**
+		 * @brief Registers the page of an offline baked bundle with all its named regions.
+		 * The file is mapped and every baked page is staged from the mapping with a single write into a sealed subpage of its own,
+		 * so the cost does not grow with the region count beyond the name registration. Uploaded with the next @link flushUploads @endlink.
+		 * Block compressed pages are uploaded with their baked mip chain, or decoded on the CPU if the device cannot sample the format.
+		 * @return the page, nullptr if the file is not a bundle of this version
+		 */
+		ImagePage* loadBundle(const Core::File& file);
 
-			return page.allocate(context, obtainTransientCommand(), buffer.get(), Geom::Rect_Orthogonal<std::uint32_t>{pixmap.size2D()});
+		/**
+		 * @brief submits the staged pixmaps, call it before submitting the frame that samples them
+		 */
+		Core::Vulkan::UploadQueue::Ticket flushUploads(){
+			return uploadQueue.flush();
+		}
+
+		/**
+		 * @brief blocks until the uploads of the ticket are on the pages, e.g. before exporting them
+		 */
+		void waitUploads(const Core::Vulkan::UploadQueue::Ticket ticket) const{
+			uploadQueue.wait(ticket);
 		}
 
 		[[nodiscard]] AllocatedImageViewRegion allocate(const std::string_view pageName, const Pixmap& pixmap){
@@ -319,7 +622,7 @@ namespace Graphic{
 			return page.registerNamedRegion(localName, allocate(page, pixmap));
 		}
 
-		decltype(auto) registerNamedImageViewRegion(ImagePage& page, const std::string_view name, const Pixmap& pixmap) const{
+		decltype(auto) registerNamedImageViewRegion(ImagePage& page, const std::string_view name, const Pixmap& pixmap){
 			return page.registerNamedRegion(name, allocate(page, pixmap));
 		}
 
@@ -330,5 +633,184 @@ namespace Graphic{
 
 			return {category, localName};
 		}
+
+	private:
+		/**
+		 * @brief a shelf page compacts a subpage with enough free room before it grows, repacking is far cheaper than a new page
+		 * @param pending unnamed regions allocated in the page so far, moved along by a compaction
+		 */
+		[[nodiscard]] AllocatedImageViewRegion allocate(ImagePage& page, const Pixmap& pixmap, const std::span<AllocatedImageViewRegion> pending){
+			if(std::optional<AllocatedImageViewRegion> rst = page.tryAllocate(uploadQueue, pixmap)){
+				return std::move(rst.value());
+			}
+
+			if(page.getPacker() == PagePacker::shelf){
+				//below a quarter of free room the page is full rather than fragmented
+				const T minValidArea = std::max(pixmap.size2D().add(page.margin).area(), page.getImageSize().area() / 4);
+
+				for(auto& subpage : page.subpages){
+					if(subpage.getValidArea() < minValidArea) continue;
+
+					if(compact(page, subpage, pending).empty()) continue;
+
+					if(std::optional<AllocatedImageViewRegion> rst = subpage.tryAllocate(uploadQueue, pixmap, page.margin)){
+						return std::move(rst.value());
+					}
+				}
+			}
+
+			return page.allocate(context, uploadQueue, pixmap);
+		}
 	};
 }
+
+module : private;
+
+Graphic::ImagePage* Graphic::ImageAtlas::loadBundle(const Core::File& file){
+	const Core::MappedFile mapping{file};
+
+	const std::optional<AtlasBundle::View> bundle = AtlasBundle::parse(mapping.bytes());
+	if(!bundle) return nullptr;
+
+	const std::optional<BlockFormat> block = AtlasBundle::blockFormatOf(bundle->format());
+
+	//a device without the block format gets the pages decoded to RGBA, mipmapped at runtime like any other page
+	const bool decode = block && !Core::Vulkan::supportsBlockFormat(context->physicalDevice, *block);
+
+	ImagePage& page = registerPage(bundle->pageName(), bundle->pageSize());
+
+	std::vector<SubpageData*> baked{};
+	baked.reserve(bundle->pageCount());
+
+	for(std::uint32_t i = 0; i < bundle->pageCount(); ++i){
+		SubpageData& subpage = page.createPage(context, bundle->pageSize(), !block || decode);
+		subpage.seal();
+
+		//staged right away, the mapping is not needed after this function
+		if(const auto compressed = bundle->compressedPage(i); compressed && decode){
+			uploadQueue.write(subpage.texture, decompress(*compressed), Geom::OrthoRectUInt{bundle->pageSize()});
+		}else if(compressed){
+			uploadQueue.load(subpage.texture, *compressed);
+		}else{
+			uploadQueue.write(subpage.texture, bundle->pageData(i), Geom::OrthoRectUInt{bundle->pageSize()});
+		}
+		baked.push_back(&subpage);
+	}
+
+	page.namedImageRegions.reserve(page.namedImageRegions.size() + bundle->regionCount());
+
+	for(std::uint32_t i = 0; i < bundle->regionCount(); ++i){
+		const auto [name, index, bound] = bundle->region(i);
+		const SubpageData& subpage = *baked[index];
+
+		//no allocator to return the region to, the sealed subpage never reuses its area
+		page.registerNamedRegion(name, AllocatedImageViewRegion{subpage.texture.getView(), subpage.texture.getSize(), bound, nullptr});
+	}
+
+	return &page;
+}
+
+void Graphic::SubpageData::relocateContent(VkCommandBuffer commandBuffer, VkBuffer buffer, const std::span<const Relocation> relocations) const{
+	std::vector<VkBufferImageCopy> copies{};
+	copies.reserve(relocations.size());
+
+	VkDeviceSize offset{};
+	for(const auto& [from, to] : relocations){
+		copies.push_back({
+			.bufferOffset = offset,
+			.bufferRowLength = 0,
+			.bufferImageHeight = 0,
+			.imageSubresource = {
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.mipLevel = 0,
+				.baseArrayLayer = 0,
+				.layerCount = 1
+			},
+			.imageOffset = {static_cast<std::int32_t>(from.getSrcX()), static_cast<std::int32_t>(from.getSrcY()), 0},
+			.imageExtent = {from.getWidth(), from.getHeight(), 1}
+		});
+
+		offset += regionSizeBytes(from.getSize());
+	}
+
+	const VkImageSubresourceRange range{
+		.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+		.baseMipLevel = 0,
+		.levelCount = texture.getMipLevels(),
+		.baseArrayLayer = 0,
+		.layerCount = 1
+	};
+
+	Core::Vulkan::Util::imageBarrier(commandBuffer, std::array{VkImageMemoryBarrier2{
+		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+		.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+		.srcAccessMask = VK_ACCESS_2_NONE,
+		.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+		.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+		.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.image = texture.getImage(),
+		.subresourceRange = range
+	}});
+
+	vkCmdCopyImageToBuffer(commandBuffer, texture.getImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer,
+		static_cast<std::uint32_t>(copies.size()), copies.data());
+
+	Core::Vulkan::Util::imageBarrier(commandBuffer, std::array{VkImageMemoryBarrier2{
+		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+		.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+		.srcAccessMask = VK_ACCESS_2_NONE,
+		.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+		.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+		.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.image = texture.getImage(),
+		.subresourceRange = range
+	}});
+
+	Core::Vulkan::Util::bufferBarrier(commandBuffer, std::array{VkBufferMemoryBarrier2{
+		.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+		.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+		.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+		.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+		.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.buffer = buffer,
+		.offset = 0,
+		.size = VK_WHOLE_SIZE
+	}});
+
+	for(auto&& [copy, relocation] : std::views::zip(copies, relocations)){
+		copy.imageOffset = {static_cast<std::int32_t>(relocation.to.x), static_cast<std::int32_t>(relocation.to.y), 0};
+	}
+
+	vkCmdCopyBufferToImage(commandBuffer, buffer, texture.getImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		static_cast<std::uint32_t>(copies.size()), copies.data());
+
+	if(blockFormat){
+		Core::Vulkan::Util::imageBarrier(commandBuffer, std::array{VkImageMemoryBarrier2{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+			.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+			.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+			.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+			.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+			.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image = texture.getImage(),
+			.subresourceRange = range
+		}});
+
+		return;
+	}
+
+	//the vacated places are sampled by nothing, the whole image is regenerated for simplicity
+	const auto [w, h] = texture.getSize().as<int>();
+	Core::Vulkan::Util::generateMipmaps(commandBuffer, texture.getImage(), Geom::OrthoRectInt{w, h}, texture.getMipLevels());
+}
@@ -34,15 +34,21 @@ export namespace Graphic{
 	struct RendererWorld : BasicRenderer{
 		Batch_Exclusive batch{};
 
+		/** @brief @link Instance_World @endlink quads, drawn into the same attachments after @link batch @endlink */
+		Batch_Exclusive instanceBatch{};
+
 		using Batch = decltype(batch);
 
 		//Pipeline Data
 		Core::Vulkan::DynamicRendering dynamicRendering{};
 		Core::Vulkan::SinglePipelineData pipelineData{};
+		/** @brief shares the layout of @link pipelineData @endlink */
+		Core::Vulkan::Pipeline instancePipeline{};
 
 
 		//Commands Region
 		Batch::DrawCommandSeq<void> drawCommands{};
+		Batch::DrawCommandSeq<void> instanceDrawCommands{};
 		Core::Vulkan::CommandBuffer cleanCommand{};
 		Core::Vulkan::CommandBuffer endBatchCommand{};
 
@@ -76,6 +82,7 @@ export namespace Graphic{
 		[[nodiscard]] explicit RendererWorld(const Core::Vulkan::Context& context)
 			: BasicRenderer(context),
 			  batch(context, sizeof(Vertex_World), Assets::Sampler::textureNearestSampler),
+			  instanceBatch(context, sizeof(Instance_World), Assets::Sampler::textureNearestSampler, QuadSubmission::instances),
 			  pipelineData{&context},
 			  cleanCommand{context.device, commandPool},
 			  endBatchCommand{context.device, commandPool},
@@ -94,12 +101,34 @@ export namespace Graphic{
 				vkCommandBuffer = {context.device, commandPool};
 			}
 
+			for(auto&& vkCommandBuffer : instanceDrawCommands){
+				vkCommandBuffer = {context.device, commandPool};
+			}
+
+			//the instanced markers are a pass of their own on top of the vertex quads, layers are kept apart by depth
+			instanceBatch.drawAfter(batch);
+
 			batch.externalDrawCall = [this](const Batch::CommandUnit& unit, const std::size_t idx){
 				Core::Vulkan::Util::submitCommand(
 					this->context().device.getPrimaryGraphicsQueue(),
 					std::array{unit.transferCommand.get(), drawCommands[idx].get()}, unit.fence);
 			};
 
+			instanceBatch.externalDrawCall = [this](const Batch::CommandUnit& unit, const std::size_t idx){
+				Core::Vulkan::Util::submitCommand(
+					this->context().device.getPrimaryGraphicsQueue(),
+					std::array{unit.transferCommand.get(), instanceDrawCommands[idx].get()}, unit.fence);
+			};
+
+			//the other batch and the wrap command may still be pending, only the grown batch is recorded again
+			batch.externalUnitsReallocated = [this]{
+				recordDrawCommands(batch, drawCommands, pipelineData.pipeline);
+			};
+
+			instanceBatch.externalUnitsReallocated = [this]{
+				recordDrawCommands(instanceBatch, instanceDrawCommands, instancePipeline);
+			};
+
 
 			using namespace Core::Vulkan;
 			pipelineData.createDescriptorLayout([](DescriptorLayout& layout){
@@ -163,6 +192,16 @@ export namespace Graphic{
 			return *batch.context;
 		}
 
+		/**
+		 * @brief submits everything both batches hold, call before @link doPostProcess @endlink
+		 *
+		 * The vertex quads first, the instanced ones are drawn after them.
+		 */
+		void consumeAll(){
+			batch.consumeAll();
+			instanceBatch.consumeAll();
+		}
+
 		void updateProjection(const Core::Vulkan::UniformProjectionBlock& data) const{
 			worldUniformBuffer.memory.loadData(data);
 		}
@@ -356,9 +395,15 @@ export namespace Graphic{
 			dynamicRendering.setDepthAttachment(depthStencilAttachment.getView(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
 			dynamicRendering.pushColorAttachment(baseColor.getView(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 			dynamicRendering.pushColorAttachment(lightAttachment.getView(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-			for(auto&& [i, unit] : drawCommands | std::views::enumerate){
+
+			recordDrawCommands(batch, drawCommands, pipelineData.pipeline);
+			recordDrawCommands(instanceBatch, instanceDrawCommands, instancePipeline);
+		}
+
+		void recordDrawCommands(Batch& target, Batch::DrawCommandSeq<void>& commands, VkPipeline pipeline){
+			for(auto&& [i, unit] : commands | std::views::enumerate){
 				using namespace Core::Vulkan;
-				auto& commandUnit = batch.units[i];
+				auto& commandUnit = target.units[i];
 
 				auto barriers = commandUnit.getBarriers();
 
@@ -369,7 +414,7 @@ export namespace Graphic{
 
 				{
 					dynamicRendering.beginRendering(scopedCommand, {{}, {size.x, size.y}});
-					pipelineData.bind(scopedCommand, VK_PIPELINE_BIND_POINT_GRAPHICS);
+					vkCmdBindPipeline(scopedCommand, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
 					const std::array infos{
 						descriptorBuffer.getBindInfo(
@@ -384,7 +429,7 @@ export namespace Graphic{
 						pipelineData.layout,
 						0, infos.size(), Seq::Indices<0, 1>, Seq::Offset<0, 0>);
 
-					batch.bindBuffersTo(scopedCommand, i);
+					target.bindBuffersTo(scopedCommand, i);
 
 					vkCmdEndRendering(scopedCommand);
 				}
@@ -514,6 +559,12 @@ export namespace Graphic{
 			pipelineTemplate.applyDynamicRendering();
 
 			pipelineData.createPipeline(pipelineTemplate);
+
+			pipelineTemplate
+				.setVertexInputInfo<WorldInstanceBindInfo>()
+				.setShaderChain({&Assets::Shader::Vert::worldInstance, &Assets::Shader::Frag::worldBatch});
+
+			instancePipeline = Pipeline{context().device, pipelineTemplate, pipelineData.layout, nullptr, 0};
 		}
 
 		void setPort(){
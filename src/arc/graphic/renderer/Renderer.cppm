@@ -27,7 +27,8 @@ export namespace Graphic{
 
 		[[nodiscard]] explicit BasicRenderer(const Core::Vulkan::Context& context)
 			:
-			commandPool{context.device, context.graphicFamily(), 0},
+			//batch draw commands are recorded again one batch at a time when its units grow
+			commandPool{context.device, context.graphicFamily(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT},
 			commandPool_Compute{context.device, context.computeFamily(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT}{}
 
 		[[nodiscard]] Geom::USize2 getSize() const noexcept{ return size; }
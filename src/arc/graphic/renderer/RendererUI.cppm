@@ -184,6 +184,10 @@ export namespace Graphic{
 			batch.externalDrawCall = [this](const Batch::CommandUnit& unit, const std::size_t i){
 				draw(unit, i);
 			};
+
+			batch.externalUnitsReallocated = [this]{
+				createDrawCommands();
+			};
 		}
 
 		void resize(const Geom::USize2 size2){
@@ -243,18 +247,14 @@ export namespace Graphic{
 		}
 
 		void draw(const Batch::CommandUnit& unit, const std::size_t index){
-			Core::Vulkan::Util::submitCommand(
-							context().device.getPrimaryGraphicsQueue(),
-							unit.transferCommand.get(), unit.fence);
-
-
 			if(drawCommands[index].second.scissor != getCurrentScissor()){
 				setScissor(getCurrentScissor());
 			}
 
+			//the draw is fenced along with the transfer, the batch waits on the unit fence before replacing its buffers
 			Core::Vulkan::Util::submitCommand(
 				context().device.getPrimaryGraphicsQueue(),
-				drawCommands[index].first.get(), nullptr);
+				std::array{unit.transferCommand.get(), drawCommands[index].first.get()}, unit.fence);
 
 			nextIndex = (index + 1) % drawCommands.size();
 		}
@@ -2,6 +2,10 @@ module;
 
 #include <vulkan/vulkan.h>
 
+#ifndef COMPACT_VERTICES
+#define COMPACT_VERTICES 0
+#endif
+
 export module Graphic.Vertex;
 
 import Core.Vulkan.Preinstall;
@@ -11,14 +15,140 @@ import Graphic.Color;
 import std;
 
 export namespace Graphic{
+	/**
+	 * @brief @link Vertex_World @endlink and @link Vertex_UI @endlink are the packed layouts,
+	 * shaders are compiled with `CompactVertices` defined then.
+	 */
+	constexpr bool CompactVertices = COMPACT_VERTICES;
+
+	/**
+	 * @brief how the fragment shaders read the texture, the third component of @link TextureIndex @endlink
+	 */
+	enum struct TextureMode : std::uint8_t{
+		color,
+		/** @brief alpha is a signed distance to an edge at 0.5, see @link Font::GlyphRenderMode @endlink */
+		distanceField,
+	};
+
 	struct TextureIndex{
 		std::uint8_t textureIndex{};
 		std::uint8_t textureLayer{};
-		std::uint8_t reserved1{};
-		std::uint8_t reserved2{};
+		TextureMode mode{};
+		std::uint8_t reserved{};
+	};
+
+	/**
+	 * @brief IEEE binary16, rounded to nearest even, values out of range become infinity
+	 */
+	struct Half{
+		std::uint16_t bits{};
+
+		[[nodiscard]] constexpr Half() = default;
+
+		[[nodiscard]] constexpr Half(const float value) noexcept : bits{toBits(value)}{} // NOLINT(*-explicit-constructor)
+
+		[[nodiscard]] static constexpr std::uint16_t toBits(const float value) noexcept{
+			const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+			const std::uint32_t sign = bits >> 16 & 0x8000u;
+			const std::uint32_t magnitude = bits & 0x7fff'ffffu;
+
+			//inf, nan keeps a quiet bit
+			if(magnitude >= 0x7f80'0000u){
+				return static_cast<std::uint16_t>(sign | 0x7c00u | (magnitude > 0x7f80'0000u ? 0x0200u : 0u));
+			}
+
+			//65536 and above
+			if(magnitude >= 0x4780'0000u){
+				return static_cast<std::uint16_t>(sign | 0x7c00u);
+			}
+
+			//normal, rebias the exponent and round the dropped 13 bits, a carry moves into the exponent
+			if(magnitude >= 0x3880'0000u){
+				std::uint32_t rebiased = magnitude - 0x3800'0000u;
+				rebiased += 0x0fffu + (rebiased >> 13 & 1u);
+				return static_cast<std::uint16_t>(sign | rebiased >> 13);
+			}
+
+			//below half of the smallest subnormal
+			if(magnitude < 0x3300'0000u){
+				return static_cast<std::uint16_t>(sign);
+			}
+
+			//subnormal
+			const std::uint32_t shift = 126u - (magnitude >> 23);
+			const std::uint32_t significand = (magnitude & 0x007f'ffffu) | 0x0080'0000u;
+			const std::uint32_t remainder = significand & ((1u << shift) - 1u);
+			const std::uint32_t halfway = 1u << (shift - 1u);
+
+			std::uint32_t result = significand >> shift;
+			if(remainder > halfway || (remainder == halfway && (result & 1u))){
+				++result;
+			}
+
+			return static_cast<std::uint16_t>(sign | result);
+		}
+	};
+
+	/**
+	 * @brief clamped to [0, 1]
+	 */
+	template <std::unsigned_integral T>
+	[[nodiscard]] constexpr T toUNorm(const float value) noexcept{
+		constexpr float max = std::numeric_limits<T>::max();
+		return static_cast<T>(std::clamp(value, 0.f, 1.f) * max + .5f);
+	}
+
+	/**
+	 * @brief texture coordinates are atlas local, so 16 bits leave several steps per texel of the largest page
+	 */
+	struct UNorm16x2{
+		std::uint16_t x{};
+		std::uint16_t y{};
+
+		[[nodiscard]] constexpr UNorm16x2() = default;
+
+		[[nodiscard]] constexpr UNorm16x2(const Geom::Vec2 value) noexcept : // NOLINT(*-explicit-constructor)
+			x{toUNorm<std::uint16_t>(value.x)}, y{toUNorm<std::uint16_t>(value.y)}{}
+	};
+
+	/**
+	 * @brief RGBA8 unorm, light channels are dropped and bases above 1 clamped
+	 */
+	struct Color_RGBA8{
+		std::uint8_t r{};
+		std::uint8_t g{};
+		std::uint8_t b{};
+		std::uint8_t a{};
+
+		[[nodiscard]] constexpr Color_RGBA8() = default;
+
+		[[nodiscard]] constexpr Color_RGBA8(const Color& color) noexcept : // NOLINT(*-explicit-constructor)
+			r{toUNorm<std::uint8_t>(color.r)}, g{toUNorm<std::uint8_t>(color.g)},
+			b{toUNorm<std::uint8_t>(color.b)}, a{toUNorm<std::uint8_t>(color.a)}{}
+	};
+
+	/**
+	 * @brief A colour carrying a light colour from @link Color::appendLightColor @endlink, as a 16 bit uint per channel.
+	 *
+	 * The low byte is the base channel in unorm, the high byte the light channel in its steps of 10.
+	 */
+	struct LightColor_Packed{
+		std::array<std::uint16_t, 4> channels{};
+
+		[[nodiscard]] constexpr LightColor_Packed() = default;
+
+		[[nodiscard]] constexpr LightColor_Packed(const Color& color) noexcept{ // NOLINT(*-explicit-constructor)
+			for(const auto& [channel, value] : std::views::zip(channels, std::array{color.r, color.g, color.b, color.a})){
+				//truncation is the floor here, negatives are clamped anyway
+				const float light = std::clamp(static_cast<float>(static_cast<int>(value / 10.f)), 0.f, 255.f);
+				const float base = value - light * 10.f;
+
+				channel = static_cast<std::uint16_t>(toUNorm<std::uint8_t>(base) | static_cast<std::uint16_t>(light) << 8);
+			}
+		}
 	};
 
-	struct Vertex_World {
+	struct Vertex_World_F32{
 		Geom::Vec2 position{};
 		float depth{};
 		TextureIndex textureParam{};
@@ -26,33 +156,104 @@ export namespace Graphic{
 		Geom::Vec2 texCoord{};
 	};
 
+	/** @brief 28 bytes instead of 40 */
+	struct Vertex_World_Packed{
+		Geom::Vec2 position{};
+		TextureIndex textureParam{};
+		UNorm16x2 texCoord{};
+		LightColor_Packed color{};
+		Half depth{};
+	};
+
     // struct InstanceDesignator{
     //     std::int8_t offset{};
     // };
 
-	using WorldVertBindInfo = Core::Vulkan::Util::VertexBindInfo<Vertex_World, 0, 0, VK_VERTEX_INPUT_RATE_VERTEX,
-		std::pair{&Vertex_World::position, VK_FORMAT_R32G32B32_SFLOAT},
-		std::pair{&Vertex_World::textureParam, VK_FORMAT_R8G8B8A8_UINT},
-		std::pair{&Vertex_World::texCoord, VK_FORMAT_R32G32_SFLOAT},
-		std::pair{&Vertex_World::color, VK_FORMAT_R32G32B32A32_SFLOAT}
+	using WorldVertBindInfo_F32 = Core::Vulkan::Util::VertexBindInfo<Vertex_World_F32, 0, 0, VK_VERTEX_INPUT_RATE_VERTEX,
+		std::pair{&Vertex_World_F32::position, VK_FORMAT_R32G32B32_SFLOAT},
+		std::pair{&Vertex_World_F32::textureParam, VK_FORMAT_R8G8B8A8_UINT},
+		std::pair{&Vertex_World_F32::texCoord, VK_FORMAT_R32G32_SFLOAT},
+		std::pair{&Vertex_World_F32::color, VK_FORMAT_R32G32B32A32_SFLOAT}
+	>;
+
+	using WorldVertBindInfo_Packed = Core::Vulkan::Util::VertexBindInfo<Vertex_World_Packed, 0, 0, VK_VERTEX_INPUT_RATE_VERTEX,
+		std::pair{&Vertex_World_Packed::position, VK_FORMAT_R32G32_SFLOAT},
+		std::pair{&Vertex_World_Packed::textureParam, VK_FORMAT_R8G8B8A8_UINT},
+		std::pair{&Vertex_World_Packed::texCoord, VK_FORMAT_R16G16_UNORM},
+		std::pair{&Vertex_World_Packed::color, VK_FORMAT_R16G16B16A16_UINT},
+		std::pair{&Vertex_World_Packed::depth, VK_FORMAT_R16_SFLOAT}
 	>;
 
 	// using InstanceBindInfo = Core::Vulkan::Util::VertexBindInfo<InstanceDesignator, 0, WorldVertBindInfo::size, VK_VERTEX_INPUT_RATE_INSTANCE,
 	// 	std::pair{&InstanceDesignator::offset, VK_FORMAT_R8_SINT}
 	// >;
 
-	struct Vertex_UI {
+	/**
+	 * @brief UV rect of an axis aligned region, the other two corners are derived in the shader
+	 */
+	struct UVRect_Packed{
+		UNorm16x2 v00{};
+		UNorm16x2 v11{};
+	};
+
+	/**
+	 * @brief A whole world quad in 48 bytes, the vertex shader expands the corners with `gl_VertexIndex`.
+	 *
+	 * Only rectangles of a single colour fit, gradients and free quads stay on @link Vertex_World @endlink.
+	 */
+	struct Instance_World{
+		Geom::Vec2 position{};
+		Geom::Vec2 size{};
+		/** @brief unit x axis of the quad, rotating in the shader needs no trigonometry then */
+		Geom::Vec2 axis{1, 0};
+		TextureIndex textureParam{};
+		UVRect_Packed texCoord{};
+		LightColor_Packed color{};
+		float depth{};
+	};
+
+	using WorldInstanceBindInfo = Core::Vulkan::Util::VertexBindInfo<Instance_World, 0, 0, VK_VERTEX_INPUT_RATE_INSTANCE,
+		std::pair{&Instance_World::position, VK_FORMAT_R32G32_SFLOAT},
+		std::pair{&Instance_World::size, VK_FORMAT_R32G32_SFLOAT},
+		std::pair{&Instance_World::axis, VK_FORMAT_R32G32_SFLOAT},
+		std::pair{&Instance_World::textureParam, VK_FORMAT_R8G8B8A8_UINT},
+		std::pair{&Instance_World::texCoord, VK_FORMAT_R16G16B16A16_UNORM},
+		std::pair{&Instance_World::color, VK_FORMAT_R16G16B16A16_UINT},
+		std::pair{&Instance_World::depth, VK_FORMAT_R32_SFLOAT}
+	>;
+
+	struct Vertex_UI_F32{
 		Geom::Vec2 position{};
 		TextureIndex textureParam{};
 		Graphic::Color color{};
 		Geom::Vec2 texCoord{};
 	};
 
+	/** @brief 20 bytes instead of 36 */
+	struct Vertex_UI_Packed{
+		Geom::Vec2 position{};
+		TextureIndex textureParam{};
+		Color_RGBA8 color{};
+		UNorm16x2 texCoord{};
+	};
+
+	using UIVertBindInfo_F32 = Core::Vulkan::Util::VertexBindInfo<Vertex_UI_F32, 0, 0, VK_VERTEX_INPUT_RATE_VERTEX,
+		  std::pair{&Vertex_UI_F32::position, VK_FORMAT_R32G32_SFLOAT},
+		  std::pair{&Vertex_UI_F32::textureParam, VK_FORMAT_R8G8B8A8_UINT},
+		  std::pair{&Vertex_UI_F32::color, VK_FORMAT_R32G32B32A32_SFLOAT},
+		  std::pair{&Vertex_UI_F32::texCoord, VK_FORMAT_R32G32_SFLOAT}
+	>;
 
-	using UIVertBindInfo = Core::Vulkan::Util::VertexBindInfo<Vertex_UI, 0, 0, VK_VERTEX_INPUT_RATE_VERTEX,
-		  std::pair{&Vertex_UI::position, VK_FORMAT_R32G32_SFLOAT},
-		  std::pair{&Vertex_UI::textureParam, VK_FORMAT_R8G8B8A8_UINT},
-		  std::pair{&Vertex_UI::color, VK_FORMAT_R32G32B32A32_SFLOAT},
-		  std::pair{&Vertex_UI::texCoord, VK_FORMAT_R32G32_SFLOAT}
+	using UIVertBindInfo_Packed = Core::Vulkan::Util::VertexBindInfo<Vertex_UI_Packed, 0, 0, VK_VERTEX_INPUT_RATE_VERTEX,
+		  std::pair{&Vertex_UI_Packed::position, VK_FORMAT_R32G32_SFLOAT},
+		  std::pair{&Vertex_UI_Packed::textureParam, VK_FORMAT_R8G8B8A8_UINT},
+		  std::pair{&Vertex_UI_Packed::color, VK_FORMAT_R8G8B8A8_UNORM},
+		  std::pair{&Vertex_UI_Packed::texCoord, VK_FORMAT_R16G16_UNORM}
 	>;
+
+	using Vertex_World = std::conditional_t<CompactVertices, Vertex_World_Packed, Vertex_World_F32>;
+	using WorldVertBindInfo = std::conditional_t<CompactVertices, WorldVertBindInfo_Packed, WorldVertBindInfo_F32>;
+
+	using Vertex_UI = std::conditional_t<CompactVertices, Vertex_UI_Packed, Vertex_UI_F32>;
+	using UIVertBindInfo = std::conditional_t<CompactVertices, UIVertBindInfo_Packed, UIVertBindInfo_F32>;
 }
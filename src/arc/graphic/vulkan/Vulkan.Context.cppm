@@ -40,6 +40,10 @@ export namespace Core::Vulkan{
 			return physicalDevice.queues.compute.index;
 		}
 
+		[[nodiscard]] auto transferFamily() const noexcept{
+			return physicalDevice.queues.transfer.index;
+		}
+
 		void init(){
 			instance.init();
 			if constexpr(EnableValidationLayers){
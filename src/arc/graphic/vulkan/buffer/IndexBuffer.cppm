@@ -51,6 +51,25 @@ export namespace Core::Vulkan{
 			return result;
 		}
 
+		/**
+		 * @brief runtime sized @link generateIndexReferences @endlink
+		 */
+		template <typename T = std::uint32_t, typename R, std::size_t size>
+		std::vector<T> generateIndexReferences(const std::size_t groupCount, const std::array<R, size> Reference){
+			std::vector<T> result(groupCount * size);
+
+			const auto [min, max] = std::ranges::minmax(Reference);
+			const T stride = static_cast<T>(max - min + 1);
+
+			for(std::size_t i = 0; i < groupCount; ++i){
+				for(std::size_t j = 0; j < size; ++j){
+					result[j + i * size] = static_cast<T>(Reference[j]) + static_cast<T>(i) * stride;
+				}
+			}
+
+			return result;
+		}
+
 		constexpr std::array StandardIndexBase{0u, 1u, 2u, 2u, 3u, 0u};
 		template <std::size_t size = 16'384>
 		constexpr std::array BatchIndices = generateIndexReferences<size, std::uint32_t>(StandardIndexBase);
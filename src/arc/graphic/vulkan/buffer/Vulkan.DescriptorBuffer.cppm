@@ -145,6 +145,25 @@ export namespace Core::Vulkan{
 			);
 		}
 
+		/**
+		 * @brief write a single element of an arrayed binding
+		 */
+		void loadImage(
+			const std::uint32_t binding,
+			const std::uint32_t arrayElement,
+			const VkDescriptorImageInfo& imageInfo,
+			const VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) const{
+
+			auto [info, size] = getImageInfo(imageInfo, descriptorType);
+
+			EXT::getDescriptorEXT(
+				self().getDevice(),
+				&info,
+				size,
+				self().getMappedData() + offsets[binding] + arrayElement * size
+			);
+		}
+
 		template <std::ranges::input_range Rng>
 			requires (std::convertible_to<std::ranges::range_const_reference_t<Rng>, const VkDescriptorImageInfo&>)
 		void loadImage(
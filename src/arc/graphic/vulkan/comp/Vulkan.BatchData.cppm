@@ -17,11 +17,59 @@ export namespace Graphic{
 		void* dataPtr{};
 	};
 
+	/**
+	 * @brief Releases one write capture of a batch frame, the frame is not transferred while any capture on it is held
+	 */
+	class FrameCapture{
+		std::atomic<std::uint32_t>* captures{};
+		/** @brief set while a consumer waits for the captures, the last release wakes it then */
+		const std::atomic<bool>* waited{};
+
+	public:
+		[[nodiscard]] FrameCapture() = default;
+
+		[[nodiscard]] FrameCapture(std::atomic<std::uint32_t>& captures, const std::atomic<bool>& waited) noexcept :
+			captures{&captures}, waited{&waited}{}
+
+		~FrameCapture(){
+			unlock();
+		}
+
+		FrameCapture(const FrameCapture& other) = delete;
+		FrameCapture& operator=(const FrameCapture& other) = delete;
+
+		FrameCapture(FrameCapture&& other) noexcept :
+			captures{std::exchange(other.captures, nullptr)}, waited{std::exchange(other.waited, nullptr)}{}
+
+		FrameCapture& operator=(FrameCapture&& other) noexcept{
+			if(this == &other) return *this;
+			unlock();
+			captures = std::exchange(other.captures, nullptr);
+			waited = std::exchange(other.waited, nullptr);
+			return *this;
+		}
+
+		void unlock() noexcept{
+			if(captures){
+				FrameCapture::release(*std::exchange(captures, nullptr), *waited);
+			}
+		}
+
+		/**
+		 * @brief pairs with the consumer setting `waited` before it reads the captures, either it sees zero or this sees the flag
+		 */
+		static void release(std::atomic<std::uint32_t>& captures, const std::atomic<bool>& waited) noexcept{
+			if(captures.fetch_sub(1, std::memory_order::seq_cst) == 1 && waited.load(std::memory_order::seq_cst)){
+				captures.notify_all();
+			}
+		}
+	};
+
 	struct LockableDrawArgs{
 		ImageIndex imageIndex{};
 		std::uint32_t validCount{};
 		void* dataPtr{};
-		std::shared_lock<std::shared_mutex> captureLock{};
+		FrameCapture captureLock{};
 	};
 
 
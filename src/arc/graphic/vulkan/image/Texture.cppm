@@ -12,13 +12,41 @@ import Core.Vulkan.Buffer.ExclusiveBuffer;
 import std;
 
 import Graphic.Pixmap;
+import Graphic.BlockCompression;
 import Core.File;
 import Geom.Vector2D;
 import Geom.Rect_Orthogonal;
 
 export namespace Core::Vulkan{
+	[[nodiscard]] constexpr VkFormat formatOf(const Graphic::BlockFormat format) noexcept{
+		return format == Graphic::BlockFormat::bc4 ? VK_FORMAT_BC4_UNORM_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+	}
+
+	/**
+	 * @brief bc4 holds the alpha alone in its red channel, sampled as white with that alpha like an RGBA page would be
+	 */
+	[[nodiscard]] constexpr VkComponentMapping swizzleOf(const Graphic::BlockFormat format) noexcept{
+		if(format == Graphic::BlockFormat::bc4){
+			return {VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_R};
+		}
+
+		return {};
+	}
+
+	/**
+	 * @brief the device samples the format and copies into and out of it, BC formats need the `textureCompressionBC` feature
+	 */
+	[[nodiscard]] bool supportsBlockFormat(VkPhysicalDevice physicalDevice, const Graphic::BlockFormat format){
+		VkFormatProperties properties{};
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, formatOf(format), &properties);
+
+		static constexpr VkFormatFeatureFlags Required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+		return (properties.optimalTilingFeatures & Required) == Required;
+	}
+
 	class Texture : public CombinedImage{
 		std::uint32_t mipLevels{};
+		VkFormat imageFormat{VK_FORMAT_R8G8B8A8_UNORM};
 
 	public:
 		using CombinedImage::CombinedImage;
@@ -41,7 +69,7 @@ export namespace Core::Vulkan{
 
 		[[nodiscard]] explicit Texture(std::vector<Graphic::Pixmap> layers) = delete;
 
-		void setImageView(const VkFormat format = VK_FORMAT_R8G8B8A8_UNORM){
+		void setImageView(const VkFormat format = VK_FORMAT_R8G8B8A8_UNORM, const VkComponentMapping components = {}){
 			if(!image) return;
 			defaultView = ImageView(device, {
 				.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
@@ -50,7 +78,7 @@ export namespace Core::Vulkan{
 				.image = image,
 				.viewType = layers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
 				.format = format,
-				.components = {},
+				.components = components,
 				.subresourceRange = VkImageSubresourceRange{
 					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
 					.baseMipLevel = 0,
@@ -64,6 +92,7 @@ export namespace Core::Vulkan{
 		void createEmpty(const Geom::USize2 size2, const std::uint32_t layers){
 			this->size = size2;
 			this->layers = layers;
+			imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
 
 			setMipmap();
 
@@ -92,7 +121,50 @@ export namespace Core::Vulkan{
 			setImageView();
 		}
 
+		/**
+		 * @brief Creates the image in a block format, every level has to be written as no mipmap can be blitted into it.
+		 * Copies out of it are allowed, so that a compaction can move block aligned regions.
+		 */
+		void createCompressed(const Geom::USize2 size2, const std::uint32_t levels, const Graphic::BlockFormat format){
+			this->size = size2;
+			this->layers = 1;
+			mipLevels = levels;
+			imageFormat = formatOf(format);
+
+			image = Image(
+				physicalDevice, device, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+				{
+					.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+					.pNext = nullptr,
+					.flags = 0,
+					.imageType = VK_IMAGE_TYPE_2D,
+					.format = imageFormat,
+					.extent = {
+						size.x, size.y, 1
+					},
+					.mipLevels = mipLevels,
+					.arrayLayers = 1,
+					.samples = VK_SAMPLE_COUNT_1_BIT,
+					.tiling = VK_IMAGE_TILING_OPTIMAL,
+					.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+					.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+					.queueFamilyIndexCount = 0,
+					.pQueueFamilyIndices = nullptr,
+					.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+			});
+
+			setImageView(imageFormat, swizzleOf(format));
+		}
+
+		[[nodiscard]] VkFormat getFormat() const noexcept{ return imageFormat; }
+
+		[[nodiscard]] bool isCompressed() const noexcept{ return imageFormat != VK_FORMAT_R8G8B8A8_UNORM; }
+
 		Graphic::Pixmap exportToPixmap(TransientCommand&& commandBuffer) const{
+			if(isCompressed()){
+				throw std::runtime_error("Block compressed textures cannot be exported");
+			}
+
 			const StagingBuffer stagingBuffer{physicalDevice, device, size.area() * Graphic::Pixmap::Channels,
 				VK_BUFFER_USAGE_TRANSFER_DST_BIT
 			};
@@ -208,6 +280,7 @@ export namespace Core::Vulkan{
 	public:
 		void completeLoad(TransientCommand&& commandBuffer, VkBuffer dataSource){
 			setMipmap();
+			imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
 
 			image = Image(
 				physicalDevice, device, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
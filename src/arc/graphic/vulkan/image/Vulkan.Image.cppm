@@ -574,7 +574,24 @@ export namespace Core::Vulkan{
 	class ImageView : public ext::wrapper<VkImageView>{
 		ext::dependency<VkDevice> device{};
 
+		static inline std::shared_mutex listenerMutex{};
+		static inline std::vector<std::pair<const void*, std::function<void(VkImageView)>>> destroyListeners{};
+
 	public:
+		/**
+		 * @brief thread safe, `listener` is invoked with every view right before it is destroyed,
+		 * caches keyed by the handle drop it there as a later view may get the same handle
+		 */
+		static void addDestroyListener(const void* owner, std::function<void(VkImageView)> listener){
+			std::unique_lock lk{listenerMutex};
+			destroyListeners.emplace_back(owner, std::move(listener));
+		}
+
+		static void removeDestroyListener(const void* owner){
+			std::unique_lock lk{listenerMutex};
+			std::erase_if(destroyListeners, [owner](const auto& pair){ return pair.first == owner; });
+		}
+
 		ImageView() = default;
 
 		ImageView(VkDevice device, const VkImageViewCreateInfo& createInfo) : device{device}{
@@ -610,7 +627,16 @@ export namespace Core::Vulkan{
 			          }, viewType, flags){}
 
 		~ImageView(){
-			if(device) vkDestroyImageView(device, handle, nullptr);
+			if(!device) return;
+
+			if(handle){
+				std::shared_lock lk{listenerMutex};
+				for(const auto& listener : destroyListeners | std::views::values){
+					listener(handle);
+				}
+			}
+
+			vkDestroyImageView(device, handle, nullptr);
 		}
 
 		ImageView(const ImageView& other) = delete;
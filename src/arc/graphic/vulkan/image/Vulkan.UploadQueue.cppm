@@ -0,0 +1,515 @@
+module;
+
+#include <vulkan/vulkan.h>
+
+export module Core.Vulkan.UploadQueue;
+
+import Core.Vulkan.Context;
+import Core.Vulkan.Texture;
+import Core.Vulkan.Image;
+import Core.Vulkan.CommandPool;
+import Core.Vulkan.Semaphore;
+import Core.Vulkan.Buffer.CommandBuffer;
+import Core.Vulkan.Buffer.ExclusiveBuffer;
+
+import Graphic.Pixmap;
+import Graphic.BlockCompression;
+import Geom.Vector2D;
+import Geom.Rect_Orthogonal;
+import std;
+
+export namespace Core::Vulkan{
+	/**
+	 * @brief Stages texture writes in a ring buffer and submits them in batches instead of one waited command per image.
+	 *
+	 * With a dedicated transfer family the copies run on it, the images are handed over and back with queue family
+	 * ownership transfers, and the graphic queue regenerates the mipmaps as blits are not available on transfer queues.
+	 * Every submission signals one @link TimelineSemaphore @endlink, a @link Ticket @endlink is the value the batch completes with.
+	 *
+	 * The last submission of a batch is always on the primary graphic queue, so frames submitted after @link flush @endlink
+	 * sample the written images without any wait. Not thread safe, use it on the thread submitting the frames.
+	 */
+	class UploadQueue{
+	public:
+		using Ticket = std::uint64_t;
+
+		/** @brief a larger pixmap gets a staging buffer of its own */
+		static constexpr VkDeviceSize DefaultRingSize{VkDeviceSize{64} << 20};
+		static constexpr VkDeviceSize StagingAlignment{16};
+
+	private:
+		struct Copy{
+			VkImage image{};
+			VkBuffer buffer{};
+			VkDeviceSize offset{};
+			Geom::OrthoRectUInt region{};
+			std::uint32_t mipLevel{};
+		};
+
+		struct Target{
+			VkImage image{};
+			std::uint32_t mipLevels{};
+			/** @brief every region written in the batch, the mipmaps are generated over it */
+			Geom::OrthoRectUInt bound{};
+			/** @brief the image is in shader read layout, otherwise its content is undefined and discarded */
+			bool readable{};
+			/** @brief every level is written, nothing is generated, e.g. block compressed images */
+			bool complete{};
+		};
+
+		/**
+		 * @brief resources of a submitted batch, released once the timeline passes its ticket
+		 */
+		struct Retired{
+			Ticket ticket{};
+			VkDeviceSize ringBegin{};
+			VkDeviceSize ringEnd{};
+			std::vector<CommandBuffer> commands{};
+			std::vector<StagingBuffer> dedicated{};
+		};
+
+		const Context* context{};
+		VkQueue graphicQueue{};
+		VkQueue transferQueue{};
+		bool dedicatedTransfer{};
+
+		CommandPool graphicPool{};
+		CommandPool transferPool{};
+		TimelineSemaphore timeline{};
+		Ticket lastTicket{};
+
+		StagingBuffer ring{};
+		VkDeviceSize ringCapacity{};
+		VkDeviceSize batchBegin{};
+		VkDeviceSize ringHead{};
+
+		std::vector<Copy> copies{};
+		std::vector<Target> targets{};
+		std::vector<StagingBuffer> dedicated{};
+		std::deque<Retired> retired{};
+
+		/** @brief images every mip level of which is in shader read layout */
+		std::unordered_set<VkImage> readableImages{};
+
+	public:
+		[[nodiscard]] UploadQueue() = default;
+
+		[[nodiscard]] explicit UploadQueue(const Context& context, const VkDeviceSize ringSize = DefaultRingSize) :
+			context{&context},
+			graphicQueue{context.device.getPrimaryGraphicsQueue()},
+			transferQueue{context.physicalDevice.queues.hasDedicatedTransfer() ? context.device.getPrimaryTransferQueue() : graphicQueue},
+			dedicatedTransfer{context.physicalDevice.queues.hasDedicatedTransfer()},
+			graphicPool{context.device, context.graphicFamily(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT},
+			transferPool{context.device, context.transferFamily(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT},
+			timeline{context.device},
+			ring{context.physicalDevice, context.device, ringSize},
+			ringCapacity{ringSize}{}
+
+		~UploadQueue(){
+			if(context){
+				flush();
+				timeline.wait(lastTicket);
+			}
+		}
+
+		UploadQueue(const UploadQueue& other) = delete;
+		UploadQueue(UploadQueue&& other) noexcept = delete;
+		UploadQueue& operator=(const UploadQueue& other) = delete;
+		UploadQueue& operator=(UploadQueue&& other) noexcept = delete;
+
+		/**
+		 * @brief Creates the image of the texture and stages the pixmap as its whole content.
+		 */
+		void load(Texture& texture, const Graphic::Pixmap& pixmap){
+			texture.createEmpty(pixmap.size2D(), 1);
+
+			//a new image, whatever owned the handle before is gone
+			readableImages.erase(texture.getImage().get());
+
+			write(texture, pixmap, Geom::OrthoRectUInt{pixmap.size2D()});
+		}
+
+		/**
+		 * @brief Stages the pixmap into `region` of the first layer, the content lands with the next @link flush @endlink.
+		 */
+		void write(const Texture& texture, const Graphic::Pixmap& pixmap, const Geom::OrthoRectUInt region){
+			write(texture, std::span{reinterpret_cast<const std::byte*>(pixmap.data()), pixmap.sizeBytes()}, region);
+		}
+
+		/**
+		 * @brief Stages tightly packed RGBA pixels into `region` of the first layer, e.g. straight out of a mapped file.
+		 */
+		void write(const Texture& texture, const std::span<const std::byte> pixels, const Geom::OrthoRectUInt region){
+			Copy copy{texture.getImage().get(), nullptr, 0, region};
+			std::tie(copy.buffer, copy.offset) = stage(pixels);
+
+			copies.push_back(copy);
+
+			if(const auto target = std::ranges::find(targets, copy.image, &Target::image); target != targets.end()){
+				target->bound.expandBy(region);
+			}else{
+				targets.push_back(Target{
+					.image = copy.image,
+					.mipLevels = texture.getMipLevels(),
+					.bound = region,
+					.readable = readableImages.contains(copy.image)
+				});
+			}
+		}
+
+		/**
+		 * @brief Stages encoded blocks into `region` of the first level of a block compressed texture, no mipmap is generated.
+		 * @param region aligned to the blocks, its size may only be unaligned where it reaches the edge of the image
+		 */
+		void writeBlocks(const Texture& texture, const std::span<const std::byte> blocks, const Geom::OrthoRectUInt region){
+			Copy copy{texture.getImage().get(), nullptr, 0, region};
+			std::tie(copy.buffer, copy.offset) = stage(blocks);
+
+			copies.push_back(copy);
+
+			if(const auto target = std::ranges::find(targets, copy.image, &Target::image); target != targets.end()){
+				target->bound.expandBy(region);
+			}else{
+				targets.push_back(Target{
+					.image = copy.image,
+					.mipLevels = texture.getMipLevels(),
+					.bound = region,
+					.readable = readableImages.contains(copy.image),
+					.complete = true
+				});
+			}
+		}
+
+		/**
+		 * @brief Creates the image of the texture in the block format and stages every level of it, no mipmap is generated.
+		 */
+		void load(Texture& texture, const Graphic::CompressedView& compressed){
+			texture.createCompressed(compressed.size, compressed.mipLevels, compressed.format);
+
+			const VkImage image = texture.getImage().get();
+			readableImages.erase(image);
+
+			for(std::uint32_t level = 0; level < compressed.mipLevels; ++level){
+				Copy copy{image, nullptr, 0, Geom::OrthoRectUInt{Graphic::mipExtent(compressed.size, level)}, level};
+				std::tie(copy.buffer, copy.offset) = stage(compressed.level(level));
+
+				copies.push_back(copy);
+
+				//staging may have flushed the levels before along with the target, the copy needs one in its own batch
+				if(!std::ranges::contains(targets, image, &Target::image)){
+					targets.push_back(Target{
+						.image = image,
+						.mipLevels = compressed.mipLevels,
+						.bound = Geom::OrthoRectUInt{compressed.size},
+						.readable = readableImages.contains(image),
+						.complete = true
+					});
+				}
+			}
+		}
+
+		/**
+		 * @brief Records and submits every staged write.
+		 * @return the ticket all writes staged so far complete with
+		 */
+		Ticket flush();
+
+		/**
+		 * @brief the image was put in shader read layout outside of the queue, e.g. cleared, later writes keep its content
+		 */
+		void markReadable(VkImage image){
+			readableImages.insert(image);
+		}
+
+		[[nodiscard]] bool finished(const Ticket ticket) const{
+			return timeline.getValue() >= ticket;
+		}
+
+		void wait(const Ticket ticket) const{
+			timeline.wait(ticket);
+		}
+
+		[[nodiscard]] std::size_t pendingWrites() const noexcept{
+			return copies.size();
+		}
+
+		[[nodiscard]] const TimelineSemaphore& getTimeline() const noexcept{
+			return timeline;
+		}
+
+		/**
+		 * @brief frees the staging memory and command buffers of the batches the device has finished
+		 */
+		void collect(){
+			release(timeline.getValue());
+		}
+
+	private:
+		void release(const Ticket reached){
+			while(!retired.empty() && retired.front().ticket <= reached){
+				retired.pop_front();
+			}
+		}
+
+		/**
+		 * @return the buffer and offset the bytes are copied to, the ring if they fit in it
+		 */
+		std::pair<VkBuffer, VkDeviceSize> stage(const std::span<const std::byte> bytes){
+			const VkDeviceSize size = bytes.size();
+
+			if(const auto offset = allocateStaging(size)){
+				ring.memory.loadData(bytes.data(), size, *offset);
+				return {ring.get(), *offset};
+			}
+
+			const auto& staging = dedicated.emplace_back(context->physicalDevice, context->device, size);
+			staging.memory.loadData(bytes.data(), size);
+			return {staging.get(), 0};
+		}
+
+		std::optional<VkDeviceSize> allocateStaging(const VkDeviceSize size){
+			if(size > ringCapacity) return std::nullopt;
+
+			VkDeviceSize begin = (ringHead + StagingAlignment - 1) / StagingAlignment * StagingAlignment;
+
+			//a batch reads one contiguous range, submit it before wrapping around
+			if(begin + size > ringCapacity){
+				flush();
+				begin = batchBegin = 0;
+			}
+
+			const VkDeviceSize end = begin + size;
+
+			//wait for the newest batch still reading the range, the older ones have completed by then
+			Ticket blocking{};
+			for(const auto& batch : retired){
+				if(batch.ringBegin < end && begin < batch.ringEnd){
+					blocking = batch.ticket;
+				}
+			}
+
+			if(blocking){
+				timeline.wait(blocking);
+			}
+
+			release(std::max(blocking, timeline.getValue()));
+
+			ringHead = end;
+			return begin;
+		}
+
+		void recordCopies(VkCommandBuffer commandBuffer) const{
+			for(const auto& [image, buffer, offset, region, mipLevel] : copies){
+				const VkBufferImageCopy copy{
+					.bufferOffset = offset,
+					.bufferRowLength = 0,
+					.bufferImageHeight = 0,
+					.imageSubresource = {
+						.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+						.mipLevel = mipLevel,
+						.baseArrayLayer = 0,
+						.layerCount = 1
+					},
+					.imageOffset = {static_cast<std::int32_t>(region.getSrcX()), static_cast<std::int32_t>(region.getSrcY()), 0},
+					.imageExtent = {region.getWidth(), region.getHeight(), 1}
+				};
+
+				vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+			}
+		}
+
+		void recordMipmaps(VkCommandBuffer commandBuffer) const{
+			for(const auto& target : targets | std::views::filter(std::not_fn(&Target::complete))){
+				Util::generateMipmaps(commandBuffer, target.image, target.bound.as<int>(), target.mipLevels);
+			}
+
+			//left in shader read layout the same way the generation does
+			if(std::ranges::any_of(targets, &Target::complete)){
+				recordBarriers(commandBuffer, targets | std::views::filter(&Target::complete), [](VkImageMemoryBarrier2& barrier, const Target&){
+					barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+					barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+					barrier.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+					barrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+				});
+			}
+		}
+
+		/**
+		 * @param transition fills the layouts, access and stages of every barrier
+		 */
+		template <std::ranges::input_range Rng, std::invocable<VkImageMemoryBarrier2&, const Target&> Transition>
+		static void recordBarriers(VkCommandBuffer commandBuffer, Rng&& images, Transition transition){
+			std::vector<VkImageMemoryBarrier2> barriers{};
+
+			for(const Target& target : images){
+				auto& barrier = barriers.emplace_back(VkImageMemoryBarrier2{
+					.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.image = target.image,
+					.subresourceRange = {
+						.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+						.baseMipLevel = 0,
+						.levelCount = target.mipLevels,
+						.baseArrayLayer = 0,
+						.layerCount = 1
+					}
+				});
+
+				transition(barrier, target);
+			}
+
+			Util::imageBarrier(commandBuffer, barriers);
+		}
+
+		Ticket submit(VkQueue queue, VkCommandBuffer commandBuffer, const Ticket waitTicket, const VkPipelineStageFlags2 waitStage){
+			const VkCommandBufferSubmitInfo commandInfo{
+				.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+				.commandBuffer = commandBuffer,
+				.deviceMask = 0
+			};
+
+			const VkSemaphoreSubmitInfo waitInfo = timeline.getSubmitInfo(waitTicket, waitStage);
+			const VkSemaphoreSubmitInfo signalInfo = timeline.getSubmitInfo(++lastTicket, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+			const VkSubmitInfo2 submitInfo{
+				.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+				.waitSemaphoreInfoCount = waitTicket ? 1u : 0u,
+				.pWaitSemaphoreInfos = &waitInfo,
+				.commandBufferInfoCount = 1,
+				.pCommandBufferInfos = &commandInfo,
+				.signalSemaphoreInfoCount = 1,
+				.pSignalSemaphoreInfos = &signalInfo
+			};
+
+			if(const auto result = vkQueueSubmit2(queue, 1, &submitInfo, nullptr)){
+				std::println(std::cerr, "[Vulkan] [{}] Failed to submit the upload batch!", static_cast<int>(result));
+				throw std::runtime_error("Failed to submit the upload batch!");
+			}
+
+			return lastTicket;
+		}
+	};
+}
+
+module : private;
+
+Core::Vulkan::UploadQueue::Ticket Core::Vulkan::UploadQueue::flush(){
+	if(copies.empty()) return lastTicket;
+
+	Retired batch{
+		.ringBegin = batchBegin,
+		.ringEnd = ringHead,
+		.dedicated = std::move(dedicated)
+	};
+
+	const auto obtain = [&batch](const CommandPool& pool) -> VkCommandBuffer{
+		const auto& command = batch.commands.emplace_back(pool.obtain());
+		command.begin();
+		return command.get();
+	};
+
+	const auto toTransferDst = [](VkImageMemoryBarrier2& barrier, const Target& target){
+		barrier.oldLayout = target.readable ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	};
+
+	if(!dedicatedTransfer){
+		const VkCommandBuffer command = obtain(graphicPool);
+
+		recordBarriers(command, targets, [&](VkImageMemoryBarrier2& barrier, const Target& target){
+			toTransferDst(barrier, target);
+			//earlier frames only read it, an execution dependency is enough
+			barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+			barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+			barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+		});
+
+		recordCopies(command);
+		recordMipmaps(command);
+
+		batch.commands.back().end();
+		submit(graphicQueue, command, 0, VK_PIPELINE_STAGE_2_NONE);
+	}else{
+		const std::uint32_t graphicFamily = context->graphicFamily();
+		const std::uint32_t transferFamily = context->transferFamily();
+
+		Ticket released{};
+
+		//images holding content are released by the graphic queue first, the others are simply discarded
+		if(std::ranges::any_of(targets, &Target::readable)){
+			const VkCommandBuffer command = obtain(graphicPool);
+
+			recordBarriers(command, targets | std::views::filter(&Target::readable), [&](VkImageMemoryBarrier2& barrier, const Target& target){
+				toTransferDst(barrier, target);
+				barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+				barrier.srcQueueFamilyIndex = graphicFamily;
+				barrier.dstQueueFamilyIndex = transferFamily;
+			});
+
+			batch.commands.back().end();
+			released = submit(graphicQueue, command, 0, VK_PIPELINE_STAGE_2_NONE);
+		}
+
+		{
+			const VkCommandBuffer command = obtain(transferPool);
+
+			//the discarded images are transitioned here without an ownership transfer
+			recordBarriers(command, targets, [&](VkImageMemoryBarrier2& barrier, const Target& target){
+				toTransferDst(barrier, target);
+				barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+				barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+				if(target.readable){
+					barrier.srcQueueFamilyIndex = graphicFamily;
+					barrier.dstQueueFamilyIndex = transferFamily;
+				}
+			});
+
+			recordCopies(command);
+
+			recordBarriers(command, targets, [&](VkImageMemoryBarrier2& barrier, const Target&){
+				barrier.oldLayout = barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+				barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+				barrier.srcQueueFamilyIndex = transferFamily;
+				barrier.dstQueueFamilyIndex = graphicFamily;
+			});
+
+			batch.commands.back().end();
+			released = submit(transferQueue, command, released, VK_PIPELINE_STAGE_2_COPY_BIT);
+		}
+
+		{
+			const VkCommandBuffer command = obtain(graphicPool);
+
+			recordBarriers(command, targets, [&](VkImageMemoryBarrier2& barrier, const Target&){
+				barrier.oldLayout = barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+				barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+				barrier.srcQueueFamilyIndex = transferFamily;
+				barrier.dstQueueFamilyIndex = graphicFamily;
+			});
+
+			recordMipmaps(command);
+
+			batch.commands.back().end();
+			submit(graphicQueue, command, released, VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT);
+		}
+	}
+
+	for(const auto& target : targets){
+		readableImages.insert(target.image);
+	}
+
+	batch.ticket = lastTicket;
+	retired.push_back(std::move(batch));
+
+	copies.clear();
+	targets.clear();
+	batchBegin = ringHead;
+
+	return lastTicket;
+}
@@ -46,6 +46,17 @@ export namespace Core::Vulkan{
 			features.descriptorBindingSampledImageUpdateAfterBind = true;
 			features.descriptorBindingUpdateUnusedWhilePending = true;
 			features.descriptorBindingUniformBufferUpdateAfterBind = true;
+			//bindless texture table
+			features.descriptorBindingPartiallyBound = true;
+			features.shaderSampledImageArrayNonUniformIndexing = true;
+
+			return features;
+		}()};
+
+		constexpr VkPhysicalDeviceTimelineSemaphoreFeatures TimelineSemaphoreFeatures{[]{
+			VkPhysicalDeviceTimelineSemaphoreFeatures features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES};
+
+			features.timelineSemaphore = true;
 
 			return features;
 		}()};
@@ -107,6 +118,7 @@ export namespace Core::Vulkan{
 			RequiredDescriptorIndexingFeatures,
 			PhysicalDeviceBufferDeviceAddressFeatures,
 			DescriptorBufferFeatures,
+			TimelineSemaphoreFeatures,
 		};
 	}
 
@@ -114,6 +126,7 @@ export namespace Core::Vulkan{
 	class LogicalDevice : public ext::wrapper<VkDevice>{
 		std::vector<VkQueue> graphicQueues{};
 		std::vector<VkQueue> computeQueues{};
+		std::vector<VkQueue> transferQueues{};
 		VkQueue presentQueue{};
 
 	public:
@@ -138,6 +151,8 @@ export namespace Core::Vulkan{
 
 		[[nodiscard]] VkQueue getPrimaryComputeQueue() const noexcept{ return computeQueues.front(); }
 
+		[[nodiscard]] VkQueue getPrimaryTransferQueue() const noexcept{ return transferQueues.front(); }
+
 
 		LogicalDevice(const LogicalDevice& other) = delete;
 
@@ -153,7 +168,7 @@ export namespace Core::Vulkan{
 			std::vector<std::vector<float>> queueCreatePriorityInfos{};
 
 
-			const std::unordered_set uniqueQueueFamilies{indices.graphic, indices.compute, indices.present};
+			const std::unordered_set uniqueQueueFamilies{indices.graphic, indices.compute, indices.present, indices.transfer};
 
 			for(const auto [index, count] : uniqueQueueFamilies){
 				auto& info = queueCreateInfos.emplace_back();
@@ -176,6 +191,11 @@ export namespace Core::Vulkan{
 			deviceFeatures2.pNext = RequiredFeatures::extChain.getFirst();//const_cast<decltype(RequiredFeatures::extChain)::First*>(&RequiredFeatures::extChain.first);
 			deviceFeatures2.features = RequiredFeatures::RequiredFeatures;
 
+			//block compressed textures are optional, used where the device supports them
+			VkPhysicalDeviceFeatures availableFeatures{};
+			vkGetPhysicalDeviceFeatures(physicalDevice, &availableFeatures);
+			deviceFeatures2.features.textureCompressionBC = availableFeatures.textureCompressionBC;
+
 
 			VkDeviceCreateInfo createInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
 			createInfo.pNext = &deviceFeatures2;
@@ -202,6 +222,7 @@ export namespace Core::Vulkan{
 
 			indices.graphic.createQueues(handle, graphicQueues);
 			indices.compute.createQueues(handle, computeQueues);
+			indices.transfer.createQueues(handle, transferQueues);
 			vkGetDeviceQueue(handle, indices.present.index, 0, &presentQueue);
 		}
 	};
@@ -45,6 +45,12 @@ export namespace Core::Vulkan{
 		FamilyData graphic{};
 		FamilyData present{};
 		FamilyData compute{};
+		/** @brief a transfer only family when the device has one, the graphic family otherwise */
+		FamilyData transfer{};
+
+		[[nodiscard]] constexpr bool hasDedicatedTransfer() const noexcept{
+			return transfer.index != graphic.index;
+		}
 
 		[[nodiscard]] constexpr bool isComplete() const noexcept{
 			return graphic && present && compute;
@@ -81,6 +87,22 @@ export namespace Core::Vulkan{
 					break;
 				}
 			}
+
+			//copy engines, usually able to run beside the graphic work
+			for(const auto& [index, queueFamily] : queueFamilies | std::ranges::views::enumerate){
+				if(!queueFamily.queueCount) continue;
+
+				//coarse granularity would restrict the copied regions of atlas pages
+				const auto [gw, gh, gd] = queueFamily.minImageTransferGranularity;
+				if(gw != 1 || gh != 1) continue;
+
+				if((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queueFamily.queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))){
+					transfer = {static_cast<std::uint32_t>(index), queueFamily.queueCount};
+					break;
+				}
+			}
+
+			if(!transfer) transfer = graphic;
 		}
 	};
 
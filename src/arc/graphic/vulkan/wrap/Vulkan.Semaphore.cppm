@@ -67,5 +67,85 @@ export namespace Core::Vulkan{
 			vkSignalSemaphore(device, &signalInfo);
 		}
 	};
+
+	/**
+	 * @brief A semaphore counting up, queues signal and wait on values of it and the host can poll it.
+	 */
+	class TimelineSemaphore : public ext::wrapper<VkSemaphore>{
+		ext::dependency<VkDevice> device{};
+
+	public:
+		[[nodiscard]] TimelineSemaphore() = default;
+
+		[[nodiscard]] explicit TimelineSemaphore(VkDevice device, const std::uint64_t initialValue = 0) : device{device}{
+			const VkSemaphoreTypeCreateInfo typeInfo{
+					.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+					.pNext = nullptr,
+					.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+					.initialValue = initialValue
+				};
+
+			const VkSemaphoreCreateInfo semaphoreInfo{
+					.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+					.pNext = &typeInfo,
+					.flags = 0
+				};
+
+			if(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &handle) != VK_SUCCESS){
+				throw std::runtime_error("Failed to create Timeline Semaphore!");
+			}
+		}
+
+		TimelineSemaphore(const TimelineSemaphore& other) = delete;
+
+		TimelineSemaphore(TimelineSemaphore&& other) noexcept = default;
+
+		TimelineSemaphore& operator=(const TimelineSemaphore& other) = delete;
+
+		TimelineSemaphore& operator=(TimelineSemaphore&& other) noexcept{
+			if(this == &other) return *this;
+			if(device)vkDestroySemaphore(device, handle, nullptr);
+			wrapper::operator =(std::move(other));
+			device = std::move(other.device);
+			return *this;
+		}
+
+		~TimelineSemaphore(){
+			if(device)vkDestroySemaphore(device, handle, nullptr);
+		}
+
+		[[nodiscard]] VkSemaphoreSubmitInfo getSubmitInfo(const std::uint64_t value, const VkPipelineStageFlags2 flags) const{
+			return {
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+				.pNext = nullptr,
+				.semaphore = handle,
+				.value = value,
+				.stageMask = flags,
+				.deviceIndex = 0
+			};
+		}
+
+		[[nodiscard]] std::uint64_t getValue() const{
+			std::uint64_t value{};
+			vkGetSemaphoreCounterValue(device, handle, &value);
+			return value;
+		}
+
+		/**
+		 * @return false on timeout
+		 */
+		bool wait(const std::uint64_t value, const std::uint64_t timeout = std::numeric_limits<std::uint64_t>::max()) const{
+			const VkSemaphoreWaitInfo waitInfo{
+				.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.semaphoreCount = 1,
+				.pSemaphores = &handle,
+				.pValues = &value
+			};
+
+			return vkWaitSemaphores(device, &waitInfo, timeout) == VK_SUCCESS;
+		}
+	};
 }
 
@@ -0,0 +1,96 @@
+module;
+
+#include "../src/arc/math/simd.hpp"
+
+#if SIMD_X86 && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+export module Math.SIMD;
+
+import std;
+
+export namespace Math::SIMD{
+	/**
+	 * @brief Instruction sets the runtime dispatched kernels are specialized for, ordered by capability
+	 */
+	enum struct InstructionSet : unsigned{
+		scalar,
+		sse2,
+		sse4_1,
+		avx2,
+	};
+
+	[[nodiscard]] constexpr std::string_view nameOf(const InstructionSet set) noexcept{
+		switch(set){
+			case InstructionSet::scalar : return "scalar";
+			case InstructionSet::sse2 : return "sse2";
+			case InstructionSet::sse4_1 : return "sse4.1";
+			case InstructionSet::avx2 : return "avx2";
+			default : std::unreachable();
+		}
+	}
+}
+
+namespace Math::SIMD{
+	InstructionSet detect() noexcept{
+#if SIMD_X86
+#if defined(_MSC_VER)
+		std::array<int, 4> info{};
+
+		__cpuid(info.data(), 0);
+		const int maxId = info[0];
+
+		__cpuid(info.data(), 1);
+		const bool sse2 = info[3] & (1 << 26);
+		const bool sse4_1 = info[2] & (1 << 19);
+		const bool osxsave = info[2] & (1 << 27);
+		const bool avx = info[2] & (1 << 28);
+
+		bool avx2 = false;
+		if(maxId >= 7){
+			__cpuidex(info.data(), 7, 0);
+			avx2 = info[1] & (1 << 5);
+		}
+
+		//OS must save the ymm registers
+		const bool osAvx = osxsave && avx && (_xgetbv(0) & 0b110) == 0b110;
+#else
+		__builtin_cpu_init();
+		const bool sse2 = __builtin_cpu_supports("sse2");
+		const bool sse4_1 = __builtin_cpu_supports("sse4.1");
+		const bool avx2 = __builtin_cpu_supports("avx2");
+		constexpr bool osAvx = true;
+#endif
+
+		if(avx2 && osAvx) return InstructionSet::avx2;
+		if(sse4_1) return InstructionSet::sse4_1;
+		if(sse2) return InstructionSet::sse2;
+#endif
+
+		return InstructionSet::scalar;
+	}
+
+	const InstructionSet detected = detect();
+	std::atomic<InstructionSet> limit{InstructionSet::avx2};
+}
+
+export namespace Math::SIMD{
+	[[nodiscard]] InstructionSet getDetectedInstructionSet() noexcept{
+		return detected;
+	}
+
+	/**
+	 * @brief the instruction set kernels should use, the detected one clamped by @link setInstructionSetLimit @endlink
+	 */
+	[[nodiscard]] InstructionSet getInstructionSet() noexcept{
+		return std::min(detected, limit.load(std::memory_order::relaxed));
+	}
+
+	/**
+	 * @brief Force kernels down to a lower instruction set, mainly for benchmarks and A/B tests
+	 */
+	void setInstructionSetLimit(const InstructionSet set) noexcept{
+		limit.store(set, std::memory_order::relaxed);
+	}
+}
@@ -88,7 +88,7 @@ export namespace Math {
             boxes_widthAscend = {std::ranges::begin(targets), std::ranges::end(targets)};
             boxes_heightAscend = {std::ranges::begin(targets), std::ranges::end(targets)};
 
-    	    std::ranges::transform(targets, std::inserter(all, all.end()));
+    	    all.insert(std::ranges::begin(targets), std::ranges::end(targets));
     	}
 
 		void sortData() {
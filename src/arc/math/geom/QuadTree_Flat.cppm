@@ -0,0 +1,619 @@
+module;
+
+#include <cassert>
+
+export module Geom.quad_tree.flat;
+
+export import Geom.Rect_Orthogonal;
+export import Geom.Vector2D;
+export import Geom.QuadTree.Interface;
+
+import Geom.quad_tree;
+import ext.concepts;
+import ext.open_hash_map;
+import std;
+
+namespace Geom{
+	/**
+	 * @brief Quad tree with all nodes stored in one array and all items stored in one slot pool.
+	 *
+	 * Children of a node are always allocated as four contiguous nodes and are kept cached after unsplit,
+	 * items of a node form an index-linked list inside the slot pool, each slot caches the bound the item had when it was placed.
+	 *
+	 * Use @link synchronize @endlink each tick instead of clear-and-reinsert, only items whose bound left their cell are moved.
+	 * Items are looked up by their stable id when they have one (see @link quad_tree_evaluateable_traits::key_of @endlink),
+	 * so an owner that moves its items in memory, like the dense entity group, does not force them to be reinserted.
+	 */
+	export
+	template <typename ItemTy, ext::number T = float>
+	struct quad_tree_flat{
+		using rect_type = Rect_Orthogonal<T>;
+		using trait = quad_tree_evaluateable_traits<ItemTy, T>;
+		using index_type = unsigned;
+
+		static constexpr index_type invalid_index = std::numeric_limits<index_type>::max();
+		static constexpr index_type root_index = 0;
+
+		static constexpr unsigned MaximumItemCount = 4;
+		static constexpr unsigned MaximumDepth = 16;
+
+	private:
+		/** @brief bot_lft, bot_rit, top_lft, top_rit, same as @code Rect_Orthogonal::split @endcode */
+		static constexpr index_type ChildCount = 4;
+
+		struct node{
+			rect_type boundary{};
+			index_type parent{invalid_index};
+			/** @brief index of the first one of four contiguous children, invalid if never split */
+			index_type children{invalid_index};
+			index_type first_item{invalid_index};
+			unsigned item_count{};
+			unsigned branch_size{};
+			unsigned depth{};
+			bool leaf{true};
+
+			[[nodiscard]] bool has_valid_children() const noexcept{
+				return !leaf && branch_size != item_count;
+			}
+		};
+
+		struct item_slot{
+			ItemTy* item{};
+			/** @brief key of the item in @link locations @endlink, kept so that a stale item pointer is never dereferenced on removal */
+			typename trait::key_type key{trait::empty_key};
+			rect_type bound{};
+			index_type node{invalid_index};
+			index_type prev{invalid_index};
+			index_type next{invalid_index};
+			unsigned epoch{};
+		};
+
+		std::vector<node> nodes{};
+		std::vector<item_slot> slots{};
+		index_type free_slot{invalid_index};
+		unsigned epoch{};
+
+		ext::open_hash_map<typename trait::key_type, index_type> locations{trait::empty_key, 1024};
+
+		using query_stack = std::array<index_type, (MaximumDepth + 1) * (ChildCount - 1) + 1>;
+
+	public:
+		struct item_iterator{
+			using value_type = ItemTy*;
+			using difference_type = std::ptrdiff_t;
+
+			const item_slot* pool{};
+			index_type current{invalid_index};
+
+			[[nodiscard]] ItemTy* operator*() const noexcept{
+				return pool[current].item;
+			}
+
+			item_iterator& operator++() noexcept{
+				current = pool[current].next;
+				return *this;
+			}
+
+			item_iterator operator++(int) noexcept{
+				auto itr = *this;
+				++*this;
+				return itr;
+			}
+
+			friend bool operator==(const item_iterator& lhs, const item_iterator& rhs) noexcept{
+				return lhs.current == rhs.current;
+			}
+		};
+
+		struct item_range{
+			item_iterator first{};
+
+			[[nodiscard]] item_iterator begin() const noexcept{ return first; }
+			[[nodiscard]] item_iterator end() const noexcept{ return {first.pool, invalid_index}; }
+		};
+
+		/**
+		 * @brief read only view of a node, used to visit the tree structure (debug drawing, statistics...)
+		 */
+		struct node_view{
+			const quad_tree_flat* tree{};
+			index_type index{};
+
+			[[nodiscard]] rect_type get_boundary() const noexcept{ return tree->nodes[index].boundary; }
+
+			[[nodiscard]] unsigned size() const noexcept{ return tree->nodes[index].branch_size; }
+
+			[[nodiscard]] bool is_leaf() const noexcept{ return tree->nodes[index].leaf; }
+
+			[[nodiscard]] unsigned depth() const noexcept{ return tree->nodes[index].depth; }
+
+			[[nodiscard]] item_range get_items() const noexcept{
+				return {item_iterator{tree->slots.data(), tree->nodes[index].first_item}};
+			}
+		};
+
+		[[nodiscard]] quad_tree_flat(){
+			nodes.emplace_back();
+		}
+
+		[[nodiscard]] explicit quad_tree_flat(const rect_type& boundary){
+			nodes.push_back(node{.boundary = boundary});
+		}
+
+		[[nodiscard]] rect_type get_boundary() const noexcept{ return nodes[root_index].boundary; }
+
+		[[nodiscard]] unsigned size() const noexcept{ return nodes[root_index].branch_size; }
+
+		[[nodiscard]] std::size_t node_capacity() const noexcept{ return nodes.size(); }
+
+		[[nodiscard]] bool contains(const ItemTy& item) const noexcept{
+			return locations.contains(trait::key_of(item));
+		}
+
+		// ------------------------------------------------------------------------------
+		// modification
+		// ------------------------------------------------------------------------------
+
+		/**
+		 * @brief drop all items, the allocated nodes are kept for reuse
+		 */
+		void reserved_clear() noexcept{
+			const rect_type boundary = get_boundary();
+			for(node& n : nodes){
+				n.first_item = invalid_index;
+				n.item_count = n.branch_size = 0;
+				n.leaf = true;
+			}
+			nodes[root_index].boundary = boundary;
+
+			slots.clear();
+			free_slot = invalid_index;
+			locations.clear();
+		}
+
+		void clear() noexcept{
+			const rect_type boundary = get_boundary();
+			nodes.clear();
+			nodes.push_back(node{.boundary = boundary});
+
+			slots.clear();
+			free_slot = invalid_index;
+			locations.clear();
+		}
+
+		bool insert(ItemTy& item){
+			const rect_type bound = trait::bound_of(item);
+			if(!nodes[root_index].boundary.overlap_Exclusive(bound)) return false;
+
+			const auto key = trait::key_of(item);
+			const auto [itr, inserted] = locations.try_emplace(key, invalid_index);
+			if(!inserted) return false;
+
+			const index_type slot = acquire_slot();
+			itr->second = slot;
+			slots[slot].item = std::addressof(item);
+			slots[slot].key = key;
+			slots[slot].bound = bound;
+			slots[slot].epoch = epoch;
+
+			insert_from(root_index, slot);
+			return true;
+		}
+
+		bool remove(const ItemTy& item) noexcept{
+			const auto itr = locations.find(trait::key_of(item));
+			if(itr == locations.end()) return false;
+
+			const index_type slot = itr->second;
+			locations.erase(itr);
+			erase_slot(slot);
+			return true;
+		}
+
+		/**
+		 * @brief refresh the cached bound of the item, only moves it if the bound left its cell
+		 * @return false if the item is not in the tree or has left the root boundary (and therefore been removed)
+		 */
+		bool update(ItemTy& item){
+			const auto itr = locations.find(trait::key_of(item));
+			if(itr == locations.end()) return false;
+
+			slots[itr->second].item = std::addressof(item);
+			return relocate(itr->second);
+		}
+
+		/**
+		 * @brief make the tree contain exactly the given items, incrementally
+		 *
+		 * new items are inserted, existing items are relocated if necessary, items absent from the range are removed.
+		 */
+		template <std::ranges::input_range Rng>
+			requires std::convertible_to<std::ranges::range_reference_t<Rng>, ItemTy&>
+		void synchronize(Rng&& items){
+			++epoch;
+
+			for(ItemTy& item : items){
+				if(const auto itr = locations.find(trait::key_of(item)); itr != locations.end()){
+					const index_type slot = itr->second;
+					//the owner may have moved the item since the last tick, the key stays, the address does not
+					slots[slot].item = std::addressof(item);
+					slots[slot].epoch = epoch;
+					relocate(slot);
+				}else{
+					insert(item);
+				}
+			}
+
+			for(index_type slot = 0; slot < slots.size(); ++slot){
+				if(slots[slot].item && slots[slot].epoch != epoch){
+					locations.erase(slots[slot].key);
+					erase_slot(slot);
+				}
+			}
+		}
+
+	private:
+		[[nodiscard]] index_type acquire_slot(){
+			if(free_slot != invalid_index){
+				const index_type slot = free_slot;
+				free_slot = slots[slot].next;
+				slots[slot] = item_slot{};
+				return slot;
+			}
+
+			slots.emplace_back();
+			return static_cast<index_type>(slots.size() - 1);
+		}
+
+		void release_slot(const index_type slot) noexcept{
+			slots[slot] = item_slot{};
+			slots[slot].next = free_slot;
+			free_slot = slot;
+		}
+
+		void link(const index_type nodeIndex, const index_type slot) noexcept{
+			node& n = nodes[nodeIndex];
+			item_slot& s = slots[slot];
+
+			s.node = nodeIndex;
+			s.prev = invalid_index;
+			s.next = n.first_item;
+			if(n.first_item != invalid_index) slots[n.first_item].prev = slot;
+			n.first_item = slot;
+			++n.item_count;
+		}
+
+		void unlink(const index_type slot) noexcept{
+			item_slot& s = slots[slot];
+			node& n = nodes[s.node];
+
+			if(s.prev != invalid_index){
+				slots[s.prev].next = s.next;
+			}else{
+				n.first_item = s.next;
+			}
+
+			if(s.next != invalid_index) slots[s.next].prev = s.prev;
+
+			--n.item_count;
+			s.prev = s.next = invalid_index;
+		}
+
+		/**
+		 * @brief unlink the slot and remove it from the branch size of all its ancestors
+		 */
+		void erase_slot(const index_type slot) noexcept{
+			index_type current = slots[slot].node;
+			unlink(slot);
+
+			while(current != invalid_index){
+				--nodes[current].branch_size;
+				try_unsplit(current);
+				current = nodes[current].parent;
+			}
+
+			release_slot(slot);
+		}
+
+		[[nodiscard]] index_type get_wrappable_child(const index_type nodeIndex, const rect_type bound) const noexcept{
+			const node& n = nodes[nodeIndex];
+			assert(!n.leaf);
+
+			auto [midX, midY] = n.boundary.getCenter();
+
+			const bool top = bound.getSrcY() > midY;
+			const bool bottom = bound.getEndY() < midY;
+			const bool right = bound.getSrcX() > midX;
+			const bool left = bound.getEndX() < midX;
+
+			if(!(top || bottom) || !(left || right)) return invalid_index;
+
+			return n.children + (right ? 1 : 0) + (top ? 2 : 0);
+		}
+
+		void insert_from(index_type current, const index_type slot){
+			const rect_type bound = slots[slot].bound;
+
+			while(true){
+				++nodes[current].branch_size;
+
+				if(nodes[current].leaf){
+					if(nodes[current].item_count < MaximumItemCount || nodes[current].depth >= MaximumDepth){
+						link(current, slot);
+						return;
+					}
+
+					split(current);
+				}
+
+				const index_type child = get_wrappable_child(current, bound);
+				if(child == invalid_index){
+					link(current, slot);
+					return;
+				}
+
+				current = child;
+			}
+		}
+
+		void split(const index_type nodeIndex){
+			assert(nodes[nodeIndex].leaf);
+
+			if(nodes[nodeIndex].children == invalid_index){
+				const auto rects = nodes[nodeIndex].boundary.split();
+				const auto first = static_cast<index_type>(nodes.size());
+				const unsigned depth = nodes[nodeIndex].depth + 1;
+
+				//may reallocate, do not hold node references across this
+				for(const rect_type& rect : rects){
+					nodes.push_back(node{.boundary = rect, .parent = nodeIndex, .depth = depth});
+				}
+
+				nodes[nodeIndex].children = first;
+			}
+
+			nodes[nodeIndex].leaf = false;
+
+			index_type cur = nodes[nodeIndex].first_item;
+			while(cur != invalid_index){
+				const index_type next = slots[cur].next;
+
+				if(const index_type child = get_wrappable_child(nodeIndex, slots[cur].bound); child != invalid_index){
+					unlink(cur);
+					insert_from(child, cur);
+				}
+
+				cur = next;
+			}
+		}
+
+		void try_unsplit(const index_type nodeIndex) noexcept{
+			node& n = nodes[nodeIndex];
+			if(n.leaf || n.branch_size >= MaximumItemCount) return;
+
+			n.leaf = true;
+			for(index_type i = 0; i < ChildCount; ++i){
+				gather_to(n.children + i, nodeIndex);
+			}
+		}
+
+		/**
+		 * @brief move all items in the branch to the target node, the branch becomes empty leaves
+		 */
+		void gather_to(const index_type branch, const index_type target) noexcept{
+			if(nodes[branch].branch_size == 0) return;
+
+			if(!nodes[branch].leaf){
+				for(index_type i = 0; i < ChildCount; ++i){
+					gather_to(nodes[branch].children + i, target);
+				}
+			}
+
+			index_type cur = nodes[branch].first_item;
+			while(cur != invalid_index){
+				const index_type next = slots[cur].next;
+				link(target, cur);
+				cur = next;
+			}
+
+			nodes[branch].first_item = invalid_index;
+			nodes[branch].item_count = nodes[branch].branch_size = 0;
+			nodes[branch].leaf = true;
+		}
+
+		bool relocate(const index_type slot){
+			item_slot& s = slots[slot];
+			const rect_type bound = trait::bound_of(*s.item);
+			s.bound = bound;
+
+			index_type current = s.node;
+			const node& cell = nodes[current];
+
+			const bool inCell = current == root_index
+				? cell.boundary.overlap_Exclusive(bound)
+				: cell.boundary.containsLoose(bound);
+
+			if(inCell && (cell.leaf || get_wrappable_child(current, bound) == invalid_index)){
+				return true;
+			}
+
+			unlink(slot);
+
+			while(current != root_index && !nodes[current].boundary.containsLoose(bound)){
+				--nodes[current].branch_size;
+				try_unsplit(current);
+				current = nodes[current].parent;
+			}
+
+			--nodes[current].branch_size;
+
+			if(current == root_index && !nodes[root_index].boundary.overlap_Exclusive(bound)){
+				try_unsplit(root_index);
+				locations.erase(s.key);
+				release_slot(slot);
+				return false;
+			}
+
+			insert_from(current, slot);
+			return true;
+		}
+
+		template <std::predicate<const node&> Pred, std::invocable<index_type> Func>
+		void traverse(Pred pred, Func func) const{
+			query_stack stack;
+			std::size_t top = 0;
+			stack[top++] = root_index;
+
+			while(top){
+				const index_type current = stack[--top];
+				const node& n = nodes[current];
+				if(!std::invoke(pred, n)) continue;
+
+				std::invoke(func, current);
+
+				if(n.has_valid_children()){
+					for(index_type i = 0; i < ChildCount; ++i){
+						if(nodes[n.children + i].branch_size) stack[top++] = n.children + i;
+					}
+				}
+			}
+		}
+
+		template <std::invocable<const item_slot&> Func>
+		void each_slot_of(const node& n, Func func) const{
+			for(index_type cur = n.first_item; cur != invalid_index; cur = slots[cur].next){
+				std::invoke(func, slots[cur]);
+			}
+		}
+
+	public:
+		// ------------------------------------------------------------------------------
+		// external usage
+		// ------------------------------------------------------------------------------
+
+		template <std::regular_invocable<ItemTy&> Func>
+		void each(Func func) const{
+			for(const item_slot& slot : slots){
+				if(slot.item) std::invoke(func, *slot.item);
+			}
+		}
+
+		template <std::regular_invocable<node_view> Func>
+		void each(Func func) const{
+			this->traverse([](const node&){ return true; }, [&, this](const index_type index){
+				std::invoke(func, node_view{this, index});
+			});
+		}
+
+		[[nodiscard]] ItemTy* intersect_any(const ItemTy& object) const noexcept{
+			const rect_type bound = trait::bound_of(object);
+			ItemTy* rst{};
+
+			this->traverse([&](const node& n){
+				return !rst && n.boundary.overlap_Exclusive(bound);
+			}, [&, this](const index_type index){
+				this->each_slot_of(nodes[index], [&](const item_slot& slot){
+					if(!rst && slot.bound.overlap_Exclusive(bound) && trait::isIntersectedBetween(object, *slot.item)){
+						rst = slot.item;
+					}
+				});
+			});
+
+			return rst;
+		}
+
+		[[nodiscard]] ItemTy* intersect_any(const Vec2 point) const noexcept requires (trait::HasPointIntersect){
+			ItemTy* rst{};
+
+			this->traverse([&](const node& n){
+				return !rst && n.boundary.containsPos_edgeInclusive(point);
+			}, [&, this](const index_type index){
+				this->each_slot_of(nodes[index], [&](const item_slot& slot){
+					if(!rst && trait::isIntesectedWithPoint(point, *slot.item)){
+						rst = slot.item;
+					}
+				});
+			});
+
+			return rst;
+		}
+
+		template <
+			std::invocable<ItemTy&, ItemTy&> Func,
+			std::predicate<ItemTy&, ItemTy&> Filter = decltype(trait::isIntersectedBetween)>
+		void intersect_test_all(ItemTy& object, Func func, Filter filter = trait::isIntersectedBetween) const{
+			const rect_type bound = trait::bound_of(object);
+
+			this->traverse([bound](const node& n){
+				return n.boundary.overlap_Exclusive(bound);
+			}, [&, this](const index_type index){
+				this->each_slot_of(nodes[index], [&](const item_slot& slot){
+					if(!slot.bound.overlap_Exclusive(bound)) return;
+
+					if(std::invoke(filter, object, *slot.item)){
+						std::invoke(func, object, *slot.item);
+					}
+				});
+			});
+		}
+
+		template <std::predicate<const ItemTy&, const ItemTy&> Filter>
+		[[nodiscard]] std::vector<ItemTy*> get_all_intersected(const ItemTy& object, Filter filter) const{
+			std::vector<ItemTy*> rst{};
+			const rect_type bound = trait::bound_of(object);
+
+			this->traverse([bound](const node& n){
+				return n.boundary.overlap_Exclusive(bound);
+			}, [&, this](const index_type index){
+				this->each_slot_of(nodes[index], [&](const item_slot& slot){
+					if(trait::isIntersectedBetween(object, *slot.item) && std::invoke(filter, object, *slot.item)){
+						rst.push_back(slot.item);
+					}
+				});
+			});
+
+			return rst;
+		}
+
+		template <std::invocable<ItemTy&> Func>
+		void intersect_then(const ItemTy& object, Func func) const{
+			const rect_type bound = trait::bound_of(object);
+
+			this->traverse([bound](const node& n){
+				return n.boundary.overlap_Exclusive(bound);
+			}, [&, this](const index_type index){
+				this->each_slot_of(nodes[index], [&](const item_slot& slot){
+					if(trait::isIntersectedBetween(object, *slot.item)){
+						std::invoke(func, *slot.item);
+					}
+				});
+			});
+		}
+
+		template <std::invocable<ItemTy&, rect_type> Func>
+		void intersect_then(const rect_type rect, Func func) const{
+			this->traverse([rect](const node& n){
+				return n.boundary.overlap_Exclusive(rect);
+			}, [&, this](const index_type index){
+				this->each_slot_of(nodes[index], [&](const item_slot& slot){
+					if(slot.bound.overlap_Exclusive(rect)){
+						std::invoke(func, *slot.item, rect);
+					}
+				});
+			});
+		}
+
+		template <std::regular_invocable<ItemTy&, Vec2> Func>
+		void intersect_then(const Vec2 point, Func func) const{
+			this->traverse([point](const node& n){
+				return n.boundary.containsPos_edgeInclusive(point);
+			}, [&, this](const index_type index){
+				this->each_slot_of(nodes[index], [&](const item_slot& slot){
+					if(trait::isIntesectedWithPoint(point, *slot.item)){
+						std::invoke(func, *slot.item, point);
+					}
+				});
+			});
+		}
+	};
+}
@@ -14,7 +14,6 @@ import std;
 export import Geom.QuadTree.Interface;
 
 namespace Geom{
-	//TODO flattened quad tree with pre allocated sub trees
 	constexpr std::size_t MaximumItemCount = 4;
 
 	constexpr std::size_t top_lft_index = 0;
@@ -46,6 +45,17 @@ namespace Geom{
 	};
 
 
+	template <typename ItemTy, bool HasID>
+	struct quad_tree_item_key{
+		using type = const ItemTy*;
+	};
+
+	template <typename ItemTy>
+	struct quad_tree_item_key<ItemTy, true>{
+		using type = std::remove_cvref_t<decltype(std::declval<const ItemTy&>().getID())>;
+	};
+
+	export
 	template <typename ItemTy, ext::number T = float>
 	struct quad_tree_evaluateable_traits{
 		using rect_type = Rect_Orthogonal<T>;
@@ -62,6 +72,29 @@ namespace Geom{
 			{ value.containsPoint(p) } -> std::same_as<bool>;
 		};
 
+		/**
+		 * @brief Items exposing a hashable `getID()` are indexed by it, the others by their address.
+		 *
+		 * Containers that move their items, like a dense entity group, keep ids stable where addresses are not.
+		 * A default constructed id must never name a live item, it marks the empty buckets.
+		 */
+		static constexpr bool HasStableID = requires(const ItemTy& value){
+			{ value.getID() } -> std::equality_comparable;
+			std::hash<std::remove_cvref_t<decltype(value.getID())>>{}(value.getID());
+		};
+
+		using key_type = typename quad_tree_item_key<ItemTy, HasStableID>::type;
+
+		static constexpr key_type empty_key{};
+
+		static key_type key_of(const ItemTy& item) noexcept{
+			if constexpr (HasStableID){
+				return item.getID();
+			}else{
+				return std::addressof(item);
+			}
+		}
+
 		static rect_type bound_of(const ItemTy& cont) noexcept{
 			static_assert(requires(ItemTy value){
 				{ value.getBound() } -> std::same_as<rect_type>;
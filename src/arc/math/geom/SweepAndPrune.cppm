@@ -0,0 +1,213 @@
+export module Geom.sweep_and_prune;
+
+export import Geom.Rect_Orthogonal;
+export import Geom.QuadTree.Interface;
+
+import Geom.quad_tree;
+import ext.concepts;
+import ext.open_hash_map;
+import std;
+
+namespace Geom{
+	/**
+	 * @brief Sort-and-sweep broad phase on the x axis.
+	 *
+	 * The sorted axis is kept between ticks, so re-sorting a coherent scene with insertion sort stays nearly linear.
+	 * Each candidate pair is found by the sweep and filtered exactly once, then handed to the callback from both sides.
+	 * Entries are keyed like the flat quad tree, by the stable item id if there is one, else by address.
+	 *
+	 * Items use the same adaption as @link quad_tree @endlink (`getBound()` and the optional intersect members).
+	 */
+	export
+	template <typename ItemTy, ext::number T = float>
+	struct sweep_and_prune{
+		using rect_type = Rect_Orthogonal<T>;
+		using trait = quad_tree_evaluateable_traits<ItemTy, T>;
+		using index_type = unsigned;
+
+	private:
+		struct entry{
+			rect_type bound{};
+			ItemTy* item{};
+			typename trait::key_type id{trait::empty_key};
+			unsigned epoch{};
+
+			[[nodiscard]] T key() const noexcept{
+				return bound.getSrcX();
+			}
+		};
+
+		std::vector<entry> entries{};
+		ext::open_hash_map<typename trait::key_type, index_type> locations{trait::empty_key, 1024};
+		unsigned epoch{};
+
+		std::size_t lastShiftCount{};
+
+		/** @brief entries swept by one task */
+		static constexpr std::size_t SweepBlockSize{256};
+
+		/** @brief scratch of @link intersect_test_all @endlink, kept between ticks to reuse the memory */
+		std::vector<std::vector<std::pair<index_type, index_type>>> blockPairs{};
+		std::vector<index_type> candidateOffsets{};
+		std::vector<index_type> candidateCursors{};
+		std::vector<index_type> candidates{};
+
+	public:
+		[[nodiscard]] std::size_t size() const noexcept{
+			return entries.size();
+		}
+
+		/**
+		 * @brief element shifts performed by the insertion sort of the last synchronization, a measure of scene coherence
+		 */
+		[[nodiscard]] std::size_t last_shift_count() const noexcept{
+			return lastShiftCount;
+		}
+
+		void clear() noexcept{
+			entries.clear();
+			locations.clear();
+		}
+
+		/**
+		 * @brief make the axis contain exactly the given items, refresh their bounds and re-sort
+		 */
+		template <std::ranges::input_range Rng>
+			requires std::convertible_to<std::ranges::range_reference_t<Rng>, ItemTy&>
+		void synchronize(Rng&& items){
+			++epoch;
+
+			const std::size_t lastSize = entries.size();
+
+			for(ItemTy& item : items){
+				const auto id = trait::key_of(item);
+				if(const auto itr = locations.find(id); itr != locations.end()){
+					entry& e = entries[itr->second];
+					e.bound = trait::bound_of(item);
+					e.item = std::addressof(item);
+					e.epoch = epoch;
+				}else{
+					locations.try_emplace(id, static_cast<index_type>(entries.size()));
+					entries.push_back(entry{trait::bound_of(item), std::addressof(item), id, epoch});
+				}
+			}
+
+			auto newBegin = entries.begin() + lastSize;
+
+			const auto removed = std::ranges::remove_if(entries.begin(), newBegin, [this](const entry& e){
+				if(e.epoch != epoch){
+					locations.erase(e.id);
+					return true;
+				}
+				return false;
+			});
+
+			newBegin = entries.erase(removed.begin(), removed.end());
+
+			lastShiftCount = insertion_sort(entries.begin(), newBegin);
+
+			//new items are not coherent, sort them as a whole and merge
+			std::ranges::sort(newBegin, entries.end(), std::ranges::less{}, &entry::key);
+			std::ranges::inplace_merge(entries, newBegin, std::ranges::less{}, &entry::key);
+
+			for(index_type i = 0; i < entries.size(); ++i){
+				locations.at(entries[i].id) = i;
+			}
+		}
+
+	private:
+		static std::size_t insertion_sort(const typename std::vector<entry>::iterator begin, const typename std::vector<entry>::iterator end) noexcept{
+			std::size_t shifts{};
+			if(begin == end) return shifts;
+
+			for(auto cur = std::next(begin); cur != end; ++cur){
+				if(std::prev(cur)->key() <= cur->key()) continue;
+
+				entry tmp = *cur;
+				auto hole = cur;
+
+				do{
+					*hole = *std::prev(hole);
+					--hole;
+					++shifts;
+				}while(hole != begin && std::prev(hole)->key() > tmp.key());
+
+				*hole = tmp;
+			}
+
+			return shifts;
+		}
+
+	public:
+		/**
+		 * @brief Sweep the sorted axis once, each pair overlapping on both axes is passed to the filter once,
+		 * then `func` is called for each item first against every candidate the filter passed, so each pair is visited from both sides.
+		 *
+		 * Both passes are split through `parallelFor(count, fn)`, which calls `fn(begin, end)` for chunks of [0, count),
+		 * possibly concurrently. The filter has to be symmetric and safe to call concurrently;
+		 * all calls of `func` with the same first item happen in one chunk, so `func` may write that item only.
+		 */
+		template <
+			typename ParallelFor,
+			std::invocable<ItemTy&, ItemTy&> Func,
+			std::predicate<ItemTy&, ItemTy&> Filter = decltype(trait::isIntersectedBetween)>
+		void intersect_test_all(ParallelFor parallelFor, Func func, Filter filter = trait::isIntersectedBetween){
+			const std::size_t count = entries.size();
+			const std::size_t blocks = (count + SweepBlockSize - 1) / SweepBlockSize;
+
+			if(blockPairs.size() < blocks) blockPairs.resize(blocks);
+
+			std::invoke(parallelFor, blocks, [this, count, &filter](const std::size_t blockBegin, const std::size_t blockEnd){
+				for(std::size_t block = blockBegin; block < blockEnd; ++block){
+					auto& pairs = blockPairs[block];
+					pairs.clear();
+
+					for(std::size_t i = block * SweepBlockSize; i < std::min(count, (block + 1) * SweepBlockSize); ++i){
+						const entry& subject = entries[i];
+						const T endX = subject.bound.getEndX();
+
+						for(std::size_t j = i + 1; j < count; ++j){
+							const entry& object = entries[j];
+							if(object.bound.getSrcX() >= endX) break;
+
+							if(subject.bound.getSrcY() >= object.bound.getEndY() || subject.bound.getEndY() <= object.bound.getSrcY()) continue;
+
+							if(std::invoke(filter, *subject.item, *object.item)){
+								pairs.emplace_back(static_cast<index_type>(i), static_cast<index_type>(j));
+							}
+						}
+					}
+				}
+			});
+
+			//group both sides of every pair by the item they are visited for
+			candidateOffsets.assign(count + 1, 0);
+			for(const auto& pairs : blockPairs | std::views::take(blocks)){
+				for(const auto [i, j] : pairs){
+					++candidateOffsets[i + 1];
+					++candidateOffsets[j + 1];
+				}
+			}
+
+			std::partial_sum(candidateOffsets.begin(), candidateOffsets.end(), candidateOffsets.begin());
+
+			candidates.resize(candidateOffsets.back());
+			candidateCursors.assign(candidateOffsets.begin(), std::prev(candidateOffsets.end()));
+
+			for(const auto& pairs : blockPairs | std::views::take(blocks)){
+				for(const auto [i, j] : pairs){
+					candidates[candidateCursors[i]++] = j;
+					candidates[candidateCursors[j]++] = i;
+				}
+			}
+
+			std::invoke(parallelFor, count, [this, &func](const std::size_t begin, const std::size_t end){
+				for(std::size_t i = begin; i < end; ++i){
+					for(index_type k = candidateOffsets[i]; k < candidateOffsets[i + 1]; ++k){
+						std::invoke(func, *entries[i].item, *entries[candidates[k]].item);
+					}
+				}
+			});
+		}
+	};
+}
@@ -113,4 +113,18 @@ export namespace Geom{
 
 	using Transform = TransformState<float>;
 	using UniformTransform = TransformState<Math::Angle>;
+
+	/**
+	 * @brief interpolate translation linearly and rotation along the shorter arc
+	 */
+	template <typename AngTy>
+	[[nodiscard]] TransformState<AngTy> lerp(TransformState<AngTy> from, const TransformState<AngTy> to, const float progress) noexcept{
+		const float fromRot = static_cast<float>(from.rot);
+		const float deltaRot = std::remainder(static_cast<float>(to.rot) - fromRot, 360.f);
+
+		from.vec.lerp(to.vec, progress);
+		from.rot = static_cast<AngTy>(fromRot + deltaRot * progress);
+
+		return from;
+	}
 }
@@ -0,0 +1,407 @@
+module;
+
+#include <cassert>
+#include "../src/arc/math/simd.hpp"
+
+export module Geom.Shape.RectBox.Batch;
+
+export import Geom.Shape.RectBox;
+import Geom.Vector2D;
+import Math.SIMD;
+
+import std;
+
+namespace Geom{
+	/**
+	 * @brief Subject box data broadcast against every lane of a batch
+	 */
+	struct SubjectProjection{
+		std::array<float, 4> x{};
+		std::array<float, 4> y{};
+
+		float minX{};
+		float minY{};
+		float maxX{};
+		float maxY{};
+
+		Vec2 u{};
+		Vec2 v{};
+
+		float uMin{};
+		float uMax{};
+		float vMin{};
+		float vMax{};
+
+		[[nodiscard]] explicit SubjectProjection(const RectBoxBrief& box) noexcept
+			: x{box.v0.x, box.v1.x, box.v2.x, box.v3.x},
+			  y{box.v0.y, box.v1.y, box.v2.y, box.v3.y},
+			  u{box.getNormalU()}, v{box.getNormalV()}{
+
+			const auto bound = box.getMaxOrthoBound();
+			minX = bound.getSrcX();
+			minY = bound.getSrcY();
+			maxX = bound.getEndX();
+			maxY = bound.getEndY();
+
+			std::tie(uMin, uMax) = project(u);
+			std::tie(vMin, vMax) = project(v);
+		}
+
+		[[nodiscard]] std::pair<float, float> project(const Vec2 axis) const noexcept{
+			float min = std::numeric_limits<float>::max();
+			float max = std::numeric_limits<float>::lowest();
+
+			for(std::size_t i = 0; i < 4; ++i){
+				const float dot = x[i] * axis.x + y[i] * axis.y;
+				min = std::min(min, dot);
+				max = std::max(max, dot);
+			}
+
+			return {min, max};
+		}
+	};
+
+	/**
+	 * @brief Structure-of-arrays storage of @link RectBoxBrief @endlink for testing one subject box against many object boxes at once.
+	 *
+	 * The test is identical to @code subject.overlapRough(object) && subject.overlapExact(object) @endcode,
+	 * kernels are selected at runtime by @link Math::SIMD::getInstructionSet @endlink (AVX2: 8 lanes, SSE: 2x4 lanes, or scalar).
+	 */
+	export
+	class RectBoxBatch{
+	public:
+		static constexpr std::size_t GroupSize = 8;
+
+		enum Field : std::size_t{
+			X0, Y0, X1, Y1, X2, Y2, X3, Y3,
+			MinX, MinY, MaxX, MaxY,
+			UX, UY, VX, VY,
+			/** @brief projection range of the box on its own axes */
+			UMin, UMax, VMin, VMax,
+
+			FieldCount
+		};
+
+	private:
+		std::vector<float> data_{};
+		std::size_t size_{};
+		/** @brief always a multiple of @link GroupSize @endlink */
+		std::size_t stride_{};
+
+		[[nodiscard]] float& at(const Field field, const std::size_t index) noexcept{
+			return data_[field * stride_ + index];
+		}
+
+	public:
+		[[nodiscard]] std::size_t size() const noexcept{ return size_; }
+
+		[[nodiscard]] bool empty() const noexcept{ return size_ == 0; }
+
+		[[nodiscard]] std::size_t groupCount() const noexcept{ return (size_ + GroupSize - 1) / GroupSize; }
+
+		[[nodiscard]] const float* field(const Field field) const noexcept{
+			return data_.data() + field * stride_;
+		}
+
+		void clear() noexcept{
+			size_ = 0;
+		}
+
+		void reserve(const std::size_t count){
+			if(count <= stride_) return;
+
+			const std::size_t stride = std::max(GroupSize, std::bit_ceil(count));
+			std::vector<float> data(stride * FieldCount);
+
+			for(std::size_t f = 0; f < FieldCount; ++f){
+				std::ranges::copy_n(data_.begin() + f * stride_, size_, data.begin() + f * stride);
+			}
+
+			data_ = std::move(data);
+			stride_ = stride;
+		}
+
+		/**
+		 * @param box box to store
+		 * @param offset translation applied to the stored box, used to lay out CCD backtrace positions
+		 */
+		void push(const RectBoxBrief& box, const Vec2 offset = {}){
+			reserve(size_ + 1);
+
+			const std::size_t i = size_++;
+
+			const std::array verts{box.v0 + offset, box.v1 + offset, box.v2 + offset, box.v3 + offset};
+			at(X0, i) = verts[0].x; at(Y0, i) = verts[0].y;
+			at(X1, i) = verts[1].x; at(Y1, i) = verts[1].y;
+			at(X2, i) = verts[2].x; at(Y2, i) = verts[2].y;
+			at(X3, i) = verts[3].x; at(Y3, i) = verts[3].y;
+
+			const auto bound = box.getMaxOrthoBound();
+			at(MinX, i) = bound.getSrcX() + offset.x;
+			at(MinY, i) = bound.getSrcY() + offset.y;
+			at(MaxX, i) = bound.getEndX() + offset.x;
+			at(MaxY, i) = bound.getEndY() + offset.y;
+
+			const Vec2 u = box.getNormalU();
+			const Vec2 v = box.getNormalV();
+			at(UX, i) = u.x; at(UY, i) = u.y;
+			at(VX, i) = v.x; at(VY, i) = v.y;
+
+			auto project = [&verts](const Vec2 axis){
+				float min = std::numeric_limits<float>::max();
+				float max = std::numeric_limits<float>::lowest();
+				for(const Vec2 vert : verts){
+					const float dot = vert.x * axis.x + vert.y * axis.y;
+					min = std::min(min, dot);
+					max = std::max(max, dot);
+				}
+				return std::pair{min, max};
+			};
+
+			std::tie(at(UMin, i), at(UMax, i)) = project(u);
+			std::tie(at(VMin, i), at(VMax, i)) = project(v);
+		}
+
+		/**
+		 * @brief scalar test of a single lane
+		 */
+		[[nodiscard]] bool test(const RectBoxBrief& subject, const std::size_t index) const noexcept{
+			assert(index < size_);
+			return RectBoxBatch::testLane(SubjectProjection{subject}, index);
+		}
+
+		/**
+		 * @return bit i set if lane [group * 8 + i] overlaps with the subject
+		 */
+		[[nodiscard]] std::uint32_t testGroup(const RectBoxBrief& subject, const std::size_t group) const noexcept{
+			return testGroup(SubjectProjection{subject}, group, Math::SIMD::getInstructionSet());
+		}
+
+		/**
+		 * @return index of the first lane not less than `from` overlapping with the subject, @link size @endlink if none
+		 */
+		[[nodiscard]] std::size_t findFirst(const RectBoxBrief& subject, const std::size_t from = 0) const noexcept{
+			if(from >= size_) return size_;
+
+			const SubjectProjection projection{subject};
+			const auto set = Math::SIMD::getInstructionSet();
+
+			std::size_t group = from / GroupSize;
+			std::uint32_t mask = testGroup(projection, group, set) & (~0u << (from % GroupSize));
+
+			while(true){
+				if(mask) return group * GroupSize + std::countr_zero(mask);
+				if(++group >= groupCount()) return size_;
+				mask = testGroup(projection, group, set);
+			}
+		}
+
+		template <std::invocable<std::size_t> Func>
+		void each(const RectBoxBrief& subject, Func func) const{
+			const SubjectProjection projection{subject};
+			const auto set = Math::SIMD::getInstructionSet();
+
+			for(std::size_t group = 0; group < groupCount(); ++group){
+				std::uint32_t mask = testGroup(projection, group, set);
+				while(mask){
+					std::invoke(func, group * GroupSize + std::countr_zero(mask));
+					mask &= mask - 1;
+				}
+			}
+		}
+
+	private:
+		[[nodiscard]] std::uint32_t testGroup(const SubjectProjection& subject, const std::size_t group, const Math::SIMD::InstructionSet set) const noexcept;
+
+		[[nodiscard]] bool testLane(const SubjectProjection& subject, const std::size_t i) const noexcept{
+			const auto get = [this, i](const Field f){ return field(f)[i]; };
+
+			if(!(subject.minX < get(MaxX) && subject.maxX > get(MinX) && subject.minY < get(MaxY) && subject.maxY > get(MinY))){
+				return false;
+			}
+
+			const std::array xs{get(X0), get(X1), get(X2), get(X3)};
+			const std::array ys{get(Y0), get(Y1), get(Y2), get(Y3)};
+
+			auto projectObject = [&](const Vec2 axis){
+				float min = std::numeric_limits<float>::max();
+				float max = std::numeric_limits<float>::lowest();
+				for(std::size_t k = 0; k < 4; ++k){
+					const float dot = xs[k] * axis.x + ys[k] * axis.y;
+					min = std::min(min, dot);
+					max = std::max(max, dot);
+				}
+				return std::pair{min, max};
+			};
+
+			const auto [ouMin, ouMax] = projectObject(subject.u);
+			if(!(subject.uMax >= ouMin && ouMax >= subject.uMin)) return false;
+
+			const auto [ovMin, ovMax] = projectObject(subject.v);
+			if(!(subject.vMax >= ovMin && ovMax >= subject.vMin)) return false;
+
+			const auto [suMin, suMax] = subject.project({get(UX), get(UY)});
+			if(!(suMax >= get(UMin) && get(UMax) >= suMin)) return false;
+
+			const auto [svMin, svMax] = subject.project({get(VX), get(VY)});
+			return svMax >= get(VMin) && get(VMax) >= svMin;
+		}
+
+		[[nodiscard]] std::uint32_t testGroup_scalar(const SubjectProjection& subject, const std::size_t base) const noexcept{
+			std::uint32_t mask{};
+			const std::size_t count = std::min(GroupSize, size_ - base);
+
+			for(std::size_t i = 0; i < count; ++i){
+				if(testLane(subject, base + i)) mask |= 1u << i;
+			}
+
+			return mask;
+		}
+
+#if SIMD_X86
+		[[nodiscard]] std::uint32_t testGroup_sse2(const SubjectProjection& subject, std::size_t base) const noexcept;
+
+		SIMD_TARGET_AVX2
+		[[nodiscard]] std::uint32_t testGroup_avx2(const SubjectProjection& subject, std::size_t base) const noexcept;
+#endif
+	};
+
+#if SIMD_X86
+	std::uint32_t RectBoxBatch::testGroup_sse2(const SubjectProjection& subject, const std::size_t base) const noexcept{
+		std::uint32_t mask{};
+
+		for(std::size_t half = 0; half < 2; ++half){
+			const std::size_t i = base + half * 4;
+
+			const __m128 oMinX = _mm_loadu_ps(field(MinX) + i);
+			const __m128 oMinY = _mm_loadu_ps(field(MinY) + i);
+			const __m128 oMaxX = _mm_loadu_ps(field(MaxX) + i);
+			const __m128 oMaxY = _mm_loadu_ps(field(MaxY) + i);
+
+			__m128 result = _mm_and_ps(
+				_mm_and_ps(_mm_cmplt_ps(_mm_set1_ps(subject.minX), oMaxX), _mm_cmpgt_ps(_mm_set1_ps(subject.maxX), oMinX)),
+				_mm_and_ps(_mm_cmplt_ps(_mm_set1_ps(subject.minY), oMaxY), _mm_cmpgt_ps(_mm_set1_ps(subject.maxY), oMinY)));
+
+			const std::array ox{_mm_loadu_ps(field(X0) + i), _mm_loadu_ps(field(X1) + i), _mm_loadu_ps(field(X2) + i), _mm_loadu_ps(field(X3) + i)};
+			const std::array oy{_mm_loadu_ps(field(Y0) + i), _mm_loadu_ps(field(Y1) + i), _mm_loadu_ps(field(Y2) + i), _mm_loadu_ps(field(Y3) + i)};
+
+			//object vertices on subject axes
+			for(const auto& [axis, sMin, sMax] : {std::tuple{subject.u, subject.uMin, subject.uMax}, std::tuple{subject.v, subject.vMin, subject.vMax}}){
+				const __m128 ax = _mm_set1_ps(axis.x);
+				const __m128 ay = _mm_set1_ps(axis.y);
+
+				__m128 min = _mm_add_ps(_mm_mul_ps(ox[0], ax), _mm_mul_ps(oy[0], ay));
+				__m128 max = min;
+				for(std::size_t k = 1; k < 4; ++k){
+					const __m128 dot = _mm_add_ps(_mm_mul_ps(ox[k], ax), _mm_mul_ps(oy[k], ay));
+					min = _mm_min_ps(min, dot);
+					max = _mm_max_ps(max, dot);
+				}
+
+				result = _mm_and_ps(result, _mm_and_ps(_mm_cmpge_ps(_mm_set1_ps(sMax), min), _mm_cmpge_ps(max, _mm_set1_ps(sMin))));
+			}
+
+			//subject vertices on object axes
+			for(const auto [axisX, axisY, rangeMin, rangeMax] : {std::array{UX, UY, UMin, UMax}, std::array{VX, VY, VMin, VMax}}){
+				const __m128 ax = _mm_loadu_ps(field(axisX) + i);
+				const __m128 ay = _mm_loadu_ps(field(axisY) + i);
+
+				__m128 min = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(subject.x[0]), ax), _mm_mul_ps(_mm_set1_ps(subject.y[0]), ay));
+				__m128 max = min;
+				for(std::size_t k = 1; k < 4; ++k){
+					const __m128 dot = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(subject.x[k]), ax), _mm_mul_ps(_mm_set1_ps(subject.y[k]), ay));
+					min = _mm_min_ps(min, dot);
+					max = _mm_max_ps(max, dot);
+				}
+
+				result = _mm_and_ps(result, _mm_and_ps(
+					_mm_cmpge_ps(max, _mm_loadu_ps(field(rangeMin) + i)),
+					_mm_cmpge_ps(_mm_loadu_ps(field(rangeMax) + i), min)));
+			}
+
+			mask |= static_cast<std::uint32_t>(_mm_movemask_ps(result)) << (half * 4);
+		}
+
+		return mask;
+	}
+
+	SIMD_TARGET_AVX2
+	std::uint32_t RectBoxBatch::testGroup_avx2(const SubjectProjection& subject, const std::size_t i) const noexcept{
+		const __m256 oMinX = _mm256_loadu_ps(field(MinX) + i);
+		const __m256 oMinY = _mm256_loadu_ps(field(MinY) + i);
+		const __m256 oMaxX = _mm256_loadu_ps(field(MaxX) + i);
+		const __m256 oMaxY = _mm256_loadu_ps(field(MaxY) + i);
+
+		__m256 result = _mm256_and_ps(
+			_mm256_and_ps(_mm256_cmp_ps(_mm256_set1_ps(subject.minX), oMaxX, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_set1_ps(subject.maxX), oMinX, _CMP_GT_OQ)),
+			_mm256_and_ps(_mm256_cmp_ps(_mm256_set1_ps(subject.minY), oMaxY, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_set1_ps(subject.maxY), oMinY, _CMP_GT_OQ)));
+
+		const __m256 ox0 = _mm256_loadu_ps(field(X0) + i);
+		const __m256 ox1 = _mm256_loadu_ps(field(X1) + i);
+		const __m256 ox2 = _mm256_loadu_ps(field(X2) + i);
+		const __m256 ox3 = _mm256_loadu_ps(field(X3) + i);
+		const __m256 oy0 = _mm256_loadu_ps(field(Y0) + i);
+		const __m256 oy1 = _mm256_loadu_ps(field(Y1) + i);
+		const __m256 oy2 = _mm256_loadu_ps(field(Y2) + i);
+		const __m256 oy3 = _mm256_loadu_ps(field(Y3) + i);
+
+		//object vertices on subject axes, no lambdas here: they would not inherit the target attribute
+#define PROJECT_OBJECT(AXIS, S_MIN, S_MAX) {\
+			const __m256 ax = _mm256_set1_ps(AXIS.x);\
+			const __m256 ay = _mm256_set1_ps(AXIS.y);\
+			const __m256 d0 = _mm256_add_ps(_mm256_mul_ps(ox0, ax), _mm256_mul_ps(oy0, ay));\
+			const __m256 d1 = _mm256_add_ps(_mm256_mul_ps(ox1, ax), _mm256_mul_ps(oy1, ay));\
+			const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(ox2, ax), _mm256_mul_ps(oy2, ay));\
+			const __m256 d3 = _mm256_add_ps(_mm256_mul_ps(ox3, ax), _mm256_mul_ps(oy3, ay));\
+			const __m256 min = _mm256_min_ps(_mm256_min_ps(d0, d1), _mm256_min_ps(d2, d3));\
+			const __m256 max = _mm256_max_ps(_mm256_max_ps(d0, d1), _mm256_max_ps(d2, d3));\
+			result = _mm256_and_ps(result, _mm256_and_ps(\
+				_mm256_cmp_ps(_mm256_set1_ps(S_MAX), min, _CMP_GE_OQ),\
+				_mm256_cmp_ps(max, _mm256_set1_ps(S_MIN), _CMP_GE_OQ)));\
+		}
+
+		PROJECT_OBJECT(subject.u, subject.uMin, subject.uMax)
+		PROJECT_OBJECT(subject.v, subject.vMin, subject.vMax)
+#undef PROJECT_OBJECT
+
+		//subject vertices on object axes
+#define PROJECT_SUBJECT(AXIS_X, AXIS_Y, R_MIN, R_MAX) {\
+			const __m256 ax = _mm256_loadu_ps(field(AXIS_X) + i);\
+			const __m256 ay = _mm256_loadu_ps(field(AXIS_Y) + i);\
+			const __m256 d0 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(subject.x[0]), ax), _mm256_mul_ps(_mm256_set1_ps(subject.y[0]), ay));\
+			const __m256 d1 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(subject.x[1]), ax), _mm256_mul_ps(_mm256_set1_ps(subject.y[1]), ay));\
+			const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(subject.x[2]), ax), _mm256_mul_ps(_mm256_set1_ps(subject.y[2]), ay));\
+			const __m256 d3 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(subject.x[3]), ax), _mm256_mul_ps(_mm256_set1_ps(subject.y[3]), ay));\
+			const __m256 min = _mm256_min_ps(_mm256_min_ps(d0, d1), _mm256_min_ps(d2, d3));\
+			const __m256 max = _mm256_max_ps(_mm256_max_ps(d0, d1), _mm256_max_ps(d2, d3));\
+			result = _mm256_and_ps(result, _mm256_and_ps(\
+				_mm256_cmp_ps(max, _mm256_loadu_ps(field(R_MIN) + i), _CMP_GE_OQ),\
+				_mm256_cmp_ps(_mm256_loadu_ps(field(R_MAX) + i), min, _CMP_GE_OQ)));\
+		}
+
+		PROJECT_SUBJECT(UX, UY, UMin, UMax)
+		PROJECT_SUBJECT(VX, VY, VMin, VMax)
+#undef PROJECT_SUBJECT
+
+		return static_cast<std::uint32_t>(_mm256_movemask_ps(result));
+	}
+#endif
+
+	std::uint32_t RectBoxBatch::testGroup(const SubjectProjection& subject, const std::size_t group, const Math::SIMD::InstructionSet set) const noexcept{
+		using Math::SIMD::InstructionSet;
+
+		const std::size_t base = group * GroupSize;
+		assert(base < size_);
+
+		//lanes beyond size in the last group hold stale data, mask them out
+		const std::size_t valid = std::min(GroupSize, size_ - base);
+		const std::uint32_t validMask = (1u << valid) - 1;
+
+#if SIMD_X86
+		if(set >= InstructionSet::avx2) return testGroup_avx2(subject, base) & validMask;
+		if(set >= InstructionSet::sse2) return testGroup_sse2(subject, base) & validMask;
+#endif
+
+		return testGroup_scalar(subject, base);
+	}
+}
@@ -10,4 +10,21 @@
 #define SIMD_DISABLED_CONSTEXPR
 #else
 #define SIMD_DISABLED_CONSTEXPR constexpr
-#endif
\ No newline at end of file
+#endif
+
+// Runtime dispatched kernels (see Math.SIMD), independent of SIMD_ENABLED
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMD_TARGET_SSE4_1
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
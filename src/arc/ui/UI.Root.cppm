@@ -1,6 +1,7 @@
 module;
 
 #include <cassert>
+#include "../src/arc/core/profiler.hpp"
 
 export module Core.UI.Root;
 
@@ -9,6 +10,7 @@ export import Core.UI.Scene;
 import Geom.Vector2D;
 
 import ext.heterogeneous;
+import Core.Profiler;
 import std;
 
 export namespace Core::UI{
@@ -39,6 +41,7 @@ export namespace Core::UI{
 		}
 
 		void layout() const{
+			PROFILE_ZONE("UI::Root::layout");
 			assert(focus != nullptr);
 			focus->layout();
 		}
@@ -119,10 +119,14 @@ export namespace Core::UI{
 			return changed;
 		}
 
-		constexpr void setSelfChanged() noexcept{
+		/**
+		 * @return true if the element just turned changed and has to be registered for the next layout
+		 */
+		constexpr bool setSelfChanged() noexcept{
 			if(acceptMask_context & SpreadDirection::local && acceptMask_inherent & SpreadDirection::local){
-				changed = true;
+				return !std::exchange(changed, true);
 			}
+			return false;
 		}
 
 		constexpr bool tryNotifyFromChildren() noexcept{
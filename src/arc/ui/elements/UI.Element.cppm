@@ -312,6 +312,11 @@ namespace Core::UI{
 			return parent == nullptr;
 		}
 
+		/**
+		 * @return the count of ancestors, layouts of the same scene run in this order
+		 */
+		[[nodiscard]] std::size_t getDepth() const noexcept;
+
 		//TODO should manager be null?
 		[[nodiscard]] Scene* getScene() const noexcept{
 			return scene;
@@ -405,9 +410,7 @@ namespace Core::UI{
 
 		virtual void notifyLayoutChanged(SpreadDirection toDirection);
 
-		virtual void setScene(Scene* s){
-			this->scene = s;
-		}
+		virtual void setScene(Scene* s);
 
 
 		virtual void update(float delta_in_ticks);
@@ -419,7 +422,7 @@ namespace Core::UI{
 		}
 
 		virtual void layout(){
-			layoutState.checkChanged();
+			layoutState.clear();
 		}
 
 		[[nodiscard]] virtual Geom::Vec2 requestSpace(const StatedSize sz){
@@ -64,9 +64,22 @@ namespace Core::UI{
 		Element* currentCursorFocus{nullptr};
 
 		std::vector<Element*> lastInbounds{};
-		std::unordered_set<Element*> independentLayout{};
 		std::unordered_set<Element*> asyncTaskOwners{};
 
+		struct LayoutEntry{
+			std::size_t depth{};
+			Element* element{};
+		};
+
+		/**
+		 * @brief Elements changed since the last layout, the only ones @link Scene::layout @endlink visits
+		 */
+		std::unordered_set<Element*> dirtyLayouts{};
+		/** @brief min heap by depth while laying out */
+		std::vector<LayoutEntry> layoutQueue{};
+		/** @brief depth of the element being laid out, empty outside of a layout */
+		std::optional<std::size_t> layoutDepth{};
+
 		Graphic::RendererUI* renderer{};
 		Bundle* bundle{};
 
@@ -105,7 +118,11 @@ namespace Core::UI{
 
 		void registerAsyncTaskElement(Element* element);
 
-		void registerIndependentLayout(Element* element);
+		/**
+		 * @brief Schedules the element to be laid out, the changed elements register themselves on layout notification.
+		 * An element deeper than the one being laid out is still handled in the current layout, anything else in the next one.
+		 */
+		void registerLayoutDirty(Element* element);
 
 		[[nodiscard]] bool isMousePressed() const noexcept{
 			return std::ranges::any_of(mouseKeyStates, std::identity{}, &MouseState::pressed);
@@ -133,6 +150,9 @@ namespace Core::UI{
 
 		void update(float delta_in_ticks);
 
+		/**
+		 * @brief Lays out the dirty elements parents first, a frame without changes costs nothing.
+		 */
 		void layout();
 
 		void draw() const;
@@ -37,7 +37,7 @@ export namespace Core::UI{
 				textScale = scl;
 
 				if(!textChanged){
-					getScene()->registerIndependentLayout(this);
+					getScene()->registerLayoutDirty(this);
 					textChanged = true;
 				}
 
@@ -52,7 +52,7 @@ export namespace Core::UI{
 			if(glyphLayout->isLayoutChanged(text, sz)){
 				glyphLayout->reset<false>(std::string{text}, sz);
 				textChanged = true;
-				getScene()->registerIndependentLayout(this);
+				getScene()->registerLayoutDirty(this);
 				notifyLayoutChanged(SpreadDirection::upper);
 			}
 		}
@@ -126,7 +126,7 @@ export namespace Core::UI{
 
 		void updateTextSize(){
 			if(glyphLayout->resetSize<false>(getTextBoundSize())){
-				getScene()->registerIndependentLayout(this);
+				getScene()->registerLayoutDirty(this);
 				textChanged = true;
 			}
 		}
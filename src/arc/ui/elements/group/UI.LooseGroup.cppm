@@ -61,14 +61,6 @@ namespace Core::UI{
 			updateChildren(delta_in_ticks);
 		}
 
-		void tryLayout() override{
-			if(layoutState.isChanged()){
-				layout();
-			}else if(layoutState.isChildrenChanged()){//TODO accurate register change instead of for each?
-				layoutChildren();
-			}
-		}
-
 	protected:
 		auto find(Element* element){
 			return std::ranges::find(children, element, &ElementUniquePtr::get);
@@ -78,14 +70,5 @@ namespace Core::UI{
 	export
 	struct LooseGroup : BasicGroup{
 		using BasicGroup::BasicGroup;
-
-		void tryLayout() override{
-			if(layoutState.isChanged()){
-				layout();
-				layoutChildren();
-			}else if(layoutState.isChildrenChanged()){//TODO accurate register change instead of for each?
-				layoutChildren();
-			}
-		}
 	};
 }
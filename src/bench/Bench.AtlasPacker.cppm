@@ -0,0 +1,115 @@
+export module Bench.AtlasPacker;
+
+import std;
+
+import ext.allocator_2D;
+import ext.shelf_allocator_2D;
+import Geom.Vector2D;
+import Geom.Rect_Orthogonal;
+
+namespace Bench{
+	using Extent = Geom::Vector2D<std::uint32_t>;
+
+	/**
+	 * @brief glyph like extents, a fixed seed so both packers see the same sequence
+	 */
+	std::vector<Extent> makeExtents(const std::size_t count){
+		std::mt19937 rand{0x5eed};
+		std::uniform_int_distribution<std::uint32_t> height{12, 40};
+		std::uniform_int_distribution<std::uint32_t> aspect{40, 110};
+
+		std::vector<Extent> extents{};
+		extents.reserve(count);
+
+		for(std::size_t i = 0; i < count; ++i){
+			const std::uint32_t h = height(rand);
+			extents.push_back({std::max(1u, h * aspect(rand) / 100), h});
+		}
+
+		return extents;
+	}
+
+	export struct AtlasPackerBenchResult{
+		std::string_view packer{};
+		std::size_t regions{};
+
+		/** @brief allocated area when the first allocation failed */
+		float fillRate{};
+		/** @brief fill to the first failure */
+		std::chrono::microseconds fill{};
+		/** @brief a quarter freed, then one region freed and one allocated at a time */
+		std::chrono::microseconds churn{};
+		/** @brief allocations failed during the churn, a page would have grown for each */
+		std::size_t failed{};
+	};
+
+	template <typename Allocator>
+	AtlasPackerBenchResult benchmarkPacker(const std::string_view name, const Extent pageSize, const std::span<const Extent> extents){
+		AtlasPackerBenchResult result{name};
+
+		Allocator allocator{pageSize};
+		std::vector<Geom::Rect_Orthogonal<std::uint32_t>> live{};
+
+		std::size_t next{};
+
+		{
+			const auto begin = std::chrono::steady_clock::now();
+			for(; next < extents.size(); ++next){
+				const auto rect = allocator.allocate(extents[next]);
+				if(!rect) break;
+				live.push_back(*rect);
+			}
+			result.fill = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+		}
+
+		result.regions = live.size();
+		result.fillRate = 1.f - static_cast<float>(allocator.get_valid_area()) / static_cast<float>(pageSize.area());
+
+		std::mt19937 rand{0xc4u};
+		std::ranges::shuffle(live, rand);
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		for(const auto& rect : live | std::views::drop(live.size() * 3 / 4)){
+			allocator.deallocate(rect.getSrc());
+		}
+		live.resize(live.size() * 3 / 4);
+
+		for(; next < extents.size() && !live.empty(); ++next){
+			const std::size_t index = rand() % live.size();
+			allocator.deallocate(live[index].getSrc());
+			live[index] = live.back();
+			live.pop_back();
+
+			if(const auto rect = allocator.allocate(extents[next])){
+				live.push_back(*rect);
+			}else{
+				++result.failed;
+			}
+		}
+		result.churn = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+
+		return result;
+	}
+
+	/**
+	 * @brief the tree packer against the shelf packer on a churning glyph page
+	 */
+	export std::array<AtlasPackerBenchResult, 2> benchmarkAtlasPacker(const Extent pageSize, const std::size_t count){
+		const std::vector<Extent> extents = makeExtents(count);
+
+		return {
+			Bench::benchmarkPacker<ext::allocator_2D>("tree", pageSize, extents),
+			Bench::benchmarkPacker<ext::shelf_allocator_2D>("shelf", pageSize, extents)
+		};
+	}
+
+	export void runAtlasPackerBenchmark(const std::initializer_list<std::uint32_t> pageSizes = {1024, 4096}, const std::size_t count = 200'000){
+		for(const std::uint32_t size : pageSizes){
+			for(const auto& [packer, regions, fillRate, fill, churn, failed] : Bench::benchmarkAtlasPacker({size, size}, count)){
+				std::println("atlas packer | {:<8} | page: {:>5} | regions: {:>7} | fill rate: {:>6.2f}% | fill: {:>9} | churn: {:>9} | failed: {:>7}",
+					packer, size, regions, fillRate * 100.f, fill, churn, failed);
+			}
+		}
+	}
+}
@@ -0,0 +1,95 @@
+export module Bench.EntityGroup;
+
+import std;
+
+import Game.Entity;
+import Game.World.EntityGroup;
+
+namespace Bench{
+	struct SpawnedEntity : Game::Entity{
+		std::array<float, 24> payload{};
+	};
+
+	/**
+	 * @brief the mutex guarded vector pending entities used to be pushed into, kept as the baseline
+	 */
+	struct LockedPendings{
+		std::mutex mutex{};
+		std::vector<SpawnedEntity> items{};
+
+		void pend(SpawnedEntity&& entity){
+			std::scoped_lock lock{mutex};
+			items.push_back(std::move(entity));
+		}
+	};
+
+	template <typename Spawn>
+	std::chrono::microseconds spawnFrom(const unsigned threads, const std::size_t perThread, Spawn spawn){
+		std::latch ready{threads + 1};
+		std::vector<std::jthread> workers{};
+		workers.reserve(threads);
+
+		for(unsigned t = 0; t < threads; ++t){
+			workers.emplace_back([&ready, &spawn, perThread]{
+				ready.arrive_and_wait();
+				for(std::size_t i = 0; i < perThread; ++i){
+					spawn(SpawnedEntity{});
+				}
+			});
+		}
+
+		ready.arrive_and_wait();
+		const auto begin = std::chrono::steady_clock::now();
+		workers.clear();
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+	}
+
+	export struct EntitySpawnBenchResult{
+		unsigned threads{};
+		std::size_t count{};
+
+		std::chrono::microseconds lockedPend{};
+		std::chrono::microseconds bufferedPend{};
+		/** @brief single pass drain of the buffered pendings into the slot map */
+		std::chrono::microseconds dump{};
+	};
+
+	/**
+	 * @brief spawn `count` entities spread over `threads` workers at once
+	 */
+	export EntitySpawnBenchResult benchmarkEntitySpawn(const unsigned threads, const std::size_t count){
+		const std::size_t perThread = count / threads;
+
+		EntitySpawnBenchResult result{threads, perThread * threads};
+
+		{
+			LockedPendings pendings{};
+			result.lockedPend = Bench::spawnFrom(threads, perThread, [&pendings](SpawnedEntity&& e){
+				pendings.pend(std::move(e));
+			});
+		}
+
+		Game::EntityGroup<SpawnedEntity> group{};
+		result.bufferedPend = Bench::spawnFrom(threads, perThread, [&group](SpawnedEntity&& e){
+			group.pend(std::move(e));
+		});
+
+		const auto begin = std::chrono::steady_clock::now();
+		group.dumpPendings();
+		result.dump = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+
+		return result;
+	}
+
+	export void runEntitySpawnBenchmark(const std::size_t count = 1'000'000){
+		const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+		for(unsigned threads = 1; threads <= maxThreads; threads *= 2){
+			const auto [tds, cnt, lockedPend, bufferedPend, dump] = Bench::benchmarkEntitySpawn(threads, count);
+
+			std::println("entity spawn | threads: {:>3} | entities: {:>8} | locked pend: {:>9} | buffered pend: {:>9} | dump: {:>9}",
+				tds, cnt, lockedPend, bufferedPend, dump);
+		}
+	}
+}
@@ -0,0 +1,114 @@
+export module Bench.Pixmap;
+
+import std;
+
+import Graphic.Pixmap;
+import Graphic.Color;
+import Math.SIMD;
+
+namespace Bench{
+	using Math::SIMD::InstructionSet;
+
+	/**
+	 * @brief glyph like coverage over a noisy color, a fixed seed so every instruction set sees the same pixels
+	 */
+	Graphic::Pixmap makePixmap(const std::uint32_t width, const std::uint32_t height, const std::uint32_t seed){
+		std::mt19937 rand{seed};
+		Graphic::Pixmap pixmap{width, height};
+
+		for(std::uint32_t i = 0; i < pixmap.pixelSize(); ++i){
+			const std::uint32_t alpha = rand() % 4 == 0 ? 0 : rand() % 256;
+			pixmap.setRaw(i, (rand() & ~Graphic::Color::a_Mask) | alpha);
+		}
+
+		return pixmap;
+	}
+
+	export struct PixmapBenchResult{
+		std::string_view kernel{};
+		InstructionSet set{};
+		std::chrono::microseconds time{};
+		/** @brief megapixels written per second */
+		float throughput{};
+	};
+
+	/**
+	 * @brief one kernel on a fresh copy of the destination per iteration, the copy is not timed
+	 */
+	template <std::invocable<Graphic::Pixmap&> Kernel>
+	PixmapBenchResult measure(const std::string_view kernel, const InstructionSet set, const Graphic::Pixmap& dst, const std::uint32_t pixels, const std::size_t iterations, Kernel fn){
+		std::chrono::nanoseconds total{};
+
+		for(std::size_t i = 0; i < iterations; ++i){
+			Graphic::Pixmap target{dst};
+
+			const auto begin = std::chrono::steady_clock::now();
+			fn(target);
+			total += std::chrono::steady_clock::now() - begin;
+		}
+
+		const float seconds = std::chrono::duration<float>(total).count();
+
+		return {
+			kernel, set, std::chrono::duration_cast<std::chrono::microseconds>(total),
+			seconds > 0 ? static_cast<float>(pixels) * static_cast<float>(iterations) / seconds / 1e6f : 0.f
+		};
+	}
+
+	/**
+	 * @brief the pixmap kernels at every instruction set up to the detected one, the limit is restored afterwards
+	 */
+	export std::vector<PixmapBenchResult> benchmarkPixmap(const std::uint32_t size, const std::size_t iterations){
+		const Graphic::Pixmap src = makePixmap(size, size, 0x5eed);
+		const Graphic::Pixmap dst = makePixmap(size, size, 0xd57);
+		const std::uint32_t pixels = size * size;
+
+		std::vector<PixmapBenchResult> results{};
+
+		for(const InstructionSet set : {InstructionSet::scalar, InstructionSet::sse2, InstructionSet::sse4_1, InstructionSet::avx2}){
+			if(set > Math::SIMD::getDetectedInstructionSet()) break;
+			Math::SIMD::setInstructionSetLimit(set);
+
+			results.push_back(Bench::measure("alpha blit", set, dst, pixels, iterations, [&](Graphic::Pixmap& target){
+				target.draw(src, 0, 0, true);
+			}));
+
+			results.push_back(Bench::measure("premultiply", set, dst, pixels, iterations, [](Graphic::Pixmap& target){
+				target.premultiplyAlpha();
+			}));
+
+			results.push_back(Bench::measure("bilinear 0.5x", set, dst, pixels / 4, iterations, [&](Graphic::Pixmap& target){
+				target.draw(src, 0, 0, size, size, 0, 0, size / 2, size / 2, true, false);
+			}));
+
+			results.push_back(Bench::measure("bilinear 0.5x blit", set, dst, pixels / 4, iterations, [&](Graphic::Pixmap& target){
+				target.draw(src, 0, 0, size, size, 0, 0, size / 2, size / 2, true, true);
+			}));
+
+			results.push_back(Bench::measure("flip y", set, dst, pixels, iterations, [](Graphic::Pixmap& target){
+				target.flipY();
+			}));
+
+			results.push_back(Bench::measure("fill", set, dst, pixels, iterations, [](Graphic::Pixmap& target){
+				target.fill(Graphic::Color{0x7f'3f'1f'ffu});
+			}));
+
+			results.push_back(Bench::measure("mix", set, dst, pixels, iterations, [](Graphic::Pixmap& target){
+				target.mix(Graphic::Color{0xff'ff'ff'ffu}, 0.35f);
+			}));
+		}
+
+		Math::SIMD::setInstructionSetLimit(InstructionSet::avx2);
+
+		return results;
+	}
+
+	export void runPixmapBenchmark(const std::initializer_list<std::uint32_t> sizes = {256, 2048}, const std::size_t iterations = 20){
+		for(const std::uint32_t size : sizes){
+			for(const auto& [kernel, set, time, throughput] : Bench::benchmarkPixmap(size, iterations)){
+				std::println("pixmap | {:<18} | {:<6} | size: {:>5} | iterations: {:>4} | time: {:>10} | {:>9.1f} MPix/s",
+					kernel, Math::SIMD::nameOf(set), size, iterations, time, throughput);
+			}
+		}
+	}
+}
@@ -0,0 +1,124 @@
+export module Bench.QuadTree;
+
+import std;
+
+import Geom.quad_tree;
+import Geom.quad_tree.flat;
+import Geom.Transform;
+import Geom.Vector2D;
+import Geom.Rect_Orthogonal;
+import Game.Entity.HitBox;
+import Math.Rand;
+
+namespace Bench{
+	struct MovingBox : Game::Hitbox, Geom::QuadTreeAdaptable<MovingBox, float>{
+		Geom::Vec2 vel{};
+
+		// ReSharper disable once CppHidingFunction
+		[[nodiscard]] Geom::OrthoRectFloat getBound() const noexcept{
+			return getMaxWrapBound();
+		}
+
+		void step(const float delta){
+			updateHitboxWithCCD({trans.vec + vel * delta, trans.rot});
+		}
+	};
+
+	/**
+	 * @brief same distribution as the entities spawned for @code Test::GamePart @endcode, the area grows with the count to keep the density
+	 */
+	std::vector<MovingBox> generate(const std::size_t count, const std::size_t seed){
+		Math::Rand rand{seed};
+		const float range = 120000.f * std::sqrt(static_cast<float>(count) / 10000.f);
+
+		std::vector<MovingBox> boxes(count);
+
+		for (MovingBox& box : boxes){
+			const Geom::Transform trans{
+				.vec = {rand.range(range), rand.range(range)},
+				.rot = rand.random(360.f)
+			};
+
+			auto genComponent = [&rand]{
+				return Game::HitBoxComponent{
+					.trans = {rand.range(80.f), rand.range(80.f), rand.random(360.f)},
+					.box = Geom::RectBox{
+						{rand.random(200.f, 700.f), rand.random(200.f, 700.f)},
+						{rand.random(50.f, 80.f), rand.random(50.f, 80.f)}
+					}
+				};
+			};
+
+			static_cast<Game::Hitbox&>(box) = Game::Hitbox{{genComponent(), genComponent()}, trans};
+			box.vel = {rand.range(10.f), rand.range(10.f)};
+		}
+
+		return boxes;
+	}
+
+	template <typename Tree, std::invocable<Tree&, std::vector<MovingBox>&> Update>
+	std::chrono::microseconds measure(const std::size_t count, const unsigned ticks, const std::size_t seed, const float worldSize, Update update){
+		std::vector<MovingBox> boxes = generate(count, seed);
+		Tree tree{{{-worldSize, -worldSize}, {worldSize, worldSize}}};
+		update(tree, boxes);
+
+		std::chrono::steady_clock::duration total{};
+
+		for(unsigned i = 0; i < ticks; ++i){
+			for (MovingBox& box : boxes){
+				box.step(1.f);
+			}
+
+			const auto begin = std::chrono::steady_clock::now();
+			update(tree, boxes);
+			total += std::chrono::steady_clock::now() - begin;
+		}
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(total);
+	}
+
+	export struct QuadTreeBenchResult{
+		std::size_t count{};
+		unsigned ticks{};
+
+		/** @brief the pointer quad tree rebuilt every tick, the previous behaviour of @code Game::WorldState::updateQuadTree @endcode */
+		std::chrono::microseconds pointerRebuild{};
+		std::chrono::microseconds flatRebuild{};
+		std::chrono::microseconds flatIncremental{};
+	};
+
+	export QuadTreeBenchResult benchmarkQuadTreeUpdate(const std::size_t count, const unsigned ticks = 120, const std::size_t seed = 114514){
+		constexpr float worldSize = 400000.f;
+
+		QuadTreeBenchResult result{count, ticks};
+
+		result.pointerRebuild = Bench::measure<Geom::quad_tree<MovingBox>>(count, ticks, seed, worldSize, [](Geom::quad_tree<MovingBox>& tree, std::vector<MovingBox>& boxes){
+			tree.reserved_clear();
+			for (MovingBox& box : boxes){
+				tree.insert(box);
+			}
+		});
+
+		result.flatRebuild = Bench::measure<Geom::quad_tree_flat<MovingBox>>(count, ticks, seed, worldSize, [](Geom::quad_tree_flat<MovingBox>& tree, std::vector<MovingBox>& boxes){
+			tree.reserved_clear();
+			for (MovingBox& box : boxes){
+				tree.insert(box);
+			}
+		});
+
+		result.flatIncremental = Bench::measure<Geom::quad_tree_flat<MovingBox>>(count, ticks, seed, worldSize, [](Geom::quad_tree_flat<MovingBox>& tree, std::vector<MovingBox>& boxes){
+			tree.synchronize(boxes);
+		});
+
+		return result;
+	}
+
+	export void runQuadTreeBenchmark(const std::initializer_list<std::size_t> counts = {10000, 50000, 100000}, const unsigned ticks = 120){
+		for (const std::size_t count : counts){
+			const auto [cnt, tks, pointerRebuild, flatRebuild, flatIncremental] = Bench::benchmarkQuadTreeUpdate(count, ticks);
+
+			std::println("quad tree update | entities: {:>7} | pointer rebuild: {:>8} | flat rebuild: {:>8} | flat incremental: {:>8}",
+				cnt, pointerRebuild / tks, flatRebuild / tks, flatIncremental / tks);
+		}
+	}
+}
@@ -0,0 +1,102 @@
+export module Bench.TextLayout;
+
+import std;
+
+import Font.TypeSettings;
+import Geom.Vector2D;
+
+namespace Bench{
+	using namespace Font::TypeSettings;
+
+	/**
+	 * @brief an edit applied to the text of the previous iteration
+	 */
+	struct TextEdit{
+		std::string_view name{};
+		void(*apply)(std::string& text, std::size_t iteration){};
+	};
+
+	constexpr std::array TextEdits{
+		TextEdit{"append line", [](std::string& text, const std::size_t iteration){
+			std::format_to(std::back_inserter(text), "\nline {} #<c|[ff8800]>appended#<c>", iteration);
+		}},
+		TextEdit{"edit last line", [](std::string& text, const std::size_t iteration){
+			text.push_back(static_cast<char>('a' + iteration % 26));
+		}},
+		TextEdit{"edit middle", [](std::string& text, const std::size_t iteration){
+			//insert before a plain word, a byte in the middle of a token would break it
+			text.insert(text.find("lazy", text.size() / 2), 1, static_cast<char>('a' + iteration % 26));
+		}},
+	};
+
+	std::string makeText(const std::size_t lines){
+		std::string text{};
+
+		for(std::size_t i = 0; i < lines; ++i){
+			std::format_to(std::back_inserter(text), "{}#<s|[40]>row {:>5}#<s> the quick brown fox jumps over the lazy dog",
+				i ? "\n" : "", i);
+		}
+
+		return text;
+	}
+
+	export struct TextLayoutBenchResult{
+		std::string_view edit{};
+		std::size_t lines{};
+		std::size_t iterations{};
+
+		/** @brief a new layout parsed from the first code every time */
+		std::chrono::microseconds full{};
+		/** @brief one layout reset with the edited text, rows before the edit are kept */
+		std::chrono::microseconds incremental{};
+	};
+
+	/**
+	 * @brief parse `lines` rows then apply `edit` `iterations` times, @link Font::TypeSettings::GlobalFontManager @endlink has to be loaded
+	 */
+	export TextLayoutBenchResult benchmarkTextLayout(const TextEdit& edit, const std::size_t lines, const std::size_t iterations){
+		constexpr Geom::Vec2 bound{4096, 1 << 16};
+
+		TextLayoutBenchResult result{edit.name, lines, iterations};
+
+		const auto measure = [&](auto parse){
+			std::string text = makeText(lines);
+
+			const auto begin = std::chrono::steady_clock::now();
+			for(std::size_t i = 0; i < iterations; ++i){
+				edit.apply(text, i);
+				parse(std::string{text});
+			}
+
+			return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+		};
+
+		result.full = measure([&](std::string&& text){
+			const auto layout = std::make_shared<GlyphLayout>();
+			layout->reset(std::move(text), bound);
+			globalParser.parse(layout);
+		});
+
+		const auto layout = std::make_shared<GlyphLayout>();
+		layout->reset(makeText(lines), bound);
+		globalParser.parse(layout);
+
+		result.incremental = measure([&](std::string&& text){
+			layout->reset(std::move(text), bound);
+			globalParser.parse(layout);
+		});
+
+		return result;
+	}
+
+	export void runTextLayoutBenchmark(const std::initializer_list<std::size_t> lines = {100, 1000}, const std::size_t iterations = 200){
+		for(const std::size_t count : lines){
+			for(const auto& edit : TextEdits){
+				const auto [name, cnt, its, full, incremental] = Bench::benchmarkTextLayout(edit, count, iterations);
+
+				std::println("text layout | {:<14} | lines: {:>6} | iterations: {:>5} | full: {:>10} | incremental: {:>10}",
+					name, cnt, its, full, incremental);
+			}
+		}
+	}
+}
@@ -0,0 +1,294 @@
+export module Bench.WorldSim;
+
+import std;
+
+import Game.World.Simulation;
+import Geom.quad_tree.flat;
+import Math.Rand;
+
+import Core.Global;
+import Core.JobSystem;
+
+namespace Bench{
+	export enum struct WorldSimScenario{
+		/** @brief the distribution main spawns for @code Test::GamePart @endcode */
+		uniform,
+		/** @brief dense clusters, most entities sit in deep manifolds */
+		clustered,
+		/** @brief sparse targets crossed by streams of small fast projectiles, stresses CCD */
+		projectiles,
+	};
+
+	export constexpr std::array AllWorldSimScenarios{
+		WorldSimScenario::uniform,
+		WorldSimScenario::clustered,
+		WorldSimScenario::projectiles,
+	};
+
+	export [[nodiscard]] constexpr std::string_view nameOf(const WorldSimScenario scenario) noexcept{
+		switch(scenario){
+			case WorldSimScenario::uniform : return "uniform";
+			case WorldSimScenario::clustered : return "clustered";
+			case WorldSimScenario::projectiles : return "projectiles";
+			default : std::unreachable();
+		}
+	}
+
+	export [[nodiscard]] std::optional<WorldSimScenario> scenarioOf(const std::string_view name) noexcept{
+		for(const WorldSimScenario scenario : AllWorldSimScenarios){
+			if(nameOf(scenario) == name) return scenario;
+		}
+
+		return std::nullopt;
+	}
+
+	Game::HitBoxComponent genComponent(Math::Rand& rand, const float minSize, const float maxSize){
+		return Game::HitBoxComponent{
+			.trans = {rand.range(80.f), rand.range(80.f), rand.random(360.f)},
+			.box = Geom::RectBox{
+				{rand.random(minSize, maxSize), rand.random(minSize, maxSize)},
+				{rand.random(50.f, 80.f), rand.random(50.f, 80.f)}
+			}
+		};
+	}
+
+	void addEntity(Game::WorldState& world, Math::Rand& rand, const Geom::Transform trans, const Geom::Vec2 vel, const float minSize, const float maxSize){
+		world.add([&](Game::RealEntity& entity){
+			entity.motion.trans = trans;
+			entity.motion.vel = {vel};
+			entity.hitbox = Game::Hitbox{{genComponent(rand, minSize, maxSize), genComponent(rand, minSize, maxSize)}, trans};
+		});
+	}
+
+	/**
+	 * @brief the area grows with the count to keep the density of the 10000 entities main spawns
+	 */
+	[[nodiscard]] float rangeOf(const std::size_t count) noexcept{
+		return 120000.f * std::sqrt(static_cast<float>(count) / 10000.f);
+	}
+
+	void spawn(Game::WorldState& world, const WorldSimScenario scenario, const std::size_t count, const std::size_t seed){
+		Math::Rand rand{seed};
+		const float range = rangeOf(count);
+
+		switch(scenario){
+			case WorldSimScenario::uniform :{
+				for(std::size_t i = 0; i < count; ++i){
+					addEntity(world, rand,
+						{{rand.range(range), rand.range(range)}, rand.random(360.f)},
+						{rand.range(10.f), rand.range(10.f)},
+						200.f, 700.f);
+				}
+				break;
+			}
+
+			case WorldSimScenario::clustered :{
+				constexpr std::size_t PerCluster = 200;
+				const std::size_t clusters = std::max<std::size_t>(1, count / PerCluster);
+
+				std::vector<Geom::Vec2> centers(clusters);
+				for(Geom::Vec2& center : centers){
+					center = {rand.range(range), rand.range(range)};
+				}
+
+				for(std::size_t i = 0; i < count; ++i){
+					//uniform over the disc
+					const float radius = 6000.f * std::sqrt(rand.random(1.f));
+					const Geom::Vec2 pos = centers[i % clusters] + Geom::Vec2{radius, 0}.rotate(rand.random(360.f));
+
+					addEntity(world, rand,
+						{pos, rand.random(360.f)},
+						{rand.range(10.f), rand.range(10.f)},
+						200.f, 700.f);
+				}
+				break;
+			}
+
+			case WorldSimScenario::projectiles :{
+				const std::size_t targets = count / 4;
+
+				for(std::size_t i = 0; i < targets; ++i){
+					addEntity(world, rand,
+						{{rand.range(range), rand.range(range)}, rand.random(360.f)},
+						{},
+						200.f, 700.f);
+				}
+
+				//same speed as the projectiles fired with F
+				constexpr std::size_t PerStream = 50;
+				constexpr float Speed = 500.f;
+				constexpr float Spacing = 600.f;
+
+				for(std::size_t i = targets; i < count; i += PerStream){
+					const Geom::Vec2 origin{rand.range(range), rand.range(range)};
+					const float angle = rand.random(360.f);
+					const Geom::Vec2 dir = Geom::Vec2{1, 0}.rotate(angle);
+
+					for(std::size_t j = 0; j < PerStream && i + j < count; ++j){
+						addEntity(world, rand,
+							{origin - dir * (Spacing * static_cast<float>(j)), angle},
+							dir * Speed,
+							60.f, 120.f);
+					}
+				}
+				break;
+			}
+
+			default : std::unreachable();
+		}
+	}
+
+	export struct StagePercentiles{
+		std::string_view stage{};
+
+		std::chrono::nanoseconds p50{};
+		std::chrono::nanoseconds p90{};
+		std::chrono::nanoseconds p99{};
+		std::chrono::nanoseconds max{};
+		std::chrono::nanoseconds mean{};
+	};
+
+	export struct WorldSimBenchResult{
+		WorldSimScenario scenario{};
+		Game::BroadPhase broadPhase{};
+		bool parallelManifold{};
+
+		std::size_t entities{};
+		unsigned ticks{};
+		std::size_t seed{};
+		unsigned threads{};
+
+		std::vector<StagePercentiles> stages{};
+	};
+
+	export struct WorldSimBenchConfig{
+		WorldSimScenario scenario{};
+		std::size_t count{10000};
+		/** @brief measured ticks, warm up ticks are not recorded */
+		unsigned ticks{600};
+		unsigned warmupTicks{60};
+		std::size_t seed{0x5eed};
+		Game::BroadPhase broadPhase{Game::BroadPhase::quadTree};
+		bool parallelManifold{true};
+	};
+
+	[[nodiscard]] StagePercentiles percentilesOf(const std::string_view stage, std::vector<std::chrono::nanoseconds>& samples){
+		StagePercentiles result{stage};
+		if(samples.empty()) return result;
+
+		std::ranges::sort(samples);
+
+		//nearest rank
+		const auto at = [&samples](const double p){
+			const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samples.size())));
+			return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+		};
+
+		result.p50 = at(.5);
+		result.p90 = at(.9);
+		result.p99 = at(.99);
+		result.max = samples.back();
+		result.mean = std::reduce(samples.begin(), samples.end(), std::chrono::nanoseconds{}) / samples.size();
+
+		return result;
+	}
+
+	/**
+	 * @brief step a fresh world with the same stages and order as @code Test::GamePart @endcode, one tick per step
+	 */
+	export WorldSimBenchResult benchmarkWorldSim(const WorldSimBenchConfig& config){
+		Game::WorldSimulation simulation{};
+		simulation.parallelManifold = config.parallelManifold;
+		simulation.setBroadPhase(config.broadPhase);
+
+		const float size = rangeOf(config.count) * 4.f;
+		simulation.world.quadTree = Geom::quad_tree_flat<Game::RealEntity>{{
+			{-size, -size}, {size, size}
+		}};
+
+		Bench::spawn(simulation.world, config.scenario, config.count, config.seed);
+
+		using Samples = std::vector<std::chrono::nanoseconds>;
+		static constexpr std::array<std::string_view, 8> StageNames{
+			"dump", "update", "structure", "broad_phase", "manifold_0", "manifold_12", "manifold_3", "total"
+		};
+
+		std::array<Samples, StageNames.size()> samples{};
+		for(Samples& stage : samples){
+			stage.reserve(config.ticks);
+		}
+
+		for(unsigned tick = 0; tick < config.warmupTicks + config.ticks; ++tick){
+			simulation.step(1.f);
+			simulation.resolveCollisions(1.f);
+
+			if(tick < config.warmupTicks) continue;
+
+			const Game::SimulationStageTimes& t = simulation.getLastStageTimes();
+			const std::array values{
+				t.dump, t.update, t.structure, t.broadPhase, t.manifold_0, t.manifold_12, t.manifold_3,
+				t.dump + t.update + t.structure + t.broadPhase + t.manifold()
+			};
+
+			for(std::size_t i = 0; i < values.size(); ++i){
+				samples[i].push_back(values[i]);
+			}
+		}
+
+		WorldSimBenchResult result{
+			.scenario = config.scenario,
+			.broadPhase = config.broadPhase,
+			.parallelManifold = config.parallelManifold,
+			.entities = simulation.world.realEntities.size(),
+			.ticks = config.ticks,
+			.seed = config.seed,
+			.threads = Core::Global::jobSystem ? Core::Global::jobSystem->concurrency() : 1u,
+		};
+
+		for(std::size_t i = 0; i < StageNames.size(); ++i){
+			result.stages.push_back(Bench::percentilesOf(StageNames[i], samples[i]));
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief one JSON object per result, durations in microseconds
+	 */
+	export [[nodiscard]] std::string toJson(const std::span<const WorldSimBenchResult> results){
+		const auto us = [](const std::chrono::nanoseconds ns){
+			return std::chrono::duration<double, std::micro>{ns}.count();
+		};
+
+		std::string json{"[\n"};
+
+		for(const auto& [i, result] : results | std::views::enumerate){
+			std::format_to(std::back_inserter(json),
+				"  {{\n"
+				"    \"scenario\": \"{}\",\n"
+				"    \"broad_phase\": \"{}\",\n"
+				"    \"parallel_manifold\": {},\n"
+				"    \"entities\": {},\n"
+				"    \"ticks\": {},\n"
+				"    \"seed\": {},\n"
+				"    \"threads\": {},\n"
+				"    \"stages_us\": {{\n",
+				nameOf(result.scenario),
+				result.broadPhase == Game::BroadPhase::quadTree ? "quad_tree" : "sweep_and_prune",
+				result.parallelManifold,
+				result.entities, result.ticks, result.seed, result.threads);
+
+			for(const auto& [j, stage] : result.stages | std::views::enumerate){
+				std::format_to(std::back_inserter(json),
+					"      \"{}\": {{\"p50\": {:.3f}, \"p90\": {:.3f}, \"p99\": {:.3f}, \"max\": {:.3f}, \"mean\": {:.3f}}}{}\n",
+					stage.stage, us(stage.p50), us(stage.p90), us(stage.p99), us(stage.max), us(stage.mean),
+					j + 1 == std::ssize(result.stages) ? "" : ",");
+			}
+
+			std::format_to(std::back_inserter(json), "    }}\n  }}{}\n", i + 1 == std::ssize(results) ? "" : ",");
+		}
+
+		json += "]\n";
+		return json;
+	}
+}
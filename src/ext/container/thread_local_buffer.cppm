@@ -0,0 +1,159 @@
+export module ext.thread_local_buffer;
+
+import std;
+
+namespace ext{
+	/**
+	 * @brief Multi-producer append buffer, each producing thread appends to its own vector without any lock.
+	 *
+	 * A thread registers its buffer once per container with a single CAS, later pushes touch thread owned memory only.
+	 * Draining (@link consume @endlink, @link clear @endlink) must be ordered after the pushes by the caller,
+	 * e.g. done in the exclusive phase after parallel tasks joined.
+	 *
+	 * Items of one thread keep their push order, the order across threads is unspecified.
+	 */
+	export
+	template <typename T>
+	struct thread_local_buffer{
+	private:
+		struct local_buffer{
+			std::vector<T> items{};
+			local_buffer* next{};
+		};
+
+		struct cache_entry{
+			std::uint64_t owner;
+			local_buffer* buffer;
+		};
+
+		struct thread_cache{
+			std::vector<cache_entry> entries{};
+			/** @brief value of @link destroyedCount @endlink when the entries were last swept */
+			std::uint64_t sweptAt{};
+		};
+
+		static inline std::atomic<std::uint64_t> lastInstanceID{};
+
+		/** @brief guards @link liveInstances @endlink, taken only on construction, destruction and sweeps */
+		static inline std::mutex registryMutex{};
+		static inline std::unordered_set<std::uint64_t> liveInstances{};
+		static inline std::atomic<std::uint64_t> destroyedCount{};
+
+		/**
+		 * @brief ids are never reused, so an entry of a destroyed container can never alias a new one,
+		 * a thread drops such entries itself the next time it pushes after any container was destroyed
+		 */
+		static inline thread_local thread_cache cache{};
+
+		std::uint64_t instanceID{lastInstanceID.fetch_add(1, std::memory_order::relaxed) + 1};
+		std::atomic<local_buffer*> head{};
+
+		static void evictStale(){
+			std::scoped_lock lock{registryMutex};
+			cache.sweptAt = destroyedCount.load(std::memory_order::relaxed);
+			std::erase_if(cache.entries, [](const cache_entry& entry){
+				return !liveInstances.contains(entry.owner);
+			});
+		}
+
+		[[nodiscard]] local_buffer& acquire(){
+			if(destroyedCount.load(std::memory_order::relaxed) != cache.sweptAt){
+				evictStale();
+			}
+
+			for(const cache_entry& entry : cache.entries){
+				if(entry.owner == instanceID) return *entry.buffer;
+			}
+
+			auto* buffer = new local_buffer{};
+			buffer->next = head.load(std::memory_order::relaxed);
+			while(!head.compare_exchange_weak(buffer->next, buffer, std::memory_order::release, std::memory_order::relaxed)){}
+
+			cache.entries.push_back({instanceID, buffer});
+			return *buffer;
+		}
+
+		template <typename Fn>
+		void each_buffer(Fn fn) const{
+			for(local_buffer* cur = head.load(std::memory_order::acquire); cur; cur = cur->next){
+				fn(*cur);
+			}
+		}
+
+	public:
+		[[nodiscard]] thread_local_buffer(){
+			std::scoped_lock lock{registryMutex};
+			liveInstances.insert(instanceID);
+		}
+
+		~thread_local_buffer(){
+			{
+				std::scoped_lock lock{registryMutex};
+				liveInstances.erase(instanceID);
+				destroyedCount.fetch_add(1, std::memory_order::relaxed);
+			}
+
+			local_buffer* cur = head.load(std::memory_order::acquire);
+			while(cur){
+				delete std::exchange(cur, cur->next);
+			}
+		}
+
+		thread_local_buffer(const thread_local_buffer& other) = delete;
+		thread_local_buffer(thread_local_buffer&& other) noexcept = delete;
+		thread_local_buffer& operator=(const thread_local_buffer& other) = delete;
+		thread_local_buffer& operator=(thread_local_buffer&& other) noexcept = delete;
+
+		/**
+		 * @brief thread safe
+		 */
+		template <typename Ty>
+		void push(Ty&& item){
+			acquire().items.push_back(std::forward<Ty>(item));
+		}
+
+		/**
+		 * @brief thread safe
+		 */
+		template <typename... Args>
+			requires (std::constructible_from<T, Args...>)
+		T& emplace(Args&& ...args){
+			return acquire().items.emplace_back(std::forward<Args>(args)...);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept{
+			std::size_t count{};
+			each_buffer([&count](const local_buffer& buffer){
+				count += buffer.items.size();
+			});
+			return count;
+		}
+
+		[[nodiscard]] bool empty() const noexcept{
+			return size() == 0;
+		}
+
+		/**
+		 * @brief visit every item then clear, no thread may push concurrently
+		 */
+		template <std::invocable<T&> Fn>
+		void consume(Fn fn){
+			each_buffer([&fn](local_buffer& buffer){
+				for(T& item : buffer.items){
+					std::invoke(fn, item);
+				}
+
+				buffer.items.clear();
+			});
+		}
+
+		/**
+		 * @brief no thread may push concurrently
+		 */
+		void clear() noexcept{
+			each_buffer([](local_buffer& buffer){
+				buffer.items.clear();
+			});
+		}
+	};
+}
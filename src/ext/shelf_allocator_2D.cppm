@@ -0,0 +1,345 @@
+module;
+
+#include <cassert>
+
+export module ext.shelf_allocator_2D;
+
+import Geom.Vector2D;
+import Geom.Rect_Orthogonal;
+import std;
+
+namespace ext{
+	/**
+	 * @brief Shelf packer, an alternative to @link allocator_2D @endlink for pages of many small regions of similar heights.
+	 *
+	 * The page is cut into full width shelves stacked from the top, each holding a row of regions no taller than itself.
+	 * Freed room always merges back exactly: spans merge within a shelf and emptied shelves merge with their empty neighbours,
+	 * churn does not fragment the page.
+	 *
+	 * Fit queries are logarithmic:
+	 * used shelves are found through a max-free segment tree over the shelf heights, empty shelves through a set ordered by height,
+	 * and the free spans of a shelf are ordered by width, so the narrowest fitting span is a single lower bound.
+	 *
+	 * @link compact @endlink repacks every region sorted by height and reports where they went.
+	 */
+	export class shelf_allocator_2D{
+	public:
+		using size_type = std::uint32_t;
+		using extent_type = Geom::Vector2D<size_type>;
+		using point_type = Geom::Vector2D<size_type>;
+		using rect_type = Geom::Rect_Orthogonal<size_type>;
+
+		struct relocation{
+			/** @brief the allocated region before the move */
+			rect_type from{};
+			point_type to{};
+		};
+
+		/** @brief new shelves are this multiple tall, so regions of close heights share them */
+		static constexpr size_type ShelfHeightStep{4};
+
+	private:
+		using T = size_type;
+
+		struct span{
+			T width{};
+			/** @brief of the allocated region, zero if free */
+			T height{};
+
+			[[nodiscard]] constexpr bool free() const noexcept{
+				return height == 0;
+			}
+		};
+
+		struct shelf{
+			T height{};
+			/** @brief by x, covering the whole width */
+			std::map<T, span> spans{};
+			/** @brief [width, x] of the free spans */
+			std::set<std::pair<T, T>> freeSpans{};
+
+			[[nodiscard]] bool empty() const noexcept{
+				return spans.size() == 1 && spans.begin()->second.free();
+			}
+
+			[[nodiscard]] T maxFree() const noexcept{
+				return freeSpans.empty() ? 0 : freeSpans.rbegin()->first;
+			}
+		};
+
+		using shelf_iterator = std::map<T, shelf>::iterator;
+
+		extent_type size{};
+		T remainArea{};
+
+		/** @brief by y, covering the whole height */
+		std::map<T, shelf> shelves{};
+
+		/** @brief [height, y] of the empty shelves */
+		std::set<std::pair<T, T>> emptyShelves{};
+
+		/** @brief [max free width, y] of the used shelves, by shelf height */
+		std::map<T, std::set<std::pair<T, T>>> usedShelves{};
+
+		/** @brief leaves are the shelf heights, each holding the widest free span among the used shelves of that height */
+		std::vector<T> maxFreeTree{};
+		std::size_t leafCount{};
+
+	public:
+		[[nodiscard]] shelf_allocator_2D() = default;
+
+		[[nodiscard]] explicit shelf_allocator_2D(const extent_type size) :
+			size{size}, remainArea{size.area()},
+			maxFreeTree(std::bit_ceil(static_cast<std::size_t>(size.y) + 1) * 2),
+			leafCount{std::bit_ceil(static_cast<std::size_t>(size.y) + 1)}{
+			indexShelf(shelves.emplace(0, emptyShelf(size.y)).first);
+		}
+
+		[[nodiscard]] std::optional<rect_type> allocate(const extent_type extent){
+			assert(extent.area() > 0);
+
+			if(remainArea < extent.area() || extent.x > size.x || extent.y > size.y) return std::nullopt;
+
+			const T classHeight = std::min(size.y, (extent.y + ShelfHeightStep - 1) / ShelfHeightStep * ShelfHeightStep);
+
+			//a used shelf close to the height, else a new shelf cut from an empty one, else any shelf that fits
+			const shelf_iterator used = lowestUsedFit(extent);
+			shelf_iterator target = shelves.end();
+
+			if(used != shelves.end() && used->second.height <= classHeight + classHeight / 2){
+				target = used;
+			}
+
+			if(target == shelves.end()){
+				if(const auto empty = emptyShelves.lower_bound({classHeight, 0}); empty != emptyShelves.end()){
+					target = splitShelf(shelves.find(empty->second), classHeight);
+				}
+			}
+
+			if(target == shelves.end()) target = used;
+
+			if(target == shelves.end()){
+				if(const auto empty = emptyShelves.lower_bound({extent.y, 0}); empty != emptyShelves.end()){
+					target = shelves.find(empty->second);
+				}
+			}
+
+			if(target == shelves.end()) return std::nullopt;
+
+			remainArea -= extent.area();
+			return place(target, extent);
+		}
+
+		void deallocate(const point_type src) noexcept{
+			const auto shelfItr = shelves.find(src.y);
+			if(shelfItr == shelves.end()) return;
+
+			shelf& s = shelfItr->second;
+
+			const auto spanItr = s.spans.find(src.x);
+			if(spanItr == s.spans.end() || spanItr->second.free()) return;
+
+			unindexShelf(shelfItr);
+
+			remainArea += spanItr->second.width * spanItr->second.height;
+
+			//merge with the free neighbours
+			auto first = spanItr;
+			auto last = std::next(spanItr);
+			if(first != s.spans.begin() && std::prev(first)->second.free()){
+				--first;
+				s.freeSpans.erase({first->second.width, first->first});
+			}
+
+			if(last != s.spans.end() && last->second.free()){
+				s.freeSpans.erase({last->second.width, last->first});
+				++last;
+			}
+
+			const T mergedWidth = std::prev(last)->first + std::prev(last)->second.width - first->first;
+			first->second = span{mergedWidth};
+			s.spans.erase(std::next(first), last);
+			s.freeSpans.emplace(mergedWidth, first->first);
+
+			if(s.empty()){
+				mergeEmpty(shelfItr);
+			}else{
+				indexShelf(shelfItr);
+			}
+		}
+
+		/**
+		 * @brief Repacks every allocated region, tallest first. Nothing changes if the repacked regions would not fit.
+		 * @return the regions that moved, the content has to be moved along by the caller
+		 */
+		[[nodiscard]] std::vector<relocation> compact(){
+			std::vector<rect_type> regions{};
+
+			for(const auto& [y, s] : shelves){
+				for(const auto& [x, sp] : s.spans){
+					if(!sp.free()) regions.push_back({Geom::FromExtent, {x, y}, sp.width, sp.height});
+				}
+			}
+
+			std::ranges::sort(regions, [](const rect_type& l, const rect_type& r){
+				return std::tuple{r.getHeight(), r.getWidth(), l.getSrcY(), l.getSrcX()} < std::tuple{l.getHeight(), l.getWidth(), r.getSrcY(), r.getSrcX()};
+			});
+
+			shelf_allocator_2D packed{size};
+			std::vector<relocation> relocations{};
+
+			for(const rect_type& region : regions){
+				const auto to = packed.allocate(region.getSize());
+				if(!to) return {};
+
+				if(to->getSrc() != region.getSrc()){
+					relocations.push_back({region, to->getSrc()});
+				}
+			}
+
+			*this = std::move(packed);
+			return relocations;
+		}
+
+		[[nodiscard]] extent_type extent() const noexcept{ return size; }
+
+		[[nodiscard]] T get_valid_area() const noexcept{ return remainArea; }
+
+	private:
+		[[nodiscard]] shelf emptyShelf(const T height) const{
+			return shelf{height, {{0, span{size.x}}}, {{size.x, 0}}};
+		}
+
+		void setMaxFree(const T height, const T width) noexcept{
+			std::size_t index = leafCount + height;
+			maxFreeTree[index] = width;
+
+			for(index /= 2; index > 0; index /= 2){
+				maxFreeTree[index] = std::max(maxFreeTree[index * 2], maxFreeTree[index * 2 + 1]);
+			}
+		}
+
+		/**
+		 * @brief the lowest used shelf at least as tall as the extent with a free span at least as wide, the tightest of that height
+		 */
+		[[nodiscard]] shelf_iterator lowestUsedFit(const extent_type extent) noexcept{
+			std::size_t index = leafCount + extent.y;
+
+			//climb until a subtree to the right holds a wide enough span
+			while(maxFreeTree[index] < extent.x){
+				while(index & 1) index /= 2;
+				if(index == 0) return shelves.end();
+				++index;
+			}
+
+			while(index < leafCount){
+				index *= 2;
+				if(maxFreeTree[index] < extent.x) ++index;
+			}
+
+			const auto& bucket = usedShelves.find(static_cast<T>(index - leafCount))->second;
+			const auto tightest = bucket.lower_bound({extent.x, 0});
+			assert(tightest != bucket.end());
+
+			return shelves.find(tightest->second);
+		}
+
+		void indexShelf(const shelf_iterator itr){
+			const auto& [y, s] = *itr;
+
+			if(s.empty()){
+				emptyShelves.emplace(s.height, y);
+			}else{
+				auto& bucket = usedShelves[s.height];
+				bucket.emplace(s.maxFree(), y);
+				setMaxFree(s.height, bucket.rbegin()->first);
+			}
+		}
+
+		/**
+		 * @brief removes the shelf from the fit indices, call before the shelf changes and index it again afterwards
+		 */
+		void unindexShelf(const shelf_iterator itr) noexcept{
+			const auto& [y, s] = *itr;
+
+			if(s.empty()){
+				emptyShelves.erase({s.height, y});
+			}else{
+				const auto bucket = usedShelves.find(s.height);
+				bucket->second.erase({s.maxFree(), y});
+
+				if(bucket->second.empty()){
+					setMaxFree(s.height, 0);
+					usedShelves.erase(bucket);
+				}else{
+					setMaxFree(s.height, bucket->second.rbegin()->first);
+				}
+			}
+		}
+
+		/**
+		 * @brief cuts the empty shelf to `height`, the rest stays an empty shelf below it
+		 */
+		shelf_iterator splitShelf(const shelf_iterator itr, const T height){
+			shelf& s = itr->second;
+			if(s.height <= height) return itr;
+
+			unindexShelf(itr);
+
+			const T restY = itr->first + height;
+			const T restHeight = s.height - height;
+			s.height = height;
+
+			indexShelf(itr);
+			indexShelf(shelves.emplace_hint(std::next(itr), restY, emptyShelf(restHeight)));
+
+			return itr;
+		}
+
+		/**
+		 * @brief merges the emptied, unindexed shelf with its empty neighbours and indexes the result
+		 */
+		void mergeEmpty(shelf_iterator itr){
+			if(const auto next = std::next(itr); next != shelves.end() && next->second.empty()){
+				unindexShelf(next);
+				itr->second.height += next->second.height;
+				shelves.erase(next);
+			}
+
+			if(itr != shelves.begin()){
+				if(const auto prev = std::prev(itr); prev->second.empty()){
+					unindexShelf(prev);
+					prev->second.height += itr->second.height;
+					shelves.erase(itr);
+					itr = prev;
+				}
+			}
+
+			indexShelf(itr);
+		}
+
+		rect_type place(const shelf_iterator itr, const extent_type extent){
+			unindexShelf(itr);
+
+			shelf& s = itr->second;
+
+			//the narrowest free span that fits, keeps the wide ones for wide regions
+			const auto target = s.freeSpans.lower_bound({extent.x, 0});
+			assert(target != s.freeSpans.end());
+
+			const auto [width, x] = *target;
+			const T rest = width - extent.x;
+			s.freeSpans.erase(target);
+
+			s.spans[x] = span{extent.x, extent.y};
+			if(rest > 0){
+				s.spans.emplace(x + extent.x, span{rest});
+				s.freeSpans.emplace(rest, x + extent.x);
+			}
+
+			indexShelf(itr);
+
+			return rect_type{Geom::FromExtent, {x, itr->first}, extent};
+		}
+	};
+}
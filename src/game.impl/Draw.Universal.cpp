@@ -9,10 +9,15 @@ import Core.Global.Graphic;
 import Game.World.RealEntity;
 import Game.Entity.HitBox;
 
+import std;
+
 
 using FxParam = Graphic::InstantBatchAutoParam<Graphic::Vertex_World, Graphic::Draw::DepthModifier>;
 using Drawer = Graphic::Draw::Drawer<FxParam::VertexType>;
 
+using SpriteParam = Graphic::InstantBatchAutoParam<Graphic::Instance_World, Graphic::Draw::DepthModifier>;
+using SpriteDrawer = Graphic::Draw::Drawer<SpriteParam::VertexType>;
+
 namespace Colors = Graphic::Colors;
 
 FxParam getParam(const float z){
@@ -21,6 +26,12 @@ FxParam getParam(const float z){
 	return autoParam;
 }
 
+SpriteParam getSpriteParam(const float z){
+	SpriteParam autoParam{Core::Global::rendererWorld->instanceBatch, Graphic::Draw::WhiteRegion};
+	autoParam.modifier.depth = z;
+	return autoParam;
+}
+
 void Game::Graphic::Draw::hitbox(const Hitbox& hitbox, const float z){
 	namespace Draw = ::Graphic::Draw;
 
@@ -34,22 +45,33 @@ void Game::Graphic::Draw::hitbox(const Hitbox& hitbox, const float z){
 	}
 }
 
-void Game::Graphic::Draw::realEntity(const RealEntity& entity){
+void Game::Graphic::Draw::realEntity(const RealEntity& entity, const float interpolation){
 
 	namespace Draw = ::Graphic::Draw;
 	auto autoParam = getParam(entity.zLayer);
 
+	//boxes are placed at the current transform, move them back to the interpolated one
+	const Geom::Transform current = entity.hitbox.trans;
+	const Geom::Transform rendered = entity.getInterpolatedTrans(interpolation);
+	const Geom::Transform toRendered{rendered.vec, rendered.rot - current.rot};
+
 	for (const auto & component : entity.hitbox.components){
-		Drawer::Line::circularPoly_fixed<4>(autoParam, 4.f, component.box, entity.manifold.underCorrection ? Colors::RED_DUSK : Colors::WHITE);
+		std::array<Geom::Vec2, 4> box{};
+		for(int i = 0; i < 4; ++i){
+			box[i] = (component.box[i] - current.vec) | toRendered;
+		}
+
+		Drawer::Line::circularPoly_fixed<4>(autoParam, 4.f, box, entity.manifold.underCorrection ? Colors::RED_DUSK : Colors::WHITE);
 		Drawer::Line::line(++autoParam, 4.f,
-			entity.hitbox.trans.vec, component.box.v0,
+			rendered.vec, box[0],
 			Colors::ROYAL.copy().toLightColor(), Colors::YELLOW.copy().toLightColor());
 	}
 
+	auto spriteParam = getSpriteParam(entity.zLayer);
 	for (const auto & data : entity.manifold.postData){
-		Drawer::rectOrtho(++autoParam, data.mainIntersection.pos, 18, Colors::ROYAL.copy().toLightColor());
-		Drawer::Line::lineAngle(++autoParam, 4.f, {data.mainIntersection.pos, data.mainIntersection.normal.angle()}, 90, Colors::CRIMSON.copy().toLightColor());
-		Drawer::Line::line(++autoParam, 4.f, entity.motion.pos(), entity.motion.pos() + entity.last, Colors::ACID.copy().toLightColor());
+		SpriteDrawer::rectOrtho(++spriteParam, data.mainIntersection.pos, 18, Colors::ROYAL.copy().toLightColor());
+		SpriteDrawer::Line::lineAngle(++spriteParam, 4.f, {data.mainIntersection.pos, data.mainIntersection.normal.angle()}, 90, Colors::CRIMSON.copy().toLightColor());
+		SpriteDrawer::Line::line(++spriteParam, 4.f, entity.motion.pos(), entity.motion.pos() + entity.last, Colors::ACID.copy().toLightColor());
 	}
 }
 
@@ -1,8 +1,6 @@
 module Game.Entity;
 
-import Game.World.State;
-
 void Game::Entity::notifyDelete(WorldState& worldState) noexcept{
+	//removal is done by the group the concrete type lives in
 	state = EntityState::deletable;
-	worldState.all.notifyDelete(getID());
 }
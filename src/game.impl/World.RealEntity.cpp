@@ -7,9 +7,6 @@ module Game.World.RealEntity;
 import Game.World.State;
 import Geom;
 
-import Assets.Fx;
-import Graphic.Effect.Manager;
-import Graphic.Color;
 
 
 constexpr float MinimumSuccessAccuracy = 1. / 32.;
@@ -68,7 +65,7 @@ Geom::Vec2 approachTest(
 	return sbjBox.v0 - beginning;
 }
 
-void Game::RealEntity::Manifold::processIntersections(RealEntity& subject) noexcept{
+void Game::RealEntity::Manifold::processIntersections(RealEntity& subject, const EntityGroup<RealEntity>& entities) noexcept{
 	postData.clear();
 
 	// if(underCorrection)return;
@@ -78,12 +75,14 @@ void Game::RealEntity::Manifold::processIntersections(RealEntity& subject) noexc
 		assert(data.data.transition <= subject.hitbox.getBackTraceIndex());
 		assert(!data.data.empty());
 
+		const RealEntity& other = entities[data.other];
+
 		for (const auto index : data.data.indices){
 			if(auto itr = std::ranges::find(postData, data.other, &CollisionPostData::other);
 							itr != postData.end())continue;
 
 			const auto& sbj = subject.hitbox.components[index.subject].box;
-			const auto& obj = data.other->hitbox.components[index.object].box;
+			const auto& obj = other.hitbox.components[index.object].box;
 
 			CollisionPostData* validPostData{};
 
@@ -91,10 +90,10 @@ void Game::RealEntity::Manifold::processIntersections(RealEntity& subject) noexc
 			auto objBox = static_cast<Geom::QuadBox>(obj);
 
 			sbjBox.move(subject.hitbox.getBackTraceMove());
-			objBox.move(data.other->hitbox.getBackTraceMove());
+			objBox.move(other.hitbox.getBackTraceMove());
 
 			const auto sbjMove = subject.hitbox.getBackTraceUnitMove();
-			const auto objMove = data.other->hitbox.getBackTraceUnitMove();
+			const auto objMove = other.hitbox.getBackTraceUnitMove();
 
 			if(underCorrection || sbjMove.length2() + objMove.length2() < Math::sqr(15) || std::ranges::contains(lastCollided, data.other)){
 				validPostData = &postData.emplace_back(data.other);
@@ -102,7 +101,7 @@ void Game::RealEntity::Manifold::processIntersections(RealEntity& subject) noexc
 				const auto correction =
 					approachTest(
 						sbjBox, subject.hitbox.getBackTraceUnitMove(),
-						objBox, data.other->hitbox.getBackTraceUnitMove(),
+						objBox, other.hitbox.getBackTraceUnitMove(),
 						sbj.getNormalU(), sbj.getNormalV(), obj.getNormalU(), obj.getNormalV());
 
 				validPostData = &postData.emplace_back(data.other, correction);
@@ -136,8 +135,8 @@ void Game::RealEntity::notifyDelete(WorldState& worldState) noexcept{
 	worldState.realEntities.notifyDelete(getID());
 }
 
-void Game::RealEntity::draw() const{
-	Graphic::Draw::realEntity(*this);
+void Game::RealEntity::draw(const float interpolation) const{
+	Graphic::Draw::realEntity(*this, interpolation);
 }
 
 void Game::RealEntity::postProcessCollisions_2() noexcept{
@@ -165,9 +164,9 @@ void Game::RealEntity::postProcessCollisions_2() noexcept{
 	// hitbox.updateHitbox(motion.trans);
 }
 
-void Game::RealEntity::postProcessCollisions_3(const UpdateTick delta) noexcept{
+void Game::RealEntity::postProcessCollisions_3(const EntityGroup<RealEntity>& entities, const UpdateTick delta) noexcept{
 	for (const auto& data : manifold.postData){
-		calCollideTo(*data.other, data.mainIntersection, 1 / manifold.postData.size(), delta);
+		calCollideTo(entities[data.other], data.mainIntersection, 1 / manifold.postData.size(), delta);
 	}
 
 	motion.trans.vec += collisionTestTempPos;
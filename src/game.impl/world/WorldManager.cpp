@@ -2,13 +2,22 @@ module Game.World.State;
 
 import Game.World.RealEntity;
 
-void Game::WorldState::draw(const Geom::OrthoRectFloat viewport) const{
-	drawGroup(realEntities, viewport);
+void Game::WorldState::draw(const Geom::OrthoRectFloat viewport, const float interpolation) const{
+	drawGroup(realEntities, viewport, interpolation);
+}
+
+void Game::WorldState::dumpAll(){
+	realEntities.dumpAll();
+}
+
+void Game::WorldState::update_par(const UpdateTick tick){
+	realEntities.update_par(tick);
 }
 
 void Game::WorldState::updateQuadTree(){
-	quadTree.reserved_clear();
-	for(std::shared_ptr<RealEntity>& value : realEntities.entities | std::views::values){
-		quadTree.insert(*value);
-	}
+	quadTree.synchronize(realEntities.getEntities());
+}
+
+void Game::WorldState::updateSweepAndPrune(){
+	sweepAndPrune.synchronize(realEntities.getEntities());
 }
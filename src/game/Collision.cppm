@@ -5,6 +5,7 @@ module;
 export module Game.Entity.HitBox;
 
 export import Geom.Shape.RectBox;
+import Geom.Shape.RectBox.Batch;
 import Geom.Transform;
 import Geom.Vector2D;
 import Geom.Rect_Orthogonal;
@@ -80,11 +81,6 @@ namespace Game{
 		std::vector<HitBoxComponent> hitBoxGroup{};
 	};
 
-	union HitboxSpan{
-		std::span<Geom::RectBoxBrief> temporary;
-		std::span<const HitBoxComponent> components{};
-	};
-
 	export
 	template <typename T>
 	concept CollisionCollector = requires(T t){
@@ -286,316 +282,89 @@ namespace Game{
 			return wrapBound_CCD.overlapRough(other.wrapBound_CCD) && wrapBound_CCD.overlapExact(other.wrapBound_CCD);
 		}
 
-		//TODO remake this bullshit...
+		/**
+		 * @brief Find the earliest CCD step pair at which any component of this hitbox overlaps any component of the other.
+		 *
+		 * Object components at every backtrace step are laid out in a @link Geom::RectBoxBatch @endlink,
+		 * so each subject step is tested against all of them with one batched SAT query.
+		 * Steps are visited subject-major, object-minor, matching the order collisions are resolved.
+		 */
 		template <CollisionCollector Col = CollisionNoCollect>
 		bool collideWithExact(
 			const Hitbox& other,
 			Col collector = {},
 			const bool soundful = false
 		) const noexcept{
-			Geom::OrthoRectFloat bound_subject = this->selfBound;
-			Geom::OrthoRectFloat bound_object = other.selfBound;
-
-			const auto trans_subject = -this->backtraceUnitMove;
-			const auto trans_object = -other.backtraceUnitMove;
-
-			const bool sbjHasTrans = backtraceUnitMove.isZero();
-			const bool objHasTrans = other.backtraceUnitMove.isZero();
-
-
-			std::vector<Geom::RectBoxBrief> tempHitboxes{};
-			HitboxSpan rangeSubject{};
-			HitboxSpan rangeObject{};
-
-			if(sbjHasTrans && objHasTrans){
-				rangeSubject.components = components;
-				rangeObject.components = other.components;
-			}else if(!sbjHasTrans && objHasTrans){
-				tempHitboxes.reserve(components.size());
-				tempHitboxes.append_range(components | std::views::transform(&HitBoxComponent::box));
-
-				rangeSubject.temporary = tempHitboxes;
-				rangeObject.components = other.components;
-			}else if(sbjHasTrans && !objHasTrans){
-				tempHitboxes.reserve(other.components.size());
-				tempHitboxes.append_range(other.components | std::views::transform(&HitBoxComponent::box));
-
-				rangeSubject.components = components;
-				rangeObject.temporary = tempHitboxes;
-			}else{
-				tempHitboxes.reserve(components.size() + other.components.size());
-				tempHitboxes.append_range(components | std::views::transform(&HitBoxComponent::box));
-				tempHitboxes.append_range(other.components | std::views::transform(&HitBoxComponent::box));
-
-				rangeSubject.temporary = std::span{tempHitboxes.begin(), size()};;
-				rangeObject.temporary = std::span{tempHitboxes.begin() + size(), tempHitboxes.end()};;
-			}
-
-
-			//initialize collision state
-			{
-				if(!sbjHasTrans){
-					const auto maxTrans_subject = this->getBackTraceMoveAt(0);
-
-					//Move to initial stage
-					for(auto& box : rangeSubject.temporary){
-						box.move(maxTrans_subject);
-					}
-
-					bound_subject.move(maxTrans_subject);
-				}
-
-				if(!objHasTrans){
-					const auto maxTrans_object = other.getBackTraceMoveAt(0);
-
-					for(auto& box : rangeObject.temporary){
-						box.move(maxTrans_object);
-					}
-
-					bound_object.move(maxTrans_object);
-				}
-			}
-
 			assert(size_CCD > 0);
 			assert(other.size_CCD > 0);
 
-			Index index_object{};
-			Index index_subject{};
-
-			auto sbjMoveFunc = [&]{
-				if(sbjHasTrans)return;
-				for(auto& box : rangeSubject.temporary){
-					box.move(trans_subject);
-				}
-				bound_subject.move(trans_subject);
-			};
-
-			auto objMoveFunc = [&]{
-				if(objHasTrans)return;
-				for(auto& box : rangeObject.temporary){
-					box.move(trans_object);
-				}
-				bound_object.move(trans_object);
-			};
-
-			//OPTM this is horrible...
-
-			for(; index_subject <= getBackTraceIndex(); ++index_subject){
-				const auto curIdx = other.getBackTraceIndex();
-
-				for(; index_object <= curIdx; ++index_object){
-					if(!bound_subject.overlap_Exclusive(bound_object)){
-						goto next0;
-					}
-
-					if(this->loadTo<Col>(
-						collector, soundful, other,
-						rangeSubject, index_subject,
-						rangeObject, index_object
-					)){
-						return true;
-					}
-
-					next0:
-					objMoveFunc();
-				}
-
-				if(!bound_subject.overlap_Exclusive(bound_object)){
-					goto next1;
-				}
-
-				if(this->loadTo<Col>(
-					collector, soundful, other,
-					rangeSubject, index_subject,
-					rangeObject, index_object
-				)){
-					return true;
-				}
-
-				next1:
-				sbjMoveFunc();
+			const Index subjectSteps = this->getBackTraceIndex() + 1;
+			const Index objectSteps = other.getBackTraceIndex() + 1;
+			const Index objectComps = static_cast<Index>(other.components.size());
 
-				if(!objHasTrans){
-					for(auto& box : rangeObject.temporary){
-						box.move(-trans_object * (curIdx + 1));
-					}
+			thread_local Geom::RectBoxBatch objectBatch{};
+			objectBatch.clear();
+			objectBatch.reserve(objectSteps * objectComps);
 
-					bound_object.move(-trans_object * (curIdx + 1));
+			//lane = objectStep * objectComps + component
+			for(Index o = 0; o < objectSteps; ++o){
+				const auto offset = other.getBackTraceMoveAt(o);
+				for(const auto& comp : other.components){
+					objectBatch.push(comp.box, offset);
 				}
 			}
 
-			auto curIdx = other.getBackTraceIndex();
+			const auto objectRange = other.wrapBound_CCD.getMaxOrthoBound();
 
-			for(; index_object <= curIdx; ++index_object){
-				if(!bound_subject.overlap_Exclusive(bound_object)){
-					goto next2;
-				}
+			for(Index s = 0; s < subjectSteps; ++s){
+				const auto offset = this->getBackTraceMoveAt(s);
 
-				if(this->loadTo<Col>(
-					collector, soundful, other,
-					rangeSubject, index_subject,
-					rangeObject, index_object
-				)){
-					return true;
-				}
+				if(!Geom::OrthoRectFloat{selfBound}.move(offset).overlap_Exclusive(objectRange)) continue;
 
-				next2:
-				objMoveFunc();
-			}
+				std::size_t first = objectBatch.size();
+				for(const auto& comp : components){
+					Geom::RectBoxBrief subject = comp.box;
+					subject.move(offset);
 
-			if(!bound_subject.overlap_Exclusive(bound_object)){
-				return false;
-			}
-
-			if(this->loadTo<Col>(
-				collector, soundful, other,
-				rangeSubject, index_subject,
-				rangeObject, index_object
-			)){
-				return true;
-			}
-
-			return false;
-			//
-			// for(; index_subject <= this->getClampedIndexCCD() + 1; ++index_subject){
-			// 	const auto ratio = static_cast<float>(index_subject/* + 1*/) / static_cast<float>(size_CCD);
-			// 	const auto ceilIndex = static_cast<Index>(Math::ceil(ratio * other.size_CCD));
-			//
-			// 	assert(ratio >= 0.f && ratio <= 1.f);
-			//
-			// 	const auto dst = lastCeilIndex - lastBeginIdx2;
-			// 	if(lastCeilIndex != ceilIndex){
-			// 		if(dst == 1){
-			// 			for(auto& box : rangeObject){
-			// 				box.move(trans_object);
-			// 			}
-			// 			bound_object.move(trans_object);
-			// 			++objMove;
-			// 		}
-			//
-			// 		//ceil changed
-			// 		lastBeginIdx2 = lastCeilIndex;
-			// 		lastCeilIndex = ceilIndex;
-			// 	}else{
-			// 		if(dst > 1){
-			// 			for(auto& box : rangeObject){
-			// 				box.move(trans_object * -dst);
-			// 			}
-			// 			bound_object.move(trans_object * -dst);
-			// 			objMove -= dst;
-			// 		}
-			// 	}
-			//
-			// 	for(index_object = lastBeginIdx2; index_object <= ceilIndex; ++index_object){
-			// 		if(this->loadTo<Col>(
-			// 			collector, soundful, other,
-			// 			rangeSubject, index_subject,
-			// 			rangeObject, index_object
-			// 		)){
-			// 			return true;
-			// 		}
-			//
-			// 		next:
-			// 		if(ceilIndex - lastBeginIdx2 > 1){
-			// 			for(auto& box : rangeObject){
-			// 				box.move(trans_object);
-			// 			}
-			// 			bound_object.move(trans_object);
-			// 			++objMove;
-			// 		}
-			// 	}
-			//
-			// 	for(auto& box : rangeSubject){
-			// 		box.move(trans_subject);
-			// 	}
-			// 	bound_subject.move(trans_subject);
-			// 	++sbjMove;
-			// }
-			//
-			// return false;
-		}
-
-	private:
-		template <CollisionCollector Col = CollisionNoCollect>
-		bool loadTo(
-			Col collector, const bool soundful, const Hitbox& other,
-			const HitboxSpan rangeSubject, const Index index_subject,
-			const HitboxSpan rangeObject, const Index index_object
-		) const noexcept{
-			CollisionData* collisionData{};
-			assert(index_subject <= size_CCD);
-			assert(index_object <= other.size_CCD);
-
-			// if(!bound_subject.overlap_Inclusive(bound_object)){
-			// 	goto next;
-			// }
+					first = std::min(first, objectBatch.findFirst(subject));
+					if(first < objectComps) break;
+				}
 
-			auto tryIntersect = [&](
-				const std::span<Geom::RectBoxBrief>::size_type subjectBoxIndex, const Geom::RectBoxBrief& subject,
-				const std::span<Geom::RectBoxBrief>::size_type objectBoxIndex, const Geom::RectBoxBrief& object
-			){
-				if(index_subject > this->getBackTraceIndex() + 1 || index_object > other.getBackTraceIndex() + 1) return false;
+				if(first == objectBatch.size()) continue;
 
-				if(!subject.overlapRough(object) || !subject.overlapExact(object)) return false;
+				const Index o = static_cast<Index>(first / objectComps);
 
 				if constexpr (std::same_as<Col, CollisionNoCollect>){
-					this->clampCCD(index_subject);
-					other.clampCCD(index_object);
-
-					return true;
-				}
-
-				if(!collisionData){
-					this->clampCCD(index_subject);
-					other.clampCCD(index_object);
-					collisionData = std::invoke(collector, index_subject);
-				}
+					this->clampCCD(s);
+					other.clampCCD(o);
 
-				collisionData->indices.push({static_cast<Index>(subjectBoxIndex), static_cast<Index>(objectBoxIndex)});
-				if(!soundful || collisionData->indices.full()){
 					return true;
-				}
-			};
-
-
-			if(backtraceUnitMove.isZero() && other.backtraceUnitMove.isZero()){
-				for(auto&& [subjectBoxIndex, subject] : rangeSubject.components | std::views::transform(&HitBoxComponent::box) | std::views::enumerate){
-					for(auto&& [objectBoxIndex, object] : rangeObject.components | std::views::transform(&HitBoxComponent::box) | std::views::enumerate){
-						if(tryIntersect(subjectBoxIndex, subject, objectBoxIndex, object)){
-							return true;
+				}else{
+					CollisionData* collisionData{};
+
+					for(const auto& [subjectBoxIndex, comp] : components | std::views::enumerate){
+						Geom::RectBoxBrief subject = comp.box;
+						subject.move(offset);
+
+						for(Index k = 0; k < objectComps; ++k){
+							if(!objectBatch.test(subject, o * objectComps + k)) continue;
+
+							if(!collisionData){
+								this->clampCCD(s);
+								other.clampCCD(o);
+								collisionData = std::invoke(collector, s);
+							}
+
+							collisionData->indices.push({static_cast<Index>(subjectBoxIndex), k});
+							if(!soundful || collisionData->indices.full()){
+								return true;
+							}
 						}
 					}
-				}
-			}else if(!backtraceUnitMove.isZero() && other.backtraceUnitMove.isZero()){
-				for(auto&& [subjectBoxIndex, subject] : rangeSubject.temporary | std::views::enumerate){
-					for(auto&& [objectBoxIndex, object] : rangeObject.components | std::views::transform(&HitBoxComponent::box) | std::views::enumerate){
-						if(tryIntersect(subjectBoxIndex, subject, objectBoxIndex, object)){
-							return true;
-						}
-					}
-				}
-			}else if(backtraceUnitMove.isZero() && !other.backtraceUnitMove.isZero()){
-				for(auto&& [subjectBoxIndex, subject] : rangeSubject.components | std::views::transform(&HitBoxComponent::box) | std::views::enumerate){
-					for(auto&& [objectBoxIndex, object] : rangeObject.temporary | std::views::enumerate){
-						if(tryIntersect(subjectBoxIndex, subject, objectBoxIndex, object)){
-							return true;
-						}
-					}
-				}
-			}else{
-				for(auto&& [subjectBoxIndex, subject] : rangeSubject.temporary | std::views::enumerate){
-					for(auto&& [objectBoxIndex, object] : rangeObject.temporary | std::views::enumerate){
-						if(tryIntersect(subjectBoxIndex, subject, objectBoxIndex, object)){
-							return true;
-						}
-					}
-				}
-			}
 
-			assert(soundful || !collisionData);
-			if(collisionData){
-				assert(!collisionData->empty());
-				return true;
+					assert(collisionData && !collisionData->empty());
+					return true;
+				}
 			}
 
 			return false;
@@ -631,14 +400,20 @@ namespace Game{
 		}
 
 		Hitbox(const Hitbox& other)
-			: wrapBound_CCD{other.wrapBound_CCD},
+			: size_CCD{other.size_CCD},
+			  indexClamped_CCD{other.indexClamped_CCD.load(std::memory_order::relaxed)},
+			  backtraceUnitMove{other.backtraceUnitMove},
+			  wrapBound_CCD{other.wrapBound_CCD},
 			  selfBound{other.selfBound},
 			  components{other.components},
 			  trans{other.trans}{
 		}
 
 		Hitbox(Hitbox&& other) noexcept
-			: wrapBound_CCD{std::move(other.wrapBound_CCD)},
+			: size_CCD{other.size_CCD},
+			  indexClamped_CCD{other.indexClamped_CCD.load(std::memory_order::relaxed)},
+			  backtraceUnitMove{other.backtraceUnitMove},
+			  wrapBound_CCD{std::move(other.wrapBound_CCD)},
 			  selfBound{std::move(other.selfBound)},
 			  components{std::move(other.components)},
 			  trans{std::move(other.trans)}{
@@ -646,6 +421,9 @@ namespace Game{
 
 		Hitbox& operator=(const Hitbox& other){
 			if(this == &other) return *this;
+			size_CCD = other.size_CCD;
+			indexClamped_CCD.store(other.indexClamped_CCD.load(std::memory_order::relaxed), std::memory_order::relaxed);
+			backtraceUnitMove = other.backtraceUnitMove;
 			wrapBound_CCD = other.wrapBound_CCD;
 			selfBound = other.selfBound;
 			components = other.components;
@@ -655,6 +433,9 @@ namespace Game{
 
 		Hitbox& operator=(Hitbox&& other) noexcept{
 			if(this == &other) return *this;
+			size_CCD = other.size_CCD;
+			indexClamped_CCD.store(other.indexClamped_CCD.load(std::memory_order::relaxed), std::memory_order::relaxed);
+			backtraceUnitMove = other.backtraceUnitMove;
 			wrapBound_CCD = std::move(other.wrapBound_CCD);
 			selfBound = std::move(other.selfBound);
 			components = std::move(other.components);
@@ -7,6 +7,34 @@ export module Game.Entity.Unit;
 import std;
 
 export namespace Game{
-	using EntityID = std::uintptr_t;
+	/**
+	 * @brief Generational handle of an entity inside its @link EntityGroup @endlink
+	 *
+	 * The slot index is reused after deletion, the generation tells stale handles apart.
+	 */
+	struct EntityID{
+		static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+		std::uint32_t index{InvalidIndex};
+		std::uint32_t generation{};
+
+		[[nodiscard]] constexpr bool valid() const noexcept{
+			return index != InvalidIndex;
+		}
+
+		[[nodiscard]] constexpr explicit operator bool() const noexcept{
+			return valid();
+		}
+
+		constexpr bool operator==(const EntityID&) const noexcept = default;
+	};
+
 	using UpdateTick = float;
 }
+
+export template <>
+struct std::hash<Game::EntityID>{ // NOLINT(*-dcl58-cpp)
+	constexpr std::size_t operator()(const Game::EntityID& id) const noexcept{
+		return std::bit_cast<std::uint64_t>(id) * 0x9E3779B97F4A7C15ull;
+	}
+};
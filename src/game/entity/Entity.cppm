@@ -26,23 +26,36 @@ export namespace Game{
 		// expired,
 	};
 
-	struct Entity : public std::enable_shared_from_this<Entity>{
+	struct Entity{
 	protected:
 		EntityState state{};
 
+	private:
+		/** @brief assigned by the owning group when the entity is activated */
+		EntityID id{};
+
 	public:
 		[[nodiscard]] Entity() noexcept = default;
 
+		Entity(const Entity& other) = default;
+		Entity(Entity&& other) noexcept = default;
+		Entity& operator=(const Entity& other) = default;
+		Entity& operator=(Entity&& other) noexcept = default;
+
 		// void setExpired() noexcept{
 		// 	state = EntityState::expired;
 		// }
 
-		void setActivated() noexcept{
+		/**
+		 * @param id handle assigned by the owning group
+		 */
+		void setActivated(const EntityID id) noexcept{
+			this->id = id;
 			state = EntityState::activated;
 		}
 
 		[[nodiscard]] EntityID getID() const noexcept{
-			return std::bit_cast<EntityID>(this);
+			return id;
 		}
 
 		virtual ~Entity() = default;
@@ -67,15 +80,5 @@ export namespace Game{
 		 */
 		virtual void notifyDelete(WorldState& worldState) noexcept;
 
-		//..i want deucing this
-		template <std::derived_from<Entity> T>
-		std::shared_ptr<T> as(){
-#if DEBUG_CHECK
-			return std::dynamic_pointer_cast<T>(shared_from_this());
-#else
-			return std::static_pointer_cast<T>(shared_from_this());
-#endif
-		}
-
 	};
 }
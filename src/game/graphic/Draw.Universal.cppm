@@ -9,5 +9,5 @@ export namespace Game{
 
 export namespace Game::Graphic::Draw{
 	void hitbox(const Hitbox& hitbox, float z);
-	void realEntity(const RealEntity& entity);
+	void realEntity(const RealEntity& entity, float interpolation = 1.f);
 }
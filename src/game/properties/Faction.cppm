@@ -5,7 +5,6 @@ export module Game.Faction;
 import std;
 
 import Graphic.Color;
-import Graphic.ImageNineRegion;
 
 export namespace Game {
 	class Faction;
@@ -27,7 +26,6 @@ export namespace Game {
 		// std::unordered_set<FactionID> neutral{};
 
 		Graphic::Color color{};
-		Graphic::ImageViewRegion icon{};
 
 		[[nodiscard]] Faction() = default;
 
@@ -0,0 +1,127 @@
+module;
+
+#include <cassert>
+
+export module Game.World.CollisionIsland;
+
+export import Game.World.RealEntity;
+
+import std;
+
+namespace Game{
+	/**
+	 * @brief Partition of the entities that passed @link RealEntity::postProcessCollisions_0 @endlink into independent collision islands.
+	 *
+	 * @link RealEntity::postProcessCollisions_3 @endlink writes the motion of its own entity and reads the motion of every entity in its
+	 * @link RealEntity::Manifold::postData @endlink, so two entities linked by post data must be resolved in their serial order.
+	 * Entities in different islands share no such link, islands can therefore be resolved concurrently,
+	 * each one serially in the original order, giving results identical to the fully serial pass.
+	 *
+	 * Stages 1 and 2 only write the entity itself and read immutable hitbox data of others, they need no partition at all.
+	 */
+	export
+	struct CollisionIslands{
+	private:
+		using Index = unsigned;
+
+		std::vector<Index> parents{};
+		std::vector<Index> offsets{};
+		std::vector<RealEntity*> members{};
+		std::vector<std::span<RealEntity* const>> islandRanges{};
+
+		/** @brief entity slot index to position in the resolution order */
+		std::vector<Index> positions{};
+
+		[[nodiscard]] Index find(Index i) noexcept{
+			while(parents[i] != i){
+				parents[i] = parents[parents[i]];
+				i = parents[i];
+			}
+
+			return i;
+		}
+
+		void unite(const Index a, const Index b) noexcept{
+			const Index ra = find(a);
+			const Index rb = find(b);
+			if(ra == rb) return;
+
+			//keep the smaller index as root, so islands are ordered by their first member
+			if(ra < rb){
+				parents[rb] = ra;
+			}else{
+				parents[ra] = rb;
+			}
+		}
+
+	public:
+		/**
+		 * @brief call after stage 1, when @link RealEntity::Manifold::postData @endlink is settled
+		 * @param entities entities in the serial resolution order
+		 * @param slotCount @link EntityGroup::slotCount @endlink of the group the entities live in
+		 */
+		void build(const std::span<RealEntity* const> entities, const std::size_t slotCount){
+			static constexpr Index Absent = std::numeric_limits<Index>::max();
+
+			const Index count = static_cast<Index>(entities.size());
+
+			parents.resize(count);
+			std::iota(parents.begin(), parents.end(), Index{});
+
+			positions.assign(slotCount, Absent);
+			for(Index i = 0; i < count; ++i){
+				positions[entities[i]->getID().index] = i;
+			}
+
+			for(Index i = 0; i < count; ++i){
+				for(const auto& data : entities[i]->manifold.postData){
+					//entities not being resolved are never written in stage 3, reading them is safe from any island
+					if(const Index other = positions[data.other.index]; other != Absent){
+						unite(i, other);
+					}
+				}
+			}
+
+			//counting sort by root, stable so members keep the serial order
+			offsets.assign(count + 1, 0);
+			for(Index i = 0; i < count; ++i){
+				++offsets[find(i) + 1];
+			}
+
+			std::inclusive_scan(offsets.begin(), offsets.end(), offsets.begin());
+
+			members.resize(count);
+			{
+				std::vector<Index> cursor{offsets.begin(), offsets.end() - 1};
+				for(Index i = 0; i < count; ++i){
+					members[cursor[find(i)]++] = entities[i];
+				}
+			}
+
+			//skip empty buckets of non-root indices
+			islandRanges.clear();
+			for(Index i = 0; i < count; ++i){
+				if(offsets[i] != offsets[i + 1]){
+					islandRanges.emplace_back(members.begin() + offsets[i], members.begin() + offsets[i + 1]);
+				}
+			}
+		}
+
+		/** @brief island count */
+		[[nodiscard]] std::size_t size() const noexcept{
+			return islandRanges.size();
+		}
+
+		[[nodiscard]] std::span<RealEntity* const> operator[](const std::size_t island) const noexcept{
+			assert(island < size());
+			return islandRanges[island];
+		}
+
+		/**
+		 * @brief islands ordered by their first member in the serial order
+		 */
+		[[nodiscard]] const std::vector<std::span<RealEntity* const>>& islands() const noexcept{
+			return islandRanges;
+		}
+	};
+}
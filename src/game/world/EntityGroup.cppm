@@ -6,77 +6,95 @@ export module Game.World.EntityGroup;
 
 export import Game.Entity;
 export import ext.open_hash_map;
+import ext.thread_local_buffer;
+import Core.Global;
+import Core.JobSystem;
 
 import std;
 
 namespace Game{
+	/**
+	 * @brief Slot map of one concrete entity type
+	 *
+	 * Entities are stored by value in a dense array, so iteration streams over contiguous memory.
+	 * A sparse slot array maps @link EntityID @endlink handles to dense indices, deletion swaps the last entity into the hole.
+	 * Dense positions (and so addresses) change on @link dumpMarkedDeletable @endlink, keep handles, not pointers, across ticks.
+	 */
+	export
 	template <typename T>
-	struct vector_multi_thread{
+	struct EntityGroup{
+		using EntityType = T;
+		using Index = std::uint32_t;
+
 	private:
-		mutable std::mutex mutex{};
-		std::vector<T> items{};
+		struct slot{
+			/** @brief @link EntityID::InvalidIndex @endlink if the slot is free */
+			Index dense{EntityID::InvalidIndex};
+			Index generation{};
+		};
+
+		std::vector<T> dense{};
+		std::vector<Index> denseToSlot{};
+		std::vector<slot> slots{};
+		std::vector<Index> freeSlots{};
+
+		/** @brief lock free for producers, drained in the exclusive dump phase */
+		ext::thread_local_buffer<T> pendings{};
+		ext::thread_local_buffer<EntityID> toBeDeleted{};
 
 	public:
-		auto& raw() noexcept{
-			return items;
+		[[nodiscard]] std::size_t size() const noexcept{
+			return dense.size();
 		}
 
-		template <typename Ty>
-		void push(Ty&& item){
-			std::unique_lock lock(mutex);
-			items.push_back(std::forward<Ty>(item));
+		/**
+		 * @brief upper bound of @link EntityID::index @endlink of living entities
+		 */
+		[[nodiscard]] std::size_t slotCount() const noexcept{
+			return slots.size();
 		}
 
-		[[nodiscard]] std::vector<T> dump() noexcept{
-			std::unique_lock lock(mutex);
-			auto rst = std::move(items);
-			return rst;
+		[[nodiscard]] std::span<T> getEntities() noexcept{
+			return dense;
 		}
 
-		void clear() noexcept{
-			std::unique_lock lock(mutex);
-			items.clear();
+		[[nodiscard]] std::span<const T> getEntities() const noexcept{
+			return dense;
 		}
-	};
-
-	// using T = std::string;
-
-	export
-	template <typename T>
-	struct EntityGroup{
-		using EntityType = T;
-		using EntityPtr = std::shared_ptr<T>;
-
-		using MapType = ext::open_hash_map<EntityID, EntityPtr>;
-		MapType entities{EntityID{}, 1024};
 
-	private:
-		vector_multi_thread<EntityPtr> pendings{};
-		vector_multi_thread<EntityPtr> expired{};
-		vector_multi_thread<EntityID> toBeDeleted{};
+		[[nodiscard]] bool contains(const EntityID id) const noexcept{
+			return id.index < slots.size() && slots[id.index].generation == id.generation && slots[id.index].dense != EntityID::InvalidIndex;
+		}
 
-	public:
+		/**
+		 * @return nullptr if the handle is stale
+		 */
+		[[nodiscard]] T* find(const EntityID id) noexcept{
+			return contains(id) ? &dense[slots[id.index].dense] : nullptr;
+		}
 
+		[[nodiscard]] const T* find(const EntityID id) const noexcept{
+			return contains(id) ? &dense[slots[id.index].dense] : nullptr;
+		}
 
-		std::size_t size() const noexcept{
-			return entities.size();
+		[[nodiscard]] T& operator[](const EntityID id) noexcept{
+			assert(contains(id));
+			return dense[slots[id.index].dense];
 		}
 
-		decltype(auto) getEntities() const noexcept{
-			return entities | std::views::values | std::views::transform([](const EntityPtr& ptr) -> EntityType& {
-				return *ptr;
-			});
+		[[nodiscard]] const T& operator[](const EntityID id) const noexcept{
+			assert(contains(id));
+			return dense[slots[id.index].dense];
 		}
 
 		/**
-		 * @brief thread safe
+		 * @brief thread safe and lock free, the entity is inserted on the next @link dumpPendings @endlink
 		 */
-		void pend(EntityPtr&& ptr){
-			pendings.push(std::move(ptr));
+		void pend(T&& entity){
+			pendings.push(std::move(entity));
 		}
 
-		void dumpAll(){
-			clearExpired();
+		void dumpAll() requires (std::derived_from<T, Entity>){
 			dumpMarkedDeletable();
 			dumpPendings();
 		}
@@ -84,11 +102,7 @@ namespace Game{
 		/**
 		 * @brief thread safe
 		 */
-		void pend(const EntityPtr& ptr){
-			pendings.push(ptr);
-		}
-
-		void notifyDelete(EntityID id){
+		void notifyDelete(const EntityID id){
 			toBeDeleted.push(id);
 		}
 
@@ -96,39 +110,42 @@ namespace Game{
 		 * @brief call in an exclusive thread
 		 */
 		void dumpPendings() requires (std::derived_from<T, Entity>){
-			for (auto&& raw : pendings.raw()){
-				Entity& entity = *raw;
-				auto id = entity.getID();
-
-				entity.setActivated();
-				entities.try_emplace(id, std::move(raw));
+			//grown geometrically, reserving the exact count every frame would reallocate on each insertion batch
+			if(const std::size_t needed = dense.size() + pendings.size(); needed > dense.capacity()){
+				dense.reserve(std::max(dense.capacity() * 2, needed));
+				denseToSlot.reserve(dense.capacity());
 			}
-			pendings.clear();
-		}
 
-		void clearExpired() noexcept{
-			if(expired.raw().size() > 128){
-				expired.raw().clear();
-			}
+			pendings.consume([this](T& entity){
+				Index slotIndex;
+				if(freeSlots.empty()){
+					slotIndex = static_cast<Index>(slots.size());
+					slots.emplace_back();
+				}else{
+					slotIndex = freeSlots.back();
+					freeSlots.pop_back();
+				}
+
+				slot& s = slots[slotIndex];
+				s.dense = static_cast<Index>(dense.size());
+
+				T& e = dense.emplace_back(std::move(entity));
+				denseToSlot.push_back(slotIndex);
+
+				e.setActivated(EntityID{slotIndex, s.generation});
+			});
 		}
 
 		/**
 		 * @thread_safety call in an exclusive thread
 		 */
 		void dumpMarkedDeletable() requires (std::derived_from<T, Entity>){
-			for (EntityID id : toBeDeleted.raw()){
-				typename MapType::iterator itr = entities.find(id);
+			toBeDeleted.consume([this](const EntityID id){
+				if(!contains(id)) return;
 
-				assert(itr != entities.end());
-
-				Entity& entity = *itr->second;
-				assert(entity.getState() == EntityState::deletable);
-
-				pendings.raw().push_back(std::move(itr->second));
-				entities.erase(itr);
-			}
-
-			toBeDeleted.clear();
+				assert(dense[slots[id.index].dense].getState() == EntityState::deletable);
+				erase(id);
+			});
 		}
 
 		/**
@@ -136,40 +153,63 @@ namespace Game{
 		 * @thread_safety call in an exclusive thread
 		 */
 		void dumpDeletableBySearch() requires (std::derived_from<T, Entity>){
-			for(typename MapType::iterator cur = entities.begin(); cur != entities.end(); ++cur){
-				Entity& entity = *cur->second;
-				// assert(entity.getState() != EntityState::pending && entity.getState() != EntityState::expired);
-
-				if(entity.getState() == EntityState::deletable){
-					// entity.setExpired();
-					pendings.raw().push_back(std::move(cur->second));
-					entities.erase(cur);
+			for(std::size_t i = 0; i < dense.size();){
+				if(dense[i].getState() == EntityState::deletable){
+					erase(dense[i].getID());
+				}else{
+					++i;
 				}
 			}
-
-
 		}
 
 		template <std::invocable<T&> Fn>
 		void each(Fn fn){
-			for (EntityPtr& entity : entities | std::views::values){
-				std::invoke(fn, *entity);
+			for (T& entity : dense){
+				std::invoke(fn, entity);
 			}
 		}
 
+		/**
+		 * @brief runs on @link Core::Global::jobSystem @endlink, serially if there is none
+		 * @param grain entities per job, 0 lets the job system decide
+		 */
 		template <std::invocable<T&> Fn>
-		void each_par(Fn fn){
-			auto view = entities | std::views::values;
-			std::for_each(std::execution::par, std::ranges::begin(view), std::ranges::end(view), [fn](EntityPtr& entity){
-				std::invoke(fn, *entity);
-			});
+		void each_par(Fn fn, const std::size_t grain = 0){
+			if(!Core::Global::jobSystem){
+				each(fn);
+				return;
+			}
+
+			Core::Global::jobSystem->for_each(dense, fn, grain);
 		}
 
-		void update_par(UpdateTick tick) requires (std::derived_from<T, Entity>){
-			auto view = entities | std::views::values;
-			std::for_each(std::execution::par, std::ranges::begin(view), std::ranges::end(view), [tick](EntityPtr& entity){
-				entity->update(tick);
-			});
+		void update_par(UpdateTick tick, const std::size_t grain = 0) requires (std::derived_from<T, Entity>){
+			this->each_par([tick](T& entity){
+				entity.update(tick);
+			}, grain);
+		}
+
+	private:
+		/**
+		 * @brief O(1), the last entity is moved into the hole
+		 */
+		void erase(const EntityID id){
+			slot& removed = slots[id.index];
+			const Index hole = removed.dense;
+			const Index last = static_cast<Index>(dense.size() - 1);
+
+			if(hole != last){
+				dense[hole] = std::move(dense[last]);
+				denseToSlot[hole] = denseToSlot[last];
+				slots[denseToSlot[hole]].dense = hole;
+			}
+
+			dense.pop_back();
+			denseToSlot.pop_back();
+
+			removed.dense = EntityID::InvalidIndex;
+			++removed.generation;
+			freeSlots.push_back(id.index);
 		}
 	};
-}
\ No newline at end of file
+}
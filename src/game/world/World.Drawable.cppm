@@ -11,7 +11,10 @@ export namespace Game{
 	struct Drawable{
 		virtual ~Drawable() = default;
 
-		virtual void draw() const = 0;
+		/**
+		 * @param interpolation [0, 1], progress from the previous simulated state to the current one
+		 */
+		virtual void draw(float interpolation) const = 0;
 
 		[[nodiscard]] virtual Geom::OrthoRectFloat getClipRegion() const noexcept = 0;
 	};
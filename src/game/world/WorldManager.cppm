@@ -6,7 +6,8 @@ export module Game.World.State;
 
 export import Game.World.EntityGroup;
 export import Game.World.Drawable;
-export import Geom.quad_tree;
+export import Geom.quad_tree.flat;
+export import Geom.sweep_and_prune;
 
 import std;
 import ext.meta_programming;
@@ -38,67 +39,66 @@ namespace Game{
 
 	export
 	struct WorldState{
-		EntityGroup<Entity> all{};
+		/** @brief entities are stored by value, each concrete entity type gets its own group */
 		EntityGroup<RealEntity> realEntities{};
 
-		Geom::quad_tree<RealEntity> quadTree{};
+		Geom::quad_tree_flat<RealEntity> quadTree{};
+		Geom::sweep_and_prune<RealEntity> sweepAndPrune{};
 
 
-		void draw(Geom::OrthoRectFloat viewport) const;
+		/**
+		 * @param interpolation see @link Core::FixedTimestep::getInterpolation @endlink, 1 draws the latest simulated state
+		 */
+		void draw(Geom::OrthoRectFloat viewport, float interpolation = 1.f) const;
 
+		/**
+		 * @brief thread safe, the entity joins the world on the next @link dumpAll @endlink
+		 */
 		template <InvocableEntityInitFunc Fn>
-		auto& add(Fn fn){
+		void add(Fn fn){
 			using EntityType = typename EntityInitFuncTraits<Fn>::EntityType;
-			std::shared_ptr<EntityType> entity{createEntityPtr<EntityType>()};
+			EntityType entity{};
 
-			std::invoke(fn, *entity);
+			std::invoke(fn, entity);
 
-			return this->pendEntityPtr<EntityType>(std::move(entity));
+			this->pendEntity<EntityType>(std::move(entity));
 		}
 
 		template <std::derived_from<Entity> Ty>
-		Ty& add(){
-			std::shared_ptr<Ty> entity{createEntityPtr<Ty>()};
-			return this->pendEntityPtr<Ty>(std::move(entity));
+		void add(){
+			this->pendEntity<Ty>(Ty{});
 		}
 
-		void updateQuadTree();
+		/**
+		 * @brief call in an exclusive thread, entity addresses may change
+		 */
+		void dumpAll();
 
-	private:
-		template <std::derived_from<Entity> Ty>
-		std::shared_ptr<Ty> createEntityPtr(){
-			std::shared_ptr<Ty> entity{};
+		void update_par(UpdateTick tick);
 
-			if constexpr (false){
-
-			}else{
-				entity = std::make_shared<Ty>();
-			}
+		void updateQuadTree();
 
-			return entity;
-		}
+		void updateSweepAndPrune();
 
+	private:
 		template <std::derived_from<Entity> Ty>
-		Ty& pendEntityPtr(std::shared_ptr<Ty>&& entity){
-			Ty& e = entity.operator*();
-
-			if constexpr (std::derived_from<Ty, RealEntity>){
-				realEntities.pend(entity);
-			}
+		void pendEntity(Ty&& entity){
+			static_assert(std::same_as<Ty, RealEntity>, "no entity group stores this type");
 
-			all.pend(std::move(entity));
+			//placed by the init function, the first drawn frame must not interpolate from the origin
+			entity.lastTrans = entity.motion.trans;
 
-			return e;
+			realEntities.pend(std::move(entity));
 		}
 
 		template <typename T>
 			requires std::derived_from<T, Drawable>
-		static void drawGroup(const EntityGroup<T>& entities, const Geom::OrthoRectFloat viewport){
-			for(const std::shared_ptr<T>& entity : entities.entities | std::views::values){
-				if(viewport.overlap_Exclusive(entity->getClipRegion())){
-					entity->draw();
+		static void drawGroup(const EntityGroup<T>& entities, const Geom::OrthoRectFloat viewport, const float interpolation){
+			for(const T& entity : entities.getEntities()){
+				if(viewport.overlap_Exclusive(entity.getClipRegion())){
+					entity.draw(interpolation);
 				}
 			}
 		}
 	};
-};
+}
@@ -0,0 +1,213 @@
+module;
+
+#include "../src/arc/core/profiler.hpp"
+
+export module Game.World.Simulation;
+
+export import Game.World.State;
+export import Game.World.RealEntity;
+import Game.World.CollisionIsland;
+
+import Core.Global;
+import Core.JobSystem;
+import Core.Profiler;
+import ext.shared_stack;
+
+import std;
+
+export namespace Game{
+	enum struct BroadPhase{
+		quadTree,
+		sweepAndPrune,
+	};
+
+	/**
+	 * @brief wall time spent in each stage of the last simulated step
+	 */
+	struct SimulationStageTimes{
+		using Duration = std::chrono::nanoseconds;
+
+		/** @brief @link WorldState::dumpAll @endlink */
+		Duration dump{};
+		/** @brief @link WorldState::update_par @endlink */
+		Duration update{};
+		/** @brief the quad tree or the sorted axis, whichever broad phase is active */
+		Duration structure{};
+		Duration broadPhase{};
+		/** @brief @link RealEntity::postProcessCollisions_0 @endlink */
+		Duration manifold_0{};
+		/** @brief @link RealEntity::postProcessCollisions_1 @endlink and @link RealEntity::postProcessCollisions_2 @endlink */
+		Duration manifold_12{};
+		/** @brief island partition and @link RealEntity::postProcessCollisions_3 @endlink */
+		Duration manifold_3{};
+
+		[[nodiscard]] Duration manifold() const noexcept{
+			return manifold_0 + manifold_12 + manifold_3;
+		}
+	};
+
+	/**
+	 * @brief The rendering independent part of a frame: stepping the world and resolving its collisions.
+	 *
+	 * A step is @link step @endlink followed by @link resolveCollisions @endlink,
+	 * the latter may run on another thread as long as nothing touches the world meanwhile.
+	 */
+	struct WorldSimulation{
+		/** @brief below this many colliding entities the serial path is cheaper than the partition */
+		static constexpr std::size_t ParallelManifoldThreshold = 500;
+
+		WorldState world{};
+
+		/** @brief resolve manifolds by independent islands concurrently, results are identical to the serial path */
+		bool parallelManifold{true};
+
+	private:
+		BroadPhase broadPhase{BroadPhase::quadTree};
+
+		CollisionIslands collisionIslands{};
+		ext::shared_stack<RealEntity*> postCollidePassed{};
+
+		SimulationStageTimes lastStageTimes{};
+
+		/**
+		 * @param stage string literal, also the profiler zone name
+		 */
+		template <typename Fn>
+		static SimulationStageTimes::Duration measure(const char* stage, Fn&& fn){
+			PROFILE_ZONE(stage);
+
+			const auto begin = std::chrono::steady_clock::now();
+			std::invoke(std::forward<Fn>(fn));
+			return std::chrono::duration_cast<SimulationStageTimes::Duration>(std::chrono::steady_clock::now() - begin);
+		}
+
+		[[nodiscard]] static bool broadPhaseFilter(const RealEntity& sbj, const RealEntity& obj){
+			if(&sbj == &obj) return false;
+			if(!sbj.getBound().overlap_Exclusive(obj.getBound())) return false;
+
+			return sbj.roughIntersectWith(obj);
+		}
+
+	public:
+		[[nodiscard]] BroadPhase getBroadPhase() const noexcept{
+			return broadPhase;
+		}
+
+		void setBroadPhase(const BroadPhase broadPhase){
+			if(this->broadPhase == broadPhase) return;
+
+			this->broadPhase = broadPhase;
+
+			//the inactive structure is not updated, it would hold addresses of moved entities
+			world.sweepAndPrune.clear();
+			world.quadTree.clear();
+		}
+
+		[[nodiscard]] const SimulationStageTimes& getLastStageTimes() const noexcept{
+			return lastStageTimes;
+		}
+
+		/**
+		 * @brief join pending entities, advance every entity and rebuild the broad phase structure
+		 */
+		void step(const UpdateTick delta){
+			lastStageTimes.dump = measure("world.dump", [this]{
+				world.dumpAll();
+			});
+
+			lastStageTimes.update = measure("world.update", [this, delta]{
+				world.update_par(delta);
+			});
+
+			//only the structure of the active broad phase is kept, nothing else queries the world through the other one
+			lastStageTimes.structure = measure("world.structure", [this]{
+				if(broadPhase == BroadPhase::quadTree){
+					world.updateQuadTree();
+				}else{
+					world.updateSweepAndPrune();
+				}
+			});
+		}
+
+		/**
+		 * @brief collect the intersections of the current step and resolve them
+		 */
+		void resolveCollisions(const UpdateTick delta){
+			std::atomic_size_t potentialCount{};
+
+			lastStageTimes.broadPhase = measure("world.broadPhase", [this, &potentialCount]{
+				if(broadPhase == BroadPhase::quadTree){
+					world.realEntities.each_par([this, &potentialCount](RealEntity& entity){
+						world.quadTree.intersect_test_all(
+							entity,
+							[&potentialCount](RealEntity& sbj, const RealEntity& obj){
+								if(sbj.testIntersectionWith(obj)){
+									potentialCount.fetch_add(1, std::memory_order::relaxed);
+								}
+							}, broadPhaseFilter);
+					});
+				}else{
+					//one sweep finds each pair once, then each entity fills its own manifold only
+					world.sweepAndPrune.intersect_test_all(
+						[](const std::size_t count, auto fn){
+							if(Core::Global::jobSystem){
+								Core::Global::jobSystem->parallel_for(count, 0, fn);
+							}else{
+								fn(std::size_t{}, count);
+							}
+						},
+						[&potentialCount](RealEntity& sbj, const RealEntity& obj){
+							if(sbj.testIntersectionWith(obj)){
+								potentialCount.fetch_add(1, std::memory_order::relaxed);
+							}
+						}, broadPhaseFilter);
+				}
+			});
+
+			lastStageTimes.manifold_0 = measure("world.manifold_0", [this, &potentialCount]{
+				postCollidePassed.clear_and_reserve(potentialCount.load() + 8);
+
+				world.realEntities.each([this](RealEntity& e){
+					if(e.postProcessCollisions_0()){
+						postCollidePassed.push(&e);
+					}else{
+						e.manifold.clear();
+					}
+				});
+			});
+
+			if(parallelManifold && Core::Global::jobSystem && postCollidePassed.size() > ParallelManifoldThreshold){
+				lastStageTimes.manifold_12 = measure("world.manifold_12", [this]{
+					//stage 1 and 2 only write the entity itself
+					Core::Global::jobSystem->for_each(postCollidePassed, [this](RealEntity* e){
+						e->postProcessCollisions_1(world.realEntities);
+						e->postProcessCollisions_2();
+					});
+				});
+
+				lastStageTimes.manifold_3 = measure("world.manifold_3", [this, delta]{
+					collisionIslands.build({postCollidePassed.begin(), postCollidePassed.end()}, world.realEntities.slotCount());
+
+					Core::Global::jobSystem->for_each(collisionIslands.islands(), [this, delta](const std::span<RealEntity* const> island){
+						for(RealEntity* e : island){
+							e->postProcessCollisions_3(world.realEntities, delta);
+						}
+					});
+				});
+			}else{
+				lastStageTimes.manifold_12 = measure("world.manifold_12", [this]{
+					for(RealEntity* e : postCollidePassed){
+						e->postProcessCollisions_1(world.realEntities);
+						e->postProcessCollisions_2();
+					}
+				});
+
+				lastStageTimes.manifold_3 = measure("world.manifold_3", [this, delta]{
+					for(RealEntity* e : postCollidePassed){
+						e->postProcessCollisions_3(world.realEntities, delta);
+					}
+				});
+			}
+		}
+	};
+}
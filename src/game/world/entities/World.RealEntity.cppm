@@ -11,6 +11,7 @@ export import Game.Entity;
 export import Game.Entity.HitBox;
 export import Game.Entity.Properties.Motion;
 export import Game.World.Drawable;
+export import Game.World.EntityGroup;
 
 export import Game.Faction;
 
@@ -34,7 +35,7 @@ namespace Game{
 
 
 			struct Collision{ // NOLINT(*-pro-type-member-init)
-				const RealEntity* other;
+				EntityID other;
 				CollisionData data;
 			};
 
@@ -46,14 +47,14 @@ namespace Game{
 			};
 
 			struct CollisionPostData{ // NOLINT(*-pro-type-member-init)
-				const RealEntity* other{};
+				EntityID other{};
 				Geom::Vec2 correctionVec{};
 				Intersection mainIntersection{};
 			};
 
 			bool underCorrection{};
 
-			std::vector<const RealEntity*> lastCollided{};
+			std::vector<EntityID> lastCollided{};
 
 			std::vector<Collision> collisions{};
 
@@ -93,7 +94,10 @@ namespace Game{
 
 			}
 
-			void processIntersections(RealEntity& subject) noexcept;
+			/**
+			 * @param entities group the handles of @link collisions @endlink are resolved in
+			 */
+			void processIntersections(RealEntity& subject, const EntityGroup<RealEntity>& entities) noexcept;
 
 			void clear(){
 				std::destroy_at(this);
@@ -103,6 +107,9 @@ namespace Game{
 
 		MechMotionProp motion{};
 		RigidProp rigidProp{};
+
+		/** @brief transform before the last @link update @endlink, the render interpolation source */
+		Geom::Transform lastTrans{};
 	protected:
 		Geom::Transform collisionTestTempVel{};
 		Geom::Vec2 collisionTestTempPos{};
@@ -143,13 +150,13 @@ namespace Game{
 			return rst;
 		}
 
-		void postProcessCollisions_1() noexcept{
-			manifold.processIntersections(*this);
+		void postProcessCollisions_1(const EntityGroup<RealEntity>& entities) noexcept{
+			manifold.processIntersections(*this, entities);
 		}
 
 		void postProcessCollisions_2() noexcept;
 
-		void postProcessCollisions_3(UpdateTick delta) noexcept;
+		void postProcessCollisions_3(const EntityGroup<RealEntity>& entities, UpdateTick delta) noexcept;
 
 		// ---------------------------------------------------------------------
 		// Collision Test Methods END
@@ -166,6 +173,7 @@ namespace Game{
 		}
 
 		void update(UpdateTick deltaTick) override{
+			lastTrans = motion.trans;
 			motion.applyAndReset(deltaTick);
 
 			motion.vel.vec.lerp({}, 0.05f * deltaTick);
@@ -209,7 +217,7 @@ namespace Game{
 		// ReSharper disable once CppHidingFunction
 		bool testIntersectionWith(const RealEntity& object){
 			return hitbox.collideWithExact(object.hitbox, [this, &object](const unsigned index) {
-				return &manifold.collisions.emplace_back(&object, CollisionData{index}).data;
+				return &manifold.collisions.emplace_back(object.getID(), CollisionData{index}).data;
 			}, false);
 			//
 			// if(data && !data->indices.empty()){
@@ -219,7 +227,14 @@ namespace Game{
 		}
 
 	public:
-		void draw() const override;
+		void draw(float interpolation) const override;
+
+		/**
+		 * @brief the transform to render between two simulation steps, collision corrections of the current step included
+		 */
+		[[nodiscard]] Geom::Transform getInterpolatedTrans(const float interpolation) const noexcept{
+			return Geom::lerp(lastTrans, motion.trans, interpolation);
+		}
 
 		[[nodiscard]] Geom::OrthoRectFloat getClipRegion() const noexcept override{
 			return hitbox.getMinWrapBound();
@@ -262,7 +277,7 @@ namespace Game{
 
 			Vec2 correctionVec{};
 
-			bool contains = std::ranges::contains(manifold.lastCollided, &object);
+			bool contains = std::ranges::contains(manifold.lastCollided, object.getID());
 
 			// if(contains && approach.dot(relVel) > 0.f){
 			// 	return;
@@ -0,0 +1,234 @@
+import std;
+
+import Core.File;
+import Graphic.Pixmap;
+import Graphic.AtlasBundle;
+import Graphic.BlockCompression;
+import Math.Algo.StripPacker2D;
+import ext.allocator_2D;
+import Geom.Vector2D;
+import Geom.Rect_Orthogonal;
+
+namespace{
+	using Rect = Geom::Rect_Orthogonal<std::uint32_t>;
+
+	struct Sprite : Math::Packable<std::uint32_t>{
+		std::string name{};
+		Graphic::Pixmap pixmap{};
+		/** @brief the pixmap extent plus the margin while packing */
+		Rect bound{};
+		std::uint32_t page{};
+
+		Rect& getBound(){
+			return bound;
+		}
+	};
+
+	/**
+	 * @brief fills one page after another with the strip packer, each run takes the sprites the previous ones left over
+	 * @return the page count
+	 */
+	std::optional<std::uint32_t> packStrip(std::vector<Sprite>& sprites, const Geom::USize2 pageSize){
+		std::vector<Sprite*> remains{std::from_range, sprites | std::views::transform([](Sprite& sprite){ return &sprite; })};
+		std::uint32_t pages{};
+
+		while(!remains.empty()){
+			Math::StripPacker2D<Sprite> packer{remains};
+			packer.setMaxSize(pageSize);
+			packer.process();
+
+			if(packer.getPacked().empty()) return std::nullopt;
+
+			for(Sprite* sprite : packer.getPacked()){
+				sprite->page = pages;
+			}
+
+			//the remains are a hash set, keep the input order so the output is reproducible
+			std::erase_if(remains, [&](const Sprite* sprite){ return !packer.getRemains().contains(sprite); });
+			++pages;
+		}
+
+		return pages;
+	}
+
+	/**
+	 * @brief places the sprites like the runtime allocation would, tallest first, into the first page with room
+	 */
+	std::optional<std::uint32_t> packTree(std::vector<Sprite>& sprites, const Geom::USize2 pageSize){
+		std::vector<Sprite*> order{std::from_range, sprites | std::views::transform([](Sprite& sprite){ return &sprite; })};
+		std::ranges::stable_sort(order, std::greater{}, [](const Sprite* sprite){ return sprite->bound.getHeight(); });
+
+		std::vector<std::unique_ptr<ext::allocator_2D>> pages{};
+
+		for(Sprite* sprite : order){
+			std::optional<Rect> rect{};
+
+			for(const auto& [i, allocator] : pages | std::views::enumerate){
+				if((rect = allocator->allocate(sprite->bound.getSize()))){
+					sprite->page = static_cast<std::uint32_t>(i);
+					break;
+				}
+			}
+
+			if(!rect){
+				rect = pages.emplace_back(std::make_unique<ext::allocator_2D>(pageSize))->allocate(sprite->bound.getSize());
+				if(!rect) return std::nullopt;
+				sprite->page = static_cast<std::uint32_t>(pages.size() - 1);
+			}
+
+			sprite->bound.setSrc(rect->getSrc());
+		}
+
+		return static_cast<std::uint32_t>(pages.size());
+	}
+}
+
+/**
+ * @brief packs every png under a directory into the pages of one atlas page and writes them as a bundle, see @link Graphic::AtlasBundle @endlink
+ *
+ * atlas_baker <input dir> <output file> [--page name] [--size N] [--margin N] [--packer strip|tree] [--format rgba8|bc7|bc4]
+ *
+ * The regions are named by their path relative to the input directory without the extension, e.g. `ui/back`.
+ * The page is named after the input directory unless given.
+ * A block compressed page places every region on a block boundary so no block is shared by two sprites, bc4 keeps the alpha channel only.
+ */
+int main(const int argc, char* argv[]){
+	if(argc < 3){
+		std::println(std::cerr, "usage: atlas_baker <input dir> <output file> [--page name] [--size N] [--margin N] [--packer strip|tree] [--format rgba8|bc7|bc4]");
+		return 2;
+	}
+
+	const Core::File input{std::string_view{argv[1]}};
+	Core::File output{std::string_view{argv[2]}};
+
+	std::string pageName = input.absolutePath().filename().string();
+	std::uint32_t pageSize{4096};
+	std::uint32_t margin{4};
+	std::string_view packerName{"strip"};
+	std::string_view formatName{"rgba8"};
+
+	const std::span args{argv + 3, argv + argc};
+
+	for(auto arg = args.begin(); arg != args.end(); ++arg){
+		const std::string_view name = *arg;
+
+		const auto value = [&]() -> std::string_view{
+			if(std::next(arg) == args.end()){
+				std::println(std::cerr, "missing value of {}", name);
+				std::exit(2);
+			}
+
+			return *++arg;
+		};
+
+		const auto number = [&]<typename T>(T& dst){
+			const std::string_view str = value();
+			if(const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), dst); ec != std::errc{}){
+				std::println(std::cerr, "invalid value of {}: {}", name, str);
+				std::exit(2);
+			}
+		};
+
+		if(name == "--page"){
+			pageName = value();
+		}else if(name == "--size"){
+			number(pageSize);
+		}else if(name == "--margin"){
+			number(margin);
+		}else if(name == "--packer"){
+			packerName = value();
+		}else if(name == "--format"){
+			formatName = value();
+		}else{
+			std::println(std::cerr, "unknown argument: {}", name);
+			return 2;
+		}
+	}
+
+	Graphic::AtlasBundle::PixelFormat format{};
+
+	if(formatName == "rgba8"){
+		format = Graphic::AtlasBundle::PixelFormat::rgba8;
+	}else if(formatName == "bc7"){
+		format = Graphic::AtlasBundle::PixelFormat::bc7;
+	}else if(formatName == "bc4"){
+		format = Graphic::AtlasBundle::PixelFormat::bc4;
+	}else{
+		std::println(std::cerr, "unknown format: {}", formatName);
+		return 2;
+	}
+
+	const std::uint32_t alignment = Graphic::AtlasBundle::blockFormatOf(format) ? Graphic::BlockExtent : 1;
+	if(pageSize % alignment != 0){
+		std::println(std::cerr, "the page size of a block compressed page must be a multiple of {}", alignment);
+		return 2;
+	}
+
+	const auto alignUp = [alignment](const std::uint32_t value){
+		return (value + alignment - 1) / alignment * alignment;
+	};
+
+	if(!input.isDir()){
+		std::println(std::cerr, "not a directory: {}", input);
+		return 2;
+	}
+
+	std::vector<Core::File> files{};
+	input.allSubs(files);
+	std::erase_if(files, [](const Core::File& file){ return !file.isRegular() || file.extension() != ".png"; });
+	std::ranges::sort(files, {}, [](const Core::File& file){ return file.getPath(); });
+
+	std::vector<Sprite> sprites{};
+	sprites.reserve(files.size());
+
+	for(const auto& file : files){
+		auto& sprite = sprites.emplace_back();
+		sprite.name = std::filesystem::relative(file.getPath(), input.getPath()).replace_extension().generic_string();
+		sprite.pixmap = Graphic::Pixmap{file};
+		sprite.bound = Rect{alignUp(sprite.pixmap.getWidth() + margin), alignUp(sprite.pixmap.getHeight() + margin)};
+
+		if(!sprite.pixmap.valid()){
+			std::println(std::cerr, "failed to load: {}", file);
+			return 1;
+		}
+	}
+
+	const Geom::USize2 extent{pageSize, pageSize};
+	std::optional<std::uint32_t> pageCount{};
+
+	if(packerName == "strip"){
+		pageCount = packStrip(sprites, extent);
+	}else if(packerName == "tree"){
+		pageCount = packTree(sprites, extent);
+	}else{
+		std::println(std::cerr, "unknown packer: {}", packerName);
+		return 2;
+	}
+
+	if(!pageCount){
+		std::println(std::cerr, "a sprite does not fit in a {0}x{0} page", pageSize);
+		return 1;
+	}
+
+	std::vector<Graphic::Pixmap> pages{};
+	pages.reserve(*pageCount);
+	for(std::uint32_t i = 0; i < *pageCount; ++i){
+		pages.emplace_back(pageSize, pageSize);
+	}
+
+	std::vector<Graphic::AtlasBundle::Region> regions{};
+	regions.reserve(sprites.size());
+
+	for(auto& sprite : sprites){
+		const Rect region = sprite.bound.copy().setSize(sprite.pixmap.size2D());
+
+		pages[sprite.page].set(sprite.pixmap, region.getSrcX(), region.getSrcY());
+		regions.push_back({std::move(sprite.name), sprite.page, region});
+	}
+
+	Graphic::AtlasBundle::write(output, pageName, extent, margin, pages, regions, format);
+
+	std::println("{} regions of page '{}' baked into {} {} page(s) of {}x{}: {}", regions.size(), pageName, *pageCount, formatName, pageSize, pageSize, output);
+
+	return 0;
+}